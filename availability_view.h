@@ -0,0 +1,493 @@
+/* ======================================
+   Availability View
+   The hotel's room state published in a POSIX shared-memory segment, so
+   read-only front-desk terminals can show free rooms and the occupancy
+   report without opening a data file or talking to the hotel process. The
+   hotel is the only writer; every change is bracketed by a sequence
+   counter (a seqlock) that is odd while a write is in progress. Readers
+   copy the state and retry if the counter moved, so they never block the
+   hotel and never see half of an update.
+   ====================================== */
+
+#ifndef AVAILABILITY_VIEW_H
+#define AVAILABILITY_VIEW_H
+
+#include <algorithm>         // For std::min
+#include <atomic>            // For the shared counters and the sequence
+#include <cerrno>            // For EPERM
+#include <climits>           // For PATH_MAX
+#include <cstdint>           // For fixed width integers
+#include <cstdio>            // For snprintf
+#include <cstdlib>           // For realpath
+#include <cstring>           // For memcpy and memcmp
+#include <iostream>          // For error messages
+#include <new>               // For placement new
+#include <string>            // For using string class
+#include <thread>            // For yielding while the hotel writes
+#include <vector>            // For the copied bitset
+#include <fcntl.h>           // For O_* constants
+#include <signal.h>          // For kill
+#include <sys/mman.h>        // For shm_open and mmap
+#include <sys/stat.h>        // For fstat
+#include <unistd.h>          // For ftruncate, close and getpid
+#include "journal.h"         // For crc32
+#include "report_counters.h" // For ReportCounters
+#include "room_inventory.h"  // For RoomInventory and RoomType
+
+// Segment layout, each part aligned to 8 bytes:
+//   ViewHeader                       magic, room and floor counts, owner, sequence, report totals
+//   int32_t  numbers[rooms]          room numbers by RoomId (written once, before the segment opens)
+//   uint8_t  types[rooms]            room types by RoomId (written once)
+//   int32_t  roomsOnFloor[floors]    rooms per floor (written once)
+//   uint64_t bookedWords[rooms / 64] booked flag of every room, one bit each (under the seqlock)
+//   int64_t  bookedOnFloor[floors]   booked rooms per floor (under the seqlock)
+// Values are in the owner's byte order; the version changes with the layout.
+
+constexpr char VIEW_MAGIC[8] = {'H', 'B', 'S', 'V', 'I', 'E', 'W', '\0'};
+constexpr uint32_t VIEW_VERSION = 1;
+constexpr uint32_t VIEW_BYTE_ORDER = 0x01020304;
+
+// Shared values must be plain words that any process can update in place
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free &&
+              std::atomic<uint32_t>::is_always_lock_free, "the availability view needs lock-free 64-bit atomics");
+
+/**
+ * @brief Report totals kept in the segment header, by slot.
+ */
+enum ViewTotal : size_t {
+    VIEW_TOTAL_ROOMS,
+    VIEW_BOOKED_ROOMS,
+    VIEW_RESERVATIONS,
+    VIEW_REVENUE, // Bits of the double
+    VIEW_POINTS_ISSUED,
+    VIEW_LOYALTY_BALANCE,
+    VIEW_ROOMS_OF_TYPE,
+    VIEW_BOOKED_OF_TYPE = VIEW_ROOMS_OF_TYPE + ROOM_TYPE_COUNT,
+    VIEW_RESERVATIONS_OF_TYPE = VIEW_BOOKED_OF_TYPE + ROOM_TYPE_COUNT,
+    VIEW_TOTAL_COUNT = VIEW_RESERVATIONS_OF_TYPE + ROOM_TYPE_COUNT
+};
+
+/**
+ * @brief Lifecycle of a segment, in ViewHeader::state.
+ */
+enum ViewState : uint32_t { VIEW_SETTING_UP, VIEW_OPEN, VIEW_CLOSED };
+
+/**
+ * @struct ViewHeader
+ * @brief Start of the segment.
+ */
+struct ViewHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t size;       // Bytes in the whole segment
+    uint64_t roomCount;
+    uint64_t floorCount; // Top floor + 1
+    int64_t ownerPid;
+    std::atomic<uint32_t> state;
+    uint32_t reserved;
+    std::atomic<uint64_t> sequence; // Odd while the owner is writing
+    std::atomic<int64_t> totals[VIEW_TOTAL_COUNT];
+};
+
+/**
+ * @struct ViewLayout
+ * @brief Offsets of the parts of a segment for a room and floor count.
+ */
+struct ViewLayout {
+    size_t numbers, types, roomsOnFloor, bookedWords, bookedOnFloor, size;
+    size_t wordCount;
+
+    ViewLayout(uint64_t roomCount, uint64_t floorCount) {
+        auto align = [](size_t offset) { return (offset + 7) & ~size_t(7); };
+        wordCount = static_cast<size_t>((roomCount + 63) / 64);
+        numbers = align(sizeof(ViewHeader));
+        types = align(numbers + roomCount * sizeof(int32_t));
+        roomsOnFloor = align(types + roomCount);
+        bookedWords = align(roomsOnFloor + floorCount * sizeof(int32_t));
+        bookedOnFloor = bookedWords + wordCount * sizeof(uint64_t);
+        size = bookedOnFloor + floorCount * sizeof(int64_t);
+    }
+};
+
+/**
+ * @brief Segment name for the hotel keeping its files in dataDir.
+ *
+ * Derived from the directory's absolute path, so the hotel and a terminal
+ * started in the same directory meet without configuration.
+ */
+inline std::string availabilityViewName(const std::string& dataDir) {
+    char resolved[PATH_MAX];
+    std::string path = ::realpath(dataDir.empty() ? "." : dataDir.c_str(), resolved) ? resolved : dataDir;
+    char name[32];
+    std::snprintf(name, sizeof(name), "/hotel-view-%08x", crc32(path.data(), path.size()));
+    return name;
+}
+
+/**
+ * @class AvailabilityPublisher
+ * @brief The hotel's side: creates the segment and writes every change into it.
+ *
+ * Only one thread may publish at a time; the hotel already serializes its
+ * mutations. An update touches only the words that changed, so publishing
+ * costs a handful of stores per booking. If the segment cannot be created
+ * the hotel runs without a view.
+ */
+class AvailabilityPublisher {
+    std::string name;
+    char* base = nullptr;
+    size_t length = 0;
+    ViewHeader* header = nullptr;
+    std::atomic<uint64_t>* bookedWords = nullptr;
+    std::atomic<int64_t>* bookedOnFloor = nullptr;
+
+    // Writes between beginWrite and endWrite are seen by readers all together or not at all
+    void beginWrite() {
+        header->sequence.store(header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() {
+        header->sequence.store(header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void setTotal(size_t slot, int64_t value) { header->totals[slot].store(value, std::memory_order_relaxed); }
+
+    void storeTotals(const ReportCounters& counters) {
+        setTotal(VIEW_TOTAL_ROOMS, static_cast<int64_t>(counters.getTotalRooms()));
+        setTotal(VIEW_BOOKED_ROOMS, static_cast<int64_t>(counters.getBookedRooms()));
+        setTotal(VIEW_RESERVATIONS, static_cast<int64_t>(counters.getReservations()));
+        double revenue = counters.getRevenue();
+        int64_t revenueBits;
+        std::memcpy(&revenueBits, &revenue, sizeof(revenueBits));
+        setTotal(VIEW_REVENUE, revenueBits);
+        setTotal(VIEW_POINTS_ISSUED, counters.getPointsIssued());
+        setTotal(VIEW_LOYALTY_BALANCE, counters.getLoyaltyBalance());
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            const RoomType type = static_cast<RoomType>(t);
+            setTotal(VIEW_ROOMS_OF_TYPE + t, static_cast<int64_t>(counters.getRooms(type)));
+            setTotal(VIEW_BOOKED_OF_TYPE + t, static_cast<int64_t>(counters.getBookedRooms(type)));
+            setTotal(VIEW_RESERVATIONS_OF_TYPE + t, static_cast<int64_t>(counters.getReservations(type)));
+        }
+    }
+
+    void storeRoom(RoomId id, const RoomInventory& rooms, const ReportCounters& counters) {
+        std::atomic<uint64_t>& word = bookedWords[static_cast<size_t>(id) / 64];
+        const uint64_t bit = 1ULL << (id % 64);
+        const uint64_t bits = word.load(std::memory_order_relaxed);
+        word.store(rooms.isBooked(id) ? bits | bit : bits & ~bit, std::memory_order_relaxed);
+        const int floor = rooms.getFloor(id);
+        bookedOnFloor[static_cast<size_t>(floor)].store(counters.getBookedOnFloor(floor), std::memory_order_relaxed);
+    }
+
+public:
+    AvailabilityPublisher() = default;
+    ~AvailabilityPublisher() { close(); }
+    AvailabilityPublisher(const AvailabilityPublisher&) = delete;
+    AvailabilityPublisher& operator=(const AvailabilityPublisher&) = delete;
+
+    /**
+     * @brief Create the segment under a name, replacing any left by an earlier run, and publish the whole state.
+     * @return False, after a warning, if shared memory is unavailable.
+     */
+    bool open(const std::string& segmentName, const RoomInventory& rooms, const ReportCounters& counters) {
+        close();
+        const uint64_t roomCount = rooms.size();
+        const uint64_t floorCount = static_cast<uint64_t>(rooms.getTopFloor()) + 1;
+        const ViewLayout layout(roomCount, floorCount);
+        // Terminals still attached to an old segment keep it until they detach; new ones find this one
+        ::shm_unlink(segmentName.c_str());
+        int fd = ::shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            std::cerr << "Warning: cannot create the availability view " << segmentName << "; front-desk terminals will not see this hotel.\n";
+            return false;
+        }
+        void* mapped = MAP_FAILED;
+        if (::ftruncate(fd, static_cast<off_t>(layout.size)) == 0) {
+            mapped = ::mmap(nullptr, layout.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            ::shm_unlink(segmentName.c_str());
+            std::cerr << "Warning: cannot map the availability view " << segmentName << "; front-desk terminals will not see this hotel.\n";
+            return false;
+        }
+        name = segmentName;
+        base = static_cast<char*>(mapped);
+        length = layout.size;
+
+        // The new segment is zero-filled; the atomics are constructed over it before anyone reads them
+        header = new (base) ViewHeader();
+        header->version = VIEW_VERSION;
+        header->byteOrder = VIEW_BYTE_ORDER;
+        header->size = layout.size;
+        header->roomCount = roomCount;
+        header->floorCount = floorCount;
+        header->ownerPid = ::getpid();
+        int32_t* numbers = reinterpret_cast<int32_t*>(base + layout.numbers);
+        uint8_t* types = reinterpret_cast<uint8_t*>(base + layout.types);
+        int32_t* roomsOnFloor = reinterpret_cast<int32_t*>(base + layout.roomsOnFloor);
+        for (RoomId id = 0; id < static_cast<RoomId>(roomCount); ++id) {
+            numbers[id] = rooms.getNumber(id);
+            types[id] = static_cast<uint8_t>(rooms.getType(id));
+        }
+        for (uint64_t floor = 0; floor < floorCount; ++floor) {
+            roomsOnFloor[floor] = counters.getRoomsOnFloor(static_cast<int>(floor));
+        }
+        bookedWords = reinterpret_cast<std::atomic<uint64_t>*>(base + layout.bookedWords);
+        bookedOnFloor = reinterpret_cast<std::atomic<int64_t>*>(base + layout.bookedOnFloor);
+        for (size_t w = 0; w < layout.wordCount; ++w) new (&bookedWords[w]) std::atomic<uint64_t>(0);
+        for (uint64_t floor = 0; floor < floorCount; ++floor) new (&bookedOnFloor[floor]) std::atomic<int64_t>(0);
+        publish(rooms, counters);
+
+        std::memcpy(header->magic, VIEW_MAGIC, sizeof(VIEW_MAGIC));
+        header->state.store(VIEW_OPEN, std::memory_order_release);
+        return true;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+
+    /**
+     * @brief Rewrite every room and total, e.g. after the state was loaded.
+     */
+    void publish(const RoomInventory& rooms, const ReportCounters& counters) {
+        if (!header) return;
+        beginWrite();
+        for (size_t w = 0; w < (header->roomCount + 63) / 64; ++w) {
+            uint64_t bits = 0;
+            const size_t first = w * 64, last = std::min<size_t>(first + 64, header->roomCount);
+            for (size_t id = first; id < last; ++id) {
+                bits |= uint64_t(rooms.isBooked(static_cast<RoomId>(id))) << (id - first);
+            }
+            bookedWords[w].store(bits, std::memory_order_relaxed);
+        }
+        for (uint64_t floor = 0; floor < header->floorCount; ++floor) {
+            bookedOnFloor[floor].store(counters.getBookedOnFloor(static_cast<int>(floor)), std::memory_order_relaxed);
+        }
+        storeTotals(counters);
+        endWrite();
+    }
+
+    /**
+     * @brief Publish a room whose booked state or reservations changed, with the totals.
+     */
+    void publishRoom(RoomId id, const RoomInventory& rooms, const ReportCounters& counters) {
+        if (!header || static_cast<uint64_t>(id) >= header->roomCount) return;
+        beginWrite();
+        storeRoom(id, rooms, counters);
+        storeTotals(counters);
+        endWrite();
+    }
+
+    /**
+     * @brief Publish a change to the totals alone, such as the loyalty balance.
+     */
+    void publishTotals(const ReportCounters& counters) {
+        if (!header) return;
+        beginWrite();
+        storeTotals(counters);
+        endWrite();
+    }
+
+    /**
+     * @brief Mark the view closed and remove its name; attached terminals keep the last state.
+     */
+    void close() {
+        if (!header) return;
+        header->state.store(VIEW_CLOSED, std::memory_order_release);
+        ::munmap(base, length);
+        ::shm_unlink(name.c_str());
+        base = nullptr;
+        length = 0;
+        header = nullptr;
+        bookedWords = nullptr;
+        bookedOnFloor = nullptr;
+    }
+};
+
+/**
+ * @class AvailabilitySnapshot
+ * @brief One consistent copy of a published view.
+ *
+ * Offers the reads of RoomInventory and ReportCounters that the room
+ * listing and the reports use, so the same printers serve the hotel and a
+ * terminal. Room numbers and types point into the view's mapping and are
+ * valid while the view stays attached.
+ */
+class AvailabilitySnapshot {
+    friend class AvailabilityView;
+
+    const int32_t* numbers = nullptr;
+    const uint8_t* types = nullptr;
+    const int32_t* roomsOnFloor = nullptr;
+    size_t roomCount = 0;
+    int64_t totals[VIEW_TOTAL_COUNT] = {};
+    std::vector<uint64_t> bookedWords;
+    std::vector<int64_t> bookedOnFloor;
+
+    size_t total(size_t slot) const { return static_cast<size_t>(totals[slot]); }
+
+public:
+    // Room table
+    size_t size() const { return roomCount; }
+    int getNumber(RoomId id) const { return numbers[static_cast<size_t>(id)]; }
+    RoomType getType(RoomId id) const { return static_cast<RoomType>(types[static_cast<size_t>(id)]); }
+    int getFloor(RoomId id) const { return getNumber(id) / RoomInventory::FLOOR_STRIDE; }
+    bool isBooked(RoomId id) const { return (bookedWords[static_cast<size_t>(id) / 64] >> (id % 64)) & 1; }
+
+    /**
+     * @brief Visit every unbooked room in room-number order.
+     */
+    template<typename Visit>
+    void forEachFree(Visit visit) const {
+        for (size_t w = 0; w < bookedWords.size(); ++w) {
+            uint64_t free = ~bookedWords[w];
+            if (w + 1 == bookedWords.size() && roomCount % 64) free &= (1ULL << (roomCount % 64)) - 1;
+            while (free) {
+                visit(static_cast<RoomId>(w * 64 + static_cast<size_t>(__builtin_ctzll(free))));
+                free &= free - 1;
+            }
+        }
+    }
+
+    size_t getFreeCount(RoomType type) const {
+        size_t count = 0;
+        forEachFree([this, type, &count](RoomId id) { count += getType(id) == type; });
+        return count;
+    }
+
+    // Report totals
+    size_t getTotalRooms() const { return total(VIEW_TOTAL_ROOMS); }
+    size_t getBookedRooms() const { return total(VIEW_BOOKED_ROOMS); }
+    size_t getFreeRooms() const { return getTotalRooms() - getBookedRooms(); }
+    size_t getReservations() const { return total(VIEW_RESERVATIONS); }
+    double getRevenue() const {
+        double revenue;
+        std::memcpy(&revenue, &totals[VIEW_REVENUE], sizeof(revenue));
+        return revenue;
+    }
+    int64_t getPointsIssued() const { return totals[VIEW_POINTS_ISSUED]; }
+    int64_t getLoyaltyBalance() const { return totals[VIEW_LOYALTY_BALANCE]; }
+
+    size_t getRooms(RoomType type) const { return total(VIEW_ROOMS_OF_TYPE + static_cast<size_t>(type)); }
+    size_t getBookedRooms(RoomType type) const { return total(VIEW_BOOKED_OF_TYPE + static_cast<size_t>(type)); }
+    size_t getFreeRooms(RoomType type) const { return getRooms(type) - getBookedRooms(type); }
+    size_t getReservations(RoomType type) const { return total(VIEW_RESERVATIONS_OF_TYPE + static_cast<size_t>(type)); }
+
+    int getTopFloor() const { return static_cast<int>(bookedOnFloor.size()) - 1; }
+    int getRoomsOnFloor(int floor) const { return roomsOnFloor[static_cast<size_t>(floor)]; }
+    int getBookedOnFloor(int floor) const { return static_cast<int>(bookedOnFloor[static_cast<size_t>(floor)]); }
+};
+
+/**
+ * @class AvailabilityView
+ * @brief A terminal's side: a read-only mapping of a published segment.
+ */
+class AvailabilityView {
+    const char* base = nullptr;
+    size_t length = 0;
+    const ViewHeader* header = nullptr;
+    const int32_t* numbers = nullptr;
+    const uint8_t* types = nullptr;
+    const int32_t* roomsOnFloor = nullptr;
+    const std::atomic<uint64_t>* bookedWords = nullptr;
+    const std::atomic<int64_t>* bookedOnFloor = nullptr;
+
+public:
+    AvailabilityView() = default;
+    ~AvailabilityView() { detach(); }
+    AvailabilityView(const AvailabilityView&) = delete;
+    AvailabilityView& operator=(const AvailabilityView&) = delete;
+
+    /**
+     * @brief Map the segment published under a name.
+     * @return False if no hotel publishes it, it is still being set up, or it has another layout.
+     */
+    bool attach(const std::string& segmentName) {
+        detach();
+        int fd = ::shm_open(segmentName.c_str(), O_RDONLY | O_CLOEXEC, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        void* mapped = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ViewHeader)) {
+            mapped = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+        base = static_cast<const char*>(mapped);
+        length = static_cast<size_t>(st.st_size);
+        header = reinterpret_cast<const ViewHeader*>(base);
+
+        if (header->state.load(std::memory_order_acquire) == VIEW_SETTING_UP ||
+            std::memcmp(header->magic, VIEW_MAGIC, sizeof(VIEW_MAGIC)) != 0 || header->version != VIEW_VERSION ||
+            header->byteOrder != VIEW_BYTE_ORDER || header->size != length) {
+            detach();
+            return false;
+        }
+        const ViewLayout layout(header->roomCount, header->floorCount);
+        if (layout.size != length) {
+            detach();
+            return false;
+        }
+        numbers = reinterpret_cast<const int32_t*>(base + layout.numbers);
+        types = reinterpret_cast<const uint8_t*>(base + layout.types);
+        roomsOnFloor = reinterpret_cast<const int32_t*>(base + layout.roomsOnFloor);
+        bookedWords = reinterpret_cast<const std::atomic<uint64_t>*>(base + layout.bookedWords);
+        bookedOnFloor = reinterpret_cast<const std::atomic<int64_t>*>(base + layout.bookedOnFloor);
+        return true;
+    }
+
+    void detach() {
+        if (base) ::munmap(const_cast<char*>(base), length);
+        base = nullptr;
+        length = 0;
+        header = nullptr;
+    }
+
+    bool isAttached() const { return header != nullptr; }
+
+    /**
+     * @brief True while the hotel that published the view is still running and has not closed it.
+     */
+    bool ownerRunning() const {
+        if (!header || header->state.load(std::memory_order_acquire) != VIEW_OPEN) return false;
+        return ::kill(static_cast<pid_t>(header->ownerPid), 0) == 0 || errno == EPERM;
+    }
+
+    /**
+     * @brief Copy the current state, retrying while the hotel is midway through an update.
+     * @return False if the hotel stopped in the middle of an update, leaving no consistent state to read.
+     */
+    bool read(AvailabilitySnapshot& snapshot) const {
+        const size_t wordCount = static_cast<size_t>((header->roomCount + 63) / 64);
+        const size_t floorCount = static_cast<size_t>(header->floorCount);
+        snapshot.numbers = numbers;
+        snapshot.types = types;
+        snapshot.roomsOnFloor = roomsOnFloor;
+        snapshot.roomCount = static_cast<size_t>(header->roomCount);
+        snapshot.bookedWords.resize(wordCount);
+        snapshot.bookedOnFloor.resize(floorCount);
+        for (size_t attempt = 1;; ++attempt) {
+            const uint64_t before = header->sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                if (attempt % 1024 == 0 && !ownerRunning()) return false;
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t slot = 0; slot < VIEW_TOTAL_COUNT; ++slot) {
+                snapshot.totals[slot] = header->totals[slot].load(std::memory_order_relaxed);
+            }
+            for (size_t w = 0; w < wordCount; ++w) {
+                snapshot.bookedWords[w] = bookedWords[w].load(std::memory_order_relaxed);
+            }
+            for (size_t floor = 0; floor < floorCount; ++floor) {
+                snapshot.bookedOnFloor[floor] = bookedOnFloor[floor].load(std::memory_order_relaxed);
+            }
+            // The copies above must complete before the sequence is checked again
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header->sequence.load(std::memory_order_relaxed) == before) return true;
+        }
+    }
+};
+
+#endif // AVAILABILITY_VIEW_H
@@ -0,0 +1,613 @@
+/* ======================================
+   Hotel Benchmark
+   Generates a deterministic property of a given size (floors x rooms,
+   customers and existing bookings), then times every Hotel operation and
+   persistence routine against it. Sizes run from 1k to 1M rooms by
+   default. One JSON object per measurement is written to the output file
+   so runs can be compared line by line.
+   ====================================== */
+
+#define HOTEL_NO_MAIN
+#include "main.cpp"      // The Hotel under test
+
+#include <cstdio>        // For FILE output
+#include <random>        // For the data generator
+#include <cstdlib>       // For mkdtemp
+#include <unistd.h>      // For chdir, getcwd
+
+using Clock = chrono::steady_clock;
+
+/**
+ * @class HotelBench
+ * @brief Access to the Hotel routines the benchmark times but the program keeps private.
+ */
+class HotelBench {
+public:
+    static void checkpoint(Hotel& hotel) { hotel.checkpoint(); }
+    static void saveCustomers(Hotel& hotel) { hotel.saveCustomersToFile(); }
+    static void saveRooms(Hotel& hotel) { hotel.saveRoomsToFile(); }
+    static void saveBookings(Hotel& hotel) { hotel.saveBookingsToFile(); }
+    static void saveSnapshot(Hotel& hotel) { hotel.saveSnapshot(); }
+    static void occupancyReport(const Hotel& hotel) { hotel.generateOccupancyReport(); }
+    static void popularRoomTypesReport(const Hotel& hotel) { hotel.generatePopularRoomTypesReport(); }
+};
+
+/**
+ * @struct BenchConfig
+ * @brief Command-line settings of a benchmark run.
+ */
+struct BenchConfig {
+    vector<size_t> sizes{1000, 10000, 100000, 1000000}; // Rooms per run
+    int roomsPerFloor = 50;
+    double customersPerRoom = 1.0;
+    double density = 0.5; // Share of rooms holding one booking when the hotel loads
+    size_t ops = 10000;   // Iterations of each point operation
+    uint32_t seed = 42;
+    string outPath = "bench_results.jsonl";
+    string dir;           // Scratch directory; a temporary one is used if empty
+    vector<size_t> chainProperties{1, 2, 4, 8}; // Chain sizes for the fan-out search, each property of the first size
+    vector<size_t> forecastThreads{1, 2, 4, 8}; // Thread counts for the occupancy forecast of the first size
+    size_t forecastRuns = 10000;
+    size_t historyRows = 10000000; // Archived stays scanned by the stay-history queries
+};
+
+/**
+ * @class PropertyGenerator
+ * @brief Writes rooms.txt, customers.txt and bookings.txt for a synthetic hotel.
+ *
+ * The same seed and size always give the same files, except that booking
+ * dates are placed relative to today so they fall inside the booking horizon.
+ */
+class PropertyGenerator {
+    mt19937 rng;
+
+    static void writeFile(const string& path, const string& data) {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file || fwrite(data.data(), 1, data.size(), file) != data.size() || fclose(file) != 0) {
+            throw BookingException("Error writing " + path + ".");
+        }
+    }
+
+public:
+    size_t roomCount = 0, customerCount = 0, bookingCount = 0;
+
+    explicit PropertyGenerator(uint32_t seed) : rng(seed) {}
+
+    static string username(size_t i) { return "guest" + to_string(i); }
+    static string password(size_t i) { return "pw" + to_string(i); }
+    static string email(size_t i) { return "guest" + to_string(i) + "@example.com"; }
+    static string phone(size_t i) {
+        char digits[16];
+        snprintf(digits, sizeof(digits), "9%09zu", i % 1000000000);
+        return digits;
+    }
+
+    // Room number of the i-th generated room
+    static int roomNumber(size_t i, int roomsPerFloor) {
+        int floor = static_cast<int>(i / roomsPerFloor) + 1;
+        int slot = static_cast<int>(i % roomsPerFloor) + 1;
+        return floor * RoomInventory::FLOOR_STRIDE + slot;
+    }
+
+    void generate(size_t rooms, int roomsPerFloor, size_t customers, double density) {
+        roomCount = rooms;
+        customerCount = customers;
+        bookingCount = 0;
+        string data;
+
+        for (size_t i = 0; i < rooms; ++i) {
+            data += to_string(roomNumber(i, roomsPerFloor));
+            data += ",0,";
+            data += ROOM_TYPE_NAMES[rng() % ROOM_TYPE_COUNT];
+            data += '\n';
+        }
+        writeFile("rooms.txt", data);
+
+        data.clear();
+        for (size_t i = 0; i < customers; ++i) {
+            char line[160];
+            snprintf(line, sizeof(line), "%s,Guest %zu,guest%zu@example.com,9%09zu,%012zu,%s,%u\n",
+                     username(i).c_str(), i, i, i % 1000000000, i, password(i).c_str(),
+                     static_cast<unsigned>(rng() % 1500));
+            data += line;
+        }
+        writeFile("customers.txt", data);
+
+        data.clear();
+        const int today = todayDayNumber();
+        uniform_real_distribution<double> chance(0.0, 1.0);
+        for (size_t i = 0; i < rooms && customers > 0; ++i) {
+            if (chance(rng) >= density) continue;
+            int checkIn = today + static_cast<int>(rng() % 300);
+            int checkOut = checkIn + 1 + static_cast<int>(rng() % 7);
+            data += to_string(roomNumber(i, roomsPerFloor)) + "," + username(rng() % customers) + "," +
+                    formatDate(checkIn) + "," + formatDate(checkOut) + "\n";
+            ++bookingCount;
+        }
+        writeFile("bookings.txt", data);
+    }
+};
+
+/**
+ * @class NullBuffer
+ * @brief Stream buffer that discards everything, for timing the printing views.
+ */
+class NullBuffer : public streambuf {
+    char scratch[4096];
+
+protected:
+    int overflow(int c) override {
+        setp(scratch, scratch + sizeof(scratch));
+        return c == EOF ? 0 : c;
+    }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+/**
+ * @class BenchRecorder
+ * @brief Writes one JSON line per measurement and a readable table to stdout.
+ */
+class BenchRecorder {
+    FILE* out;
+    size_t size = 0, customers = 0, bookings = 0;
+    double density = 0;
+
+public:
+    explicit BenchRecorder(const string& path) : out(fopen(path.c_str(), "w")) {
+        if (!out) throw BookingException("Error opening " + path + " for writing.");
+        printf("%-10s %-24s %10s %9s %14s %14s\n", "rooms", "operation", "iterations", "failures", "total ms", "ns/op");
+    }
+    ~BenchRecorder() { fclose(out); }
+    BenchRecorder(const BenchRecorder&) = delete;
+    BenchRecorder& operator=(const BenchRecorder&) = delete;
+
+    void setProperty(size_t rooms, size_t customerCount, size_t bookingCount, double bookingDensity) {
+        size = rooms;
+        customers = customerCount;
+        bookings = bookingCount;
+        density = bookingDensity;
+    }
+
+    void record(const char* op, size_t iterations, size_t failures, double seconds) {
+        double nsPerOp = iterations ? seconds * 1e9 / iterations : 0.0;
+        fprintf(out, "{\"rooms\":%zu,\"customers\":%zu,\"bookings\":%zu,\"density\":%.3f,\"op\":\"%s\","
+                     "\"iterations\":%zu,\"failures\":%zu,\"total_ms\":%.3f,\"ns_per_op\":%.1f}\n",
+                size, customers, bookings, density, op, iterations, failures, seconds * 1e3, nsPerOp);
+        fflush(out);
+        printf("%-10zu %-24s %10zu %9zu %14.3f %14.1f\n", size, op, iterations, failures, seconds * 1e3, nsPerOp);
+        fflush(stdout);
+    }
+};
+
+template<typename Body>
+double timeSeconds(Body body) {
+    auto start = Clock::now();
+    body();
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Run body(i) for i in [0, iterations) and record it; body returns false for a failed attempt
+template<typename Body>
+void measure(BenchRecorder& recorder, const char* op, size_t iterations, Body body) {
+    size_t failures = 0;
+    double seconds = timeSeconds([&] {
+        for (size_t i = 0; i < iterations; ++i) {
+            if (!body(i)) ++failures;
+        }
+    });
+    recorder.record(op, iterations, failures, seconds);
+}
+
+void removeDataFiles(const string& dir = "") {
+    for (const char* file : {"customers.txt", "rooms.txt", "bookings.txt", "journal.log", "hotel.snap", "loyalty_ledger.txt",
+                             "waitlist.txt"}) {
+        remove((dir + file).c_str());
+    }
+    for (const char* column : StayArchive::COLUMN_FILES) {
+        remove((dir + "history/" + column).c_str());
+    }
+    rmdir((dir + "history").c_str());
+}
+
+void benchSize(const BenchConfig& config, size_t size, BenchRecorder& recorder) {
+    PropertyGenerator generator(config.seed ^ static_cast<uint32_t>(size));
+    const size_t customers = max<size_t>(1, static_cast<size_t>(size * config.customersPerRoom));
+    removeDataFiles();
+    double seconds = timeSeconds([&] { generator.generate(size, config.roomsPerFloor, customers, config.density); });
+    recorder.setProperty(size, customers, generator.bookingCount, config.density);
+    recorder.record("generate_files", 1, 0, seconds);
+
+    unique_ptr<Hotel> hotel;
+    recorder.record("load_text", 1, 0, timeSeconds([&] { hotel = make_unique<Hotel>(); }));
+    recorder.record("save_customers", 1, 0, timeSeconds([&] { HotelBench::saveCustomers(*hotel); }));
+    recorder.record("save_rooms", 1, 0, timeSeconds([&] { HotelBench::saveRooms(*hotel); }));
+    recorder.record("save_bookings", 1, 0, timeSeconds([&] { HotelBench::saveBookings(*hotel); }));
+    recorder.record("save_snapshot", 1, 0, timeSeconds([&] { HotelBench::saveSnapshot(*hotel); }));
+    recorder.record("checkpoint", 1, 0, timeSeconds([&] { HotelBench::checkpoint(*hotel); }));
+    hotel.reset();
+    recorder.record("load_snapshot", 1, 0, timeSeconds([&] { hotel = make_unique<Hotel>(); }));
+
+    // Point operations run as one batch, so they are timed without a journal sync each
+    mt19937 rng(config.seed + 1);
+    const int firstNight = hotel->getFirstBookableNight();
+    auto randomStay = [&](int& checkIn, int& checkOut) {
+        checkIn = firstNight + static_cast<int>(rng() % 300);
+        checkOut = checkIn + 1 + static_cast<int>(rng() % 7);
+    };
+    struct Made {
+        size_t customer;
+        int room;
+        int checkIn;
+    };
+    vector<Made> made;
+    made.reserve(config.ops);
+    hotel->beginBatch();
+
+    measure(recorder, "book_room", config.ops, [&](size_t) {
+        size_t customer = rng() % customers;
+        int room = PropertyGenerator::roomNumber(rng() % size, config.roomsPerFloor);
+        int checkIn, checkOut;
+        randomStay(checkIn, checkOut);
+        try {
+            hotel->bookRoom(PropertyGenerator::username(customer), room, checkIn, checkOut);
+            made.push_back({customer, room, checkIn});
+            return true;
+        }
+        catch (const BookingException&) {
+            return false;
+        }
+    });
+    // Requests for rooms taken above: each either books a free room or waits, and the
+    // cancellations below hand their rooms to whoever is waiting
+    measure(recorder, "join_waitlist", made.size(), [&](size_t i) {
+        RoomType type = RoomType::STANDARD;
+        parseRoomType(hotel->getRoomTypeName(made[i].room), type);
+        uint64_t ticket;
+        try {
+            hotel->joinWaitlist(PropertyGenerator::username(rng() % customers), type,
+                                made[i].room / RoomInventory::FLOOR_STRIDE, made[i].checkIn, made[i].checkIn + 1,
+                                ticket);
+            return true;
+        }
+        catch (const BookingException&) {
+            return false;
+        }
+    });
+    measure(recorder, "cancel_booking", made.size(), [&](size_t i) {
+        try {
+            hotel->cancelBooking(PropertyGenerator::username(made[i].customer), made[i].room, made[i].checkIn);
+            return true;
+        }
+        catch (const BookingException&) {
+            return false;
+        }
+    });
+    // Tour-operator sized groups; a failure means fewer than 40 rooms of the type were free for those nights
+    measure(recorder, "book_room_group", max<size_t>(1, config.ops / 40), [&](size_t) {
+        int checkIn, checkOut;
+        randomStay(checkIn, checkOut);
+        try {
+            hotel->bookRoomGroup(PropertyGenerator::username(rng() % customers),
+                                 static_cast<RoomType>(rng() % ROOM_TYPE_COUNT), 40, checkIn, checkOut,
+                                 GroupPlacement::ANY);
+            return true;
+        }
+        catch (const BookingException&) {
+            return false;
+        }
+    });
+    recorder.record("journal_commit", 1, 0, timeSeconds([&] { hotel->commitBatch(); }));
+
+    measure(recorder, "find_free_room", config.ops, [&](size_t) {
+        int checkIn, checkOut;
+        randomStay(checkIn, checkOut);
+        return hotel->findFreeRoom(static_cast<RoomType>(rng() % ROOM_TYPE_COUNT), checkIn, checkOut) > 0;
+    });
+    // Bulk quoting: 100k random stays priced in one call
+    vector<StayQuery> stays(100000);
+    for (StayQuery& stay : stays) {
+        randomStay(stay.checkIn, stay.checkOut);
+        stay.type = static_cast<RoomType>(rng() % ROOM_TYPE_COUNT);
+        stay.tier = static_cast<LoyaltyTier>(rng() % 4);
+    }
+    vector<int64_t> prices;
+    recorder.record("quote_stays_100k", 1, 0, timeSeconds([&] { prices = hotel->quoteStays(stays); }));
+    measure(recorder, "quote_stay", config.ops, [&](size_t i) {
+        return hotel->quoteStay(PropertyGenerator::username(i % customers), stays[i % stays.size()].type,
+                                stays[i % stays.size()].checkIn, stays[i % stays.size()].checkOut) > 0;
+    });
+    measure(recorder, "authenticate", config.ops, [&](size_t) {
+        size_t customer = rng() % customers;
+        try {
+            return static_cast<bool>(hotel->authenticate(PropertyGenerator::username(customer), PropertyGenerator::password(customer)));
+        }
+        catch (const BookingException&) {
+            return false;
+        }
+    });
+    measure(recorder, "find_customer_by_email", config.ops, [&](size_t) {
+        return static_cast<bool>(hotel->findCustomerByEmail(PropertyGenerator::email(rng() % customers)));
+    });
+    measure(recorder, "find_customer_by_phone", config.ops, [&](size_t) {
+        return static_cast<bool>(hotel->findCustomerByPhone(PropertyGenerator::phone(rng() % customers)));
+    });
+    long long scannedPoints = 0;
+    seconds = timeSeconds([&] {
+        hotel->forEachCustomer([&scannedPoints](const Customer& customer) { scannedPoints += customer.getLoyaltyPoints(); });
+    });
+    recorder.record("scan_customers", 1, scannedPoints < 0 ? 1 : 0, seconds); // The sum is used so the scan is not optimized away
+    measure(recorder, "customer_bookings", config.ops, [&](size_t) {
+        hotel->getCustomerBookings(PropertyGenerator::username(rng() % customers));
+        return true;
+    });
+
+    // Whole-hotel listings and reports scale with the room count, so they run fewer times
+    const size_t listingOps = max<size_t>(5, config.ops * 1000 / size);
+    measure(recorder, "rooms_free_for", listingOps, [&](size_t) {
+        int checkIn, checkOut;
+        randomStay(checkIn, checkOut);
+        return !hotel->getRoomsFreeFor(static_cast<RoomType>(rng() % ROOM_TYPE_COUNT), checkIn, checkOut).empty();
+    });
+    measure(recorder, "get_available_rooms", listingOps, [&](size_t) {
+        return !hotel->getAvailableRooms().empty();
+    });
+    NullBuffer discard;
+    streambuf* console = cout.rdbuf(&discard);
+    measure(recorder, "view_available_rooms", listingOps, [&](size_t) {
+        hotel->viewAvailableRooms();
+        return true;
+    });
+    measure(recorder, "occupancy_report", listingOps, [&](size_t) {
+        HotelBench::occupancyReport(*hotel);
+        return true;
+    });
+    measure(recorder, "popular_types_report", listingOps, [&](size_t) {
+        HotelBench::popularRoomTypesReport(*hotel);
+        return true;
+    });
+    cout.rdbuf(console);
+
+    // A front-desk terminal attaches to the view the hotel publishes and copies it before printing
+    const string viewName = availabilityViewName("");
+    measure(recorder, "attach_view", config.ops, [&](size_t) {
+        AvailabilityView view;
+        return view.attach(viewName);
+    });
+    AvailabilityView view;
+    AvailabilitySnapshot snapshot;
+    view.attach(viewName);
+    measure(recorder, "read_view", config.ops, [&](size_t) {
+        return view.isAttached() && view.read(snapshot) && snapshot.getTotalRooms() == size;
+    });
+
+    recorder.record("shutdown", 1, 0, timeSeconds([&] { hotel.reset(); }));
+    removeDataFiles();
+}
+
+// Time a chain-wide search as properties of the same size are added; it should stay flat
+void benchChain(const BenchConfig& config, BenchRecorder& recorder) {
+    const size_t size = config.sizes.front();
+    const size_t customers = max<size_t>(1, static_cast<size_t>(size * config.customersPerRoom));
+    const string chainDir = "chain/";
+    mkdir(chainDir.c_str(), 0755);
+    mkdir((chainDir + "properties").c_str(), 0755);
+    vector<string> propertyDirs{chainDir};
+
+    // Each property gets its own generated rooms and bookings; only the first one's customers are used
+    auto generateInto = [&](const string& dir, uint32_t seed) {
+        PropertyGenerator generator(seed);
+        generator.generate(size, config.roomsPerFloor, customers, config.density);
+        for (const char* file : {"customers.txt", "rooms.txt", "bookings.txt"}) {
+            rename(file, (dir + file).c_str());
+        }
+        return generator.bookingCount;
+    };
+    size_t bookings = generateInto(chainDir, config.seed);
+
+    for (size_t properties : config.chainProperties) {
+        while (propertyDirs.size() < properties) {
+            string dir = chainDir + "properties/p" + to_string(propertyDirs.size()) + "/";
+            mkdir(dir.c_str(), 0755);
+            bookings += generateInto(dir, config.seed + static_cast<uint32_t>(propertyDirs.size()));
+            propertyDirs.push_back(dir);
+        }
+        recorder.setProperty(size * properties, customers, bookings, config.density);
+        unique_ptr<HotelChain> chain;
+        recorder.record("chain_open", 1, 0, timeSeconds([&] { chain = make_unique<HotelChain>(chainDir); }));
+
+        mt19937 rng(config.seed + 2);
+        const int firstNight = chain->getCustomerHome().getFirstBookableNight();
+        const size_t searches = max<size_t>(5, config.ops * 1000 / size);
+        measure(recorder, "chain_search", searches, [&](size_t) {
+            int checkIn = firstNight + static_cast<int>(rng() % 300);
+            int checkOut = checkIn + 1 + static_cast<int>(rng() % 7);
+            return !chain->findFreeRooms(static_cast<RoomType>(rng() % ROOM_TYPE_COUNT), checkIn, checkOut, 20).empty();
+        });
+    }
+
+    for (size_t i = 1; i < propertyDirs.size(); ++i) {
+        removeDataFiles(propertyDirs[i]);
+        rmdir(propertyDirs[i].c_str());
+    }
+    rmdir((chainDir + "properties").c_str());
+    removeDataFiles(chainDir);
+    rmdir(chainDir.c_str());
+}
+
+// Time a 90-night occupancy forecast as threads are added; it should scale linearly up to the core count
+void benchForecast(const BenchConfig& config, BenchRecorder& recorder) {
+    const size_t size = config.sizes.front();
+    const size_t customers = max<size_t>(1, static_cast<size_t>(size * config.customersPerRoom));
+    PropertyGenerator generator(config.seed);
+    removeDataFiles();
+    generator.generate(size, config.roomsPerFloor, customers, config.density);
+    recorder.setProperty(size, customers, generator.bookingCount, config.density);
+    Hotel hotel;
+    ForecastConfig forecast = hotel.defaultForecastConfig();
+    forecast.runs = config.forecastRuns;
+    for (size_t threads : config.forecastThreads) {
+        string op = "forecast_" + to_string(threads) + "_threads";
+        // One iteration per simulated season
+        recorder.record(op.c_str(), forecast.runs, 0, timeSeconds([&] { hotel.forecastOccupancy(forecast, threads); }));
+    }
+    removeDataFiles();
+}
+
+// Time the stay-history scans over an archive of generated stays by the customers of the first size
+void benchStayHistory(const BenchConfig& config, BenchRecorder& recorder) {
+    const size_t customers = max<size_t>(1, static_cast<size_t>(config.sizes.front() * config.customersPerRoom));
+    removeDataFiles();
+    recorder.setProperty(config.sizes.front(), customers, config.historyRows, config.density);
+    mt19937 rng(config.seed + 3);
+    {
+        // Three years of stays in check-in order, one in ten cancelled
+        StayArchive archive("history/");
+        const int firstDay = todayDayNumber() - 3 * 365;
+        for (size_t i = 0; i < config.historyRows; ++i) {
+            RoomType type = static_cast<RoomType>(rng() % ROOM_TYPE_COUNT);
+            int checkIn = firstDay + static_cast<int>(i * 3 * 365 / config.historyRows);
+            int nights = 1 + static_cast<int>(rng() % 7);
+            archive.add({PropertyGenerator::roomNumber(rng() % config.sizes.front(), config.roomsPerFloor), type,
+                         static_cast<uint32_t>(rng() % customers), checkIn, checkIn + nights,
+                         static_cast<int32_t>(roomPrice(type) * nights), static_cast<int32_t>(roomPrice(type) * 0.1),
+                         rng() % 10 ? StayOutcome::CHECKED_OUT : StayOutcome::CANCELLED});
+        }
+        recorder.record("archive_stays", config.historyRows, 0, timeSeconds([&] { archive.flush(); }));
+    }
+    StayArchive archive("history/");
+    const size_t threads = max(1u, thread::hardware_concurrency());
+    WorkStealingPool pool(threads > 1 ? threads - 1 : 1);
+    // One iteration per row; the first pass of each query faults the columns in and is not timed
+    int64_t revenue = 0;
+    archive.totalsByMonth(pool);
+    recorder.record("stays_by_month", config.historyRows, 0, timeSeconds([&] {
+        for (const StayMonthTotals& totals : archive.totalsByMonth(pool)) revenue += totals.revenue;
+    }));
+    archive.topCustomers(10, static_cast<uint32_t>(customers), pool);
+    size_t found = 0;
+    recorder.record("top_customers", config.historyRows, 0, timeSeconds([&] {
+        found = archive.topCustomers(10, static_cast<uint32_t>(customers), pool).size();
+    }));
+    if (revenue <= 0 || found == 0) {
+        throw BookingException("Stay-history queries found nothing in the generated archive.");
+    }
+    removeDataFiles();
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    bool usageError = false;
+    for (int i = 1; i < argc && !usageError; ++i) {
+        string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc) {
+            config.sizes.clear();
+            stringstream list(argv[++i]);
+            string item;
+            while (getline(list, item, ',')) {
+                int size = atoi(item.c_str());
+                if (size <= 0) usageError = true;
+                config.sizes.push_back(static_cast<size_t>(size));
+            }
+        }
+        else if (arg == "--rooms-per-floor" && i + 1 < argc) {
+            config.roomsPerFloor = atoi(argv[++i]);
+        }
+        else if (arg == "--customers-per-room" && i + 1 < argc) {
+            config.customersPerRoom = atof(argv[++i]);
+        }
+        else if (arg == "--density" && i + 1 < argc) {
+            config.density = atof(argv[++i]);
+        }
+        else if (arg == "--ops" && i + 1 < argc) {
+            config.ops = static_cast<size_t>(max(1, atoi(argv[++i])));
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--out" && i + 1 < argc) {
+            config.outPath = argv[++i];
+        }
+        else if (arg == "--dir" && i + 1 < argc) {
+            config.dir = argv[++i];
+        }
+        else if (arg == "--chain-properties" && i + 1 < argc) {
+            config.chainProperties.clear();
+            stringstream list(argv[++i]);
+            string item;
+            while (getline(list, item, ',')) {
+                int count = atoi(item.c_str());
+                if (count <= 0) usageError = true;
+                config.chainProperties.push_back(static_cast<size_t>(count));
+            }
+            sort(config.chainProperties.begin(), config.chainProperties.end());
+        }
+        else if (arg == "--forecast-threads" && i + 1 < argc) {
+            config.forecastThreads.clear();
+            stringstream list(argv[++i]);
+            string item;
+            while (getline(list, item, ',')) {
+                int count = atoi(item.c_str());
+                if (count <= 0) usageError = true;
+                config.forecastThreads.push_back(static_cast<size_t>(count));
+            }
+        }
+        else if (arg == "--forecast-runs" && i + 1 < argc) {
+            config.forecastRuns = static_cast<size_t>(max(1, atoi(argv[++i])));
+        }
+        else if (arg == "--history-rows" && i + 1 < argc) {
+            config.historyRows = static_cast<size_t>(max(1L, atol(argv[++i])));
+        }
+        else {
+            usageError = true;
+        }
+    }
+    if (usageError || config.sizes.empty() || config.roomsPerFloor < 1 ||
+        config.roomsPerFloor >= RoomInventory::FLOOR_STRIDE || config.customersPerRoom <= 0 ||
+        config.density < 0 || config.density > 1) {
+        cerr << "Usage: " << argv[0] << " [--sizes 1000,10000,...] [--rooms-per-floor 1-99] [--customers-per-room X]\n"
+             << "       [--density 0-1] [--ops N] [--seed S] [--out results.jsonl] [--dir scratch-directory]\n"
+             << "       [--chain-properties 1,2,4,...] [--forecast-threads 1,2,4,...] [--forecast-runs N]\n"
+             << "       [--history-rows N]\n";
+        return 1;
+    }
+
+    // The hotel reads and writes its files in the working directory, so run in a scratch one
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd))) {
+        cerr << "Error reading the working directory.\n";
+        return 1;
+    }
+    if (config.outPath[0] != '/') config.outPath = string(cwd) + "/" + config.outPath;
+    bool temporaryDir = config.dir.empty();
+    if (temporaryDir) {
+        char pattern[] = "/tmp/hotel-bench-XXXXXX";
+        if (!mkdtemp(pattern)) {
+            cerr << "Error creating a scratch directory.\n";
+            return 1;
+        }
+        config.dir = pattern;
+    }
+    if (chdir(config.dir.c_str()) != 0) {
+        cerr << "Error entering " << config.dir << ".\n";
+        return 1;
+    }
+
+    try {
+        BenchRecorder recorder(config.outPath);
+        for (size_t size : config.sizes) {
+            benchSize(config, size, recorder);
+        }
+        benchChain(config, recorder);
+        benchForecast(config, recorder);
+        benchStayHistory(config, recorder);
+    }
+    catch (const BookingException& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+    if (chdir(cwd) == 0 && temporaryDir) {
+        rmdir(config.dir.c_str());
+    }
+    cerr << "Results written to " << config.outPath << "\n";
+    return 0;
+}
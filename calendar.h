@@ -0,0 +1,277 @@
+/* ======================================
+   Availability Calendar
+   Per-room night bitmaps for date-ranged reservations. Every night is one
+   bit, stored twice: room-major (for single room checks) and night-major
+   (so "rooms of a type free for a range" is a word-parallel AND across rooms).
+   ====================================== */
+
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <cstdint>       // For fixed width integers
+#include <cstdio>        // For snprintf
+#include <ctime>         // For the current local date
+#include <string>        // For using string class
+#include <string_view>   // For parsing dates in place
+#include <vector>        // For using vector container
+#include "room_inventory.h" // For RoomId and RoomType
+
+// Dates are handled as day numbers (days since 1970-01-01). A stay from
+// checkIn to checkOut occupies the nights [checkIn, checkOut).
+
+/**
+ * @brief Convert a civil date to a day number.
+ */
+inline int daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int>(doe) - 719468;
+}
+
+/**
+ * @brief Convert a day number to a civil date.
+ */
+inline void civilFromDays(int day, int& y, unsigned& m, unsigned& d) {
+    day += 719468;
+    const int era = (day >= 0 ? day : day - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(day - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+}
+
+/**
+ * @brief Format a day number as YYYY-MM-DD.
+ */
+inline std::string formatDate(int day) {
+    int y;
+    unsigned m, d;
+    civilFromDays(day, y, m, d);
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u", y, m, d);
+    return buf;
+}
+
+/**
+ * @brief Parse a YYYY-MM-DD date.
+ * @param text Date string.
+ * @param day Receives the day number on success.
+ * @return True if the text is a valid calendar date.
+ */
+inline bool parseDate(std::string_view text, int& day) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return false;
+    int parts[3] = {0, 0, 0};
+    const int starts[3] = {0, 5, 8};
+    const int lengths[3] = {4, 2, 2};
+    for (int p = 0; p < 3; ++p) {
+        for (int i = 0; i < lengths[p]; ++i) {
+            char c = text[starts[p] + i];
+            if (c < '0' || c > '9') return false;
+            parts[p] = parts[p] * 10 + (c - '0');
+        }
+    }
+    if (parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > 31) return false;
+    day = daysFromCivil(parts[0], static_cast<unsigned>(parts[1]), static_cast<unsigned>(parts[2]));
+    // Reject dates such as 2025-02-30 that roll over into the next month
+    return formatDate(day) == text;
+}
+
+/**
+ * @brief Today's local date as a day number.
+ */
+inline int todayDayNumber() {
+    time_t now = time(nullptr);
+    tm local{};
+    localtime_r(&now, &local);
+    return daysFromCivil(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1),
+                         static_cast<unsigned>(local.tm_mday));
+}
+
+/**
+ * @class AvailabilityCalendar
+ * @brief Night-level occupancy for every room over a fixed booking horizon.
+ *
+ * Rooms are addressed by their RoomId. Bit n of a room's row is night
+ * firstNight + n. The same bits are kept in a night-major matrix with one row
+ * of room bits per night, so a date-range search for a room type ANDs a few
+ * hundred words per night instead of probing every room.
+ */
+class AvailabilityCalendar {
+public:
+    static constexpr int HORIZON_NIGHTS = 512; // Roughly 17 months ahead
+    static constexpr int WORDS_PER_ROOM = HORIZON_NIGHTS / 64;
+
+private:
+    int firstNight = 0;
+    size_t roomCount = 0;
+    size_t roomWords = 0; // Words in one night-major row
+    std::vector<uint64_t> roomsOfType[ROOM_TYPE_COUNT]; // type -> room id bitset
+    std::vector<uint64_t> byRoom;  // id * WORDS_PER_ROOM + word
+    std::vector<uint64_t> byNight; // night * roomWords + word
+
+    // Clamp a stay to the horizon; returns false if nothing is left
+    bool toOffsets(int checkIn, int checkOut, int& from, int& to) const {
+        from = checkIn - firstNight;
+        to = checkOut - firstNight;
+        if (from < 0) from = 0;
+        if (to > HORIZON_NIGHTS) to = HORIZON_NIGHTS;
+        return from < to;
+    }
+
+    // Mask of nights [from, to) that fall into word w of a room row
+    static uint64_t nightMask(int w, int from, int to) {
+        int lo = w * 64, hi = lo + 64;
+        if (from > lo) lo = from;
+        if (to < hi) hi = to;
+        if (lo >= hi) return 0;
+        int width = hi - lo;
+        uint64_t bits = width == 64 ? ~0ULL : ((1ULL << width) - 1);
+        return bits << (lo - w * 64);
+    }
+
+    void setNights(RoomId id, int from, int to, bool booked) {
+        uint64_t* row = &byRoom[static_cast<size_t>(id) * WORDS_PER_ROOM];
+        for (int w = from / 64; w <= (to - 1) / 64; ++w) {
+            uint64_t mask = nightMask(w, from, to);
+            row[w] = booked ? (row[w] | mask) : (row[w] & ~mask);
+        }
+        const size_t word = static_cast<size_t>(id) / 64;
+        const uint64_t bit = 1ULL << (id % 64);
+        for (int n = from; n < to; ++n) {
+            uint64_t& cell = byNight[static_cast<size_t>(n) * roomWords + word];
+            cell = booked ? (cell | bit) : (cell & ~bit);
+        }
+    }
+
+public:
+    /**
+     * @brief Rebuild the calendar for an inventory with every night free.
+     * @param first Day number of the first night in the horizon.
+     * @param rooms Inventory whose ids the calendar follows.
+     */
+    void reset(int first, const RoomInventory& rooms) {
+        firstNight = first;
+        roomCount = rooms.size();
+        roomWords = (roomCount + 63) / 64;
+        for (auto& bits : roomsOfType) {
+            bits.assign(roomWords, 0);
+        }
+        for (size_t id = 0; id < roomCount; ++id) {
+            size_t t = static_cast<size_t>(rooms.getType(static_cast<RoomId>(id)));
+            roomsOfType[t][id / 64] |= 1ULL << (id % 64);
+        }
+        byRoom.assign(roomCount * WORDS_PER_ROOM, 0);
+        byNight.assign(static_cast<size_t>(HORIZON_NIGHTS) * roomWords, 0);
+    }
+
+    int getFirstNight() const { return firstNight; }
+    int getLastNight() const { return firstNight + HORIZON_NIGHTS - 1; }
+
+    /**
+     * @brief Check that a stay lies entirely within the bookable horizon.
+     */
+    bool inHorizon(int checkIn, int checkOut) const {
+        return checkIn >= firstNight && checkIn < checkOut && checkOut <= firstNight + HORIZON_NIGHTS;
+    }
+
+    /**
+     * @brief Check whether a room is free for every night of a stay.
+     */
+    bool isFree(RoomId id, int checkIn, int checkOut) const {
+        int from, to;
+        if (!toOffsets(checkIn, checkOut, from, to)) return true;
+        const uint64_t* row = &byRoom[static_cast<size_t>(id) * WORDS_PER_ROOM];
+        for (int w = from / 64; w <= (to - 1) / 64; ++w) {
+            if (row[w] & nightMask(w, from, to)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reserve the nights of a stay.
+     *
+     * Nights before the horizon (a stay that is already under way) are not
+     * tracked and never conflict.
+     * @return False if any night is already taken.
+     */
+    bool book(RoomId id, int checkIn, int checkOut) {
+        if (!isFree(id, checkIn, checkOut)) return false;
+        int from, to;
+        if (toOffsets(checkIn, checkOut, from, to)) {
+            setNights(id, from, to, true);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Free the nights of a stay that was previously booked.
+     */
+    void release(RoomId id, int checkIn, int checkOut) {
+        int from, to;
+        if (toOffsets(checkIn, checkOut, from, to)) {
+            setNights(id, from, to, false);
+        }
+    }
+
+    /**
+     * @brief Visit every room of a type that is free for all nights of a stay.
+     * @param visit Called with each free room id, in ascending order.
+     */
+    template<typename Visit>
+    void forEachFreeRoom(RoomType type, int checkIn, int checkOut, Visit visit) const {
+        int from, to;
+        bool anyNights = toOffsets(checkIn, checkOut, from, to);
+        const std::vector<uint64_t>& candidates = roomsOfType[static_cast<size_t>(type)];
+        for (size_t w = 0; w < roomWords; ++w) {
+            uint64_t freeBits = candidates[w];
+            for (int n = from; anyNights && n < to && freeBits; ++n) {
+                freeBits &= ~byNight[static_cast<size_t>(n) * roomWords + w];
+            }
+            while (freeBits) {
+                int bit = __builtin_ctzll(freeBits);
+                freeBits &= freeBits - 1;
+                visit(static_cast<RoomId>(w * 64 + static_cast<size_t>(bit)));
+            }
+        }
+    }
+
+    /**
+     * @brief Like forEachFreeRoom, but stops as soon as visit returns false.
+     * @return False if the visit was stopped early.
+     */
+    template<typename Visit>
+    bool forEachFreeRoomWhile(RoomType type, int checkIn, int checkOut, Visit visit) const {
+        int from, to;
+        bool anyNights = toOffsets(checkIn, checkOut, from, to);
+        const std::vector<uint64_t>& candidates = roomsOfType[static_cast<size_t>(type)];
+        for (size_t w = 0; w < roomWords; ++w) {
+            uint64_t freeBits = candidates[w];
+            for (int n = from; anyNights && n < to && freeBits; ++n) {
+                freeBits &= ~byNight[static_cast<size_t>(n) * roomWords + w];
+            }
+            while (freeBits) {
+                int bit = __builtin_ctzll(freeBits);
+                freeBits &= freeBits - 1;
+                if (!visit(static_cast<RoomId>(w * 64 + static_cast<size_t>(bit)))) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Ids of the rooms of a type that are free for all nights of a stay.
+     */
+    std::vector<RoomId> freeRoomsOfType(RoomType type, int checkIn, int checkOut) const {
+        std::vector<RoomId> result;
+        forEachFreeRoom(type, checkIn, checkOut, [&result](RoomId id) { result.push_back(id); });
+        return result;
+    }
+};
+
+#endif // CALENDAR_H
@@ -0,0 +1,254 @@
+/* ======================================
+   CSV Loader
+   Parses the comma-separated data files in place: the file is mapped once,
+   split into chunks at line boundaries and the chunks are parsed on
+   separate threads. Fields are string_views into the mapping and numbers
+   go through from_chars, so a line costs no allocation unless the caller
+   keeps something from it.
+   ====================================== */
+
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+#include <algorithm>    // For std::min, std::count
+#include <charconv>     // For from_chars
+#include <cstdint>      // For fixed width integers
+#include <functional>   // For std::hash
+#include <iostream>     // For the error summary
+#include <string>       // For using string class
+#include <string_view>  // For fields
+#include <thread>       // For parsing chunks in parallel
+#include <type_traits>  // For detecting the parseLine signature
+#include <utility>      // For std::pair
+#include <vector>       // For using vector container
+
+/**
+ * @brief Split a line into comma-separated fields.
+ * @param line Line without its newline.
+ * @param fields Receives up to maxFields views into line.
+ * @return Number of fields in the line (may exceed maxFields).
+ */
+inline size_t splitFields(std::string_view line, std::string_view* fields, size_t maxFields) {
+    size_t count = 0;
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        size_t end = comma == std::string_view::npos ? line.size() : comma;
+        if (count < maxFields) fields[count] = line.substr(start, end - start);
+        ++count;
+        if (comma == std::string_view::npos) return count;
+        start = comma + 1;
+    }
+}
+
+/**
+ * @brief Parse a whole field as a decimal int.
+ * @return False if the field is empty, has trailing characters or overflows.
+ */
+inline bool parseInt(std::string_view text, int& value) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+/**
+ * @class LoadErrors
+ * @brief Counts rejected lines and keeps the first few for the summary.
+ */
+class LoadErrors {
+    static constexpr size_t MAX_SAMPLES = 5;
+
+    size_t count = 0;
+    std::vector<std::pair<size_t, std::string>> samples; // (line number or 0, reason)
+
+public:
+    void add(size_t line, std::string reason) {
+        if (samples.size() < MAX_SAMPLES) samples.emplace_back(line, std::move(reason));
+        ++count;
+    }
+
+    /**
+     * @brief Append another chunk's errors.
+     */
+    void merge(const LoadErrors& other) {
+        for (const auto& sample : other.samples) {
+            if (samples.size() >= MAX_SAMPLES) break;
+            samples.push_back(sample);
+        }
+        count += other.count;
+    }
+
+    size_t size() const { return count; }
+
+    /**
+     * @brief Print one warning for the file, if anything was skipped.
+     */
+    void report(const std::string& file, size_t lines) const {
+        if (count == 0) return;
+        std::cout << "Warning: skipped " << count << " of " << lines << " lines in " << file << ":\n";
+        for (const auto& [line, reason] : samples) {
+            std::cout << "  ";
+            if (line) std::cout << "line " << line << ": ";
+            std::cout << reason << "\n";
+        }
+        if (count > samples.size()) std::cout << "  ...\n";
+    }
+};
+
+/**
+ * @brief Run task(0) ... task(count - 1) on separate threads and wait for all of them.
+ *
+ * Task 0 runs on the calling thread.
+ */
+template<typename Task>
+void runInParallel(size_t count, Task task) {
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < count; ++i) {
+        workers.emplace_back(task, i);
+    }
+    if (count > 0) task(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Cut data into at most parts pieces that each end at a newline.
+ */
+inline std::vector<std::string_view> splitAtLines(std::string_view data, size_t parts) {
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+    for (size_t i = 1; i <= parts && start < data.size(); ++i) {
+        size_t end = i == parts ? data.size() : std::max(start, data.size() * i / parts);
+        end = data.find('\n', end);
+        end = end == std::string_view::npos ? data.size() : end + 1;
+        chunks.push_back(data.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+/**
+ * @brief Parse every non-empty line of a file image, in parallel for large inputs.
+ *
+ * The data is cut into one chunk per thread at newline boundaries. Each
+ * chunk appends its rows to its own vector, so the caller can merge the
+ * results in file order and let later lines win.
+ *
+ * @param data Whole file contents.
+ * @param parseLine Called as parseLine(line, rows) or parseLine(line, lineNumber, rows)
+ *                  for each line; returns nullptr on success or a static reason
+ *                  string to reject it.
+ * @param errors Receives the rejected lines, numbered from 1.
+ * @param lines Receives the number of non-empty lines.
+ * @return Rows of each chunk, in file order.
+ */
+template<typename Row, typename ParseLine>
+std::vector<std::vector<Row>> parseLinesInParallel(std::string_view data, ParseLine parseLine,
+                                                   LoadErrors& errors, size_t& lines) {
+    // Threads only pay off once there are a few MB to share out
+    constexpr size_t MIN_CHUNK_BYTES = 4 << 20;
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, data.size() / MIN_CHUNK_BYTES + 1);
+    std::vector<std::string_view> chunks = splitAtLines(data, threads);
+
+    struct ChunkResult {
+        std::vector<Row> rows;
+        LoadErrors errors;
+        size_t firstLine = 1;
+        size_t nonEmpty = 0;
+    };
+    std::vector<ChunkResult> results(chunks.size());
+    // Counting newlines first lets every chunk number its lines as in the file
+    if (chunks.size() > 1) {
+        std::vector<size_t> newlines(chunks.size());
+        runInParallel(chunks.size(), [&](size_t c) {
+            newlines[c] = static_cast<size_t>(std::count(chunks[c].begin(), chunks[c].end(), '\n'));
+        });
+        for (size_t c = 1; c < chunks.size(); ++c) {
+            results[c].firstLine = results[c - 1].firstLine + newlines[c - 1];
+        }
+    }
+
+    runInParallel(chunks.size(), [&](size_t c) {
+        std::string_view chunk = chunks[c];
+        ChunkResult& result = results[c];
+        size_t lineNumber = result.firstLine;
+        size_t pos = 0;
+        while (pos < chunk.size()) {
+            size_t newline = chunk.find('\n', pos);
+            size_t end = newline == std::string_view::npos ? chunk.size() : newline;
+            std::string_view line = chunk.substr(pos, end - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty()) {
+                ++result.nonEmpty;
+                const char* reason;
+                if constexpr (std::is_invocable_v<ParseLine&, std::string_view, size_t, std::vector<Row>&>) {
+                    reason = parseLine(line, lineNumber, result.rows);
+                }
+                else {
+                    reason = parseLine(line, result.rows);
+                }
+                if (reason) result.errors.add(lineNumber, reason);
+            }
+            ++lineNumber;
+            pos = end + 1;
+        }
+    });
+
+    std::vector<std::vector<Row>> rows;
+    rows.reserve(results.size());
+    lines = 0;
+    for (auto& result : results) {
+        errors.merge(result.errors);
+        lines += result.nonEmpty;
+        rows.push_back(std::move(result.rows));
+    }
+    return rows;
+}
+
+/**
+ * @class StringViewIndex
+ * @brief Insert-only hash set over a column of keys, for de-duplicating bulk input.
+ *
+ * Open addressing over one flat array of 8-byte slots holding a hash tag and
+ * a position in the column, so there is no allocation per key and most
+ * probes are settled without comparing strings.
+ */
+class StringViewIndex {
+    const std::vector<std::string_view>& keys;
+    std::vector<uint64_t> slots; // (tag << 32) | (position + 1); 0 marks a free slot
+    size_t mask;
+
+public:
+    /**
+     * @param column Keys to index; must outlive the index and not change.
+     */
+    explicit StringViewIndex(const std::vector<std::string_view>& column) : keys(column) {
+        size_t size = 16;
+        while (size < keys.size() * 2) size *= 2;
+        slots.assign(size, 0);
+        mask = size - 1;
+    }
+
+    /**
+     * @brief Add keys[position] unless an equal key was added before.
+     * @return position if it was added, else the position of the equal key.
+     */
+    uint32_t insert(uint32_t position) {
+        const std::string_view key = keys[position];
+        const size_t hash = std::hash<std::string_view>()(key);
+        const uint64_t tag = static_cast<uint32_t>(hash >> 32);
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            uint64_t slot = slots[i];
+            if (slot == 0) {
+                slots[i] = (tag << 32) | (static_cast<uint64_t>(position) + 1);
+                return position;
+            }
+            uint32_t other = static_cast<uint32_t>(slot) - 1;
+            if ((slot >> 32) == tag && keys[other] == key) return other;
+        }
+    }
+};
+
+#endif // CSV_LOADER_H
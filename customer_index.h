@@ -0,0 +1,158 @@
+/* ======================================
+   Customer Index
+   Flat hash tables from a customer key (username, email, phone number or
+   Adhaar number) to the customer's id in the CustomerTable. Phone and
+   Adhaar numbers are fixed-length digit strings and are keyed by their
+   packed integer value, strings by their hash. A slot holds only a 32-bit
+   fingerprint of the key and the id; candidates are confirmed against the
+   customer's own record, so no key is copied. Each lookup is one probe
+   sequence in one array of 8-byte slots.
+   ====================================== */
+
+#ifndef CUSTOMER_INDEX_H
+#define CUSTOMER_INDEX_H
+
+#include <cstdint>     // For fixed width integers
+#include <string_view> // For keys given in place
+#include <vector>      // For the slot array
+
+constexpr size_t PHONE_DIGITS = 10;
+constexpr size_t ADHAAR_DIGITS = 12;
+
+/**
+ * @brief Pack a string of exactly length decimal digits into an integer.
+ * @return False if the text has another length or a non-digit.
+ */
+inline bool packDigits(std::string_view text, size_t length, uint64_t& packed) {
+    if (text.size() != length) return false;
+    packed = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        packed = packed * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
+
+/**
+ * @class IdTable
+ * @brief Open-addressing map from a 64-bit key to a 32-bit id.
+ *
+ * Linear probing over one array of (fingerprint, id) slots, kept at most
+ * 70% full. The fingerprint is the top half of the mixed key and its top
+ * bits pick the home slot, so the table can grow without the keys. Several
+ * ids may share a fingerprint; the caller's match function checks the
+ * candidate's record and tells them apart. Erasing shifts the following
+ * slots back, so there are no tombstones to slow later probes.
+ */
+class IdTable {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+private:
+    struct Slot {
+        uint32_t fingerprint;
+        uint32_t ref; // id + 1; 0 marks a free slot
+    };
+    std::vector<Slot> slots;
+    size_t used = 0;
+    size_t mask = 0;
+    unsigned bits = 0; // slots.size() == 1 << bits
+
+    // Spread packed numbers, which differ mostly in their low digits, over the whole fingerprint
+    static uint32_t fingerprintOf(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return static_cast<uint32_t>(key >> 32);
+    }
+
+    size_t home(uint32_t fingerprint) const { return fingerprint >> (32 - bits); }
+
+    void rehash(unsigned newBits) {
+        std::vector<Slot> old(size_t(1) << newBits, Slot{0, 0});
+        old.swap(slots);
+        bits = newBits;
+        mask = slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (!slot.ref) continue;
+            size_t i = home(slot.fingerprint);
+            while (slots[i].ref) i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
+
+public:
+    void clear() {
+        std::vector<Slot>().swap(slots);
+        used = 0;
+        mask = 0;
+        bits = 0;
+    }
+
+    void reserve(size_t count) {
+        unsigned newBits = 4;
+        while ((size_t(1) << newBits) * 7 < count * 10) ++newBits;
+        if (newBits > bits) rehash(newBits);
+    }
+
+    size_t size() const { return used; }
+    size_t memoryBytes() const { return slots.capacity() * sizeof(Slot); }
+
+    /**
+     * @brief The first id stored under key that match accepts, or NONE.
+     * @param match Called with each id whose fingerprint equals the key's; true if its record has the key.
+     */
+    template<typename Match>
+    uint32_t find(uint64_t key, Match match) const {
+        if (slots.empty()) return NONE;
+        const uint32_t fingerprint = fingerprintOf(key);
+        for (size_t i = home(fingerprint); slots[i].ref; i = (i + 1) & mask) {
+            if (slots[i].fingerprint == fingerprint && match(slots[i].ref - 1)) return slots[i].ref - 1;
+        }
+        return NONE;
+    }
+
+    /**
+     * @brief Store id under key unless match accepts an id already there.
+     * @return The id now holding the key: id, or the earlier holder.
+     */
+    template<typename Match>
+    uint32_t insert(uint64_t key, uint32_t id, Match match) {
+        if ((used + 1) * 10 > slots.size() * 7) rehash(slots.empty() ? 4 : bits + 1);
+        const uint32_t fingerprint = fingerprintOf(key);
+        size_t i = home(fingerprint);
+        for (; slots[i].ref; i = (i + 1) & mask) {
+            if (slots[i].fingerprint == fingerprint && match(slots[i].ref - 1)) return slots[i].ref - 1;
+        }
+        slots[i] = Slot{fingerprint, id + 1};
+        ++used;
+        return id;
+    }
+
+    /**
+     * @brief Remove id from key; nothing happens if it is not stored there.
+     */
+    void erase(uint64_t key, uint32_t id) {
+        if (slots.empty()) return;
+        size_t hole = home(fingerprintOf(key));
+        while (slots[hole].ref && slots[hole].ref != id + 1) {
+            hole = (hole + 1) & mask;
+        }
+        if (!slots[hole].ref) return;
+        // Move back every later slot of the run whose home is not between the hole and itself
+        for (size_t j = (hole + 1) & mask; slots[j].ref; j = (j + 1) & mask) {
+            size_t start = home(slots[j].fingerprint);
+            bool stays = hole <= j ? (hole < start && start <= j) : (hole < start || start <= j);
+            if (!stays) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+        slots[hole] = Slot{0, 0};
+        --used;
+    }
+};
+
+#endif // CUSTOMER_INDEX_H
@@ -0,0 +1,250 @@
+/* ======================================
+   Customer Store
+   Every customer as one fixed-size record in a contiguous array, addressed
+   by a CustomerId. Usernames, names, emails and passwords are copied into
+   a string arena of large blocks and referenced by offset and length;
+   phone and Adhaar numbers are packed into integers. Hash indexes on the
+   username, email, phone and Adhaar number map keys to ids, so a customer
+   costs one record, its text and a few index slots instead of a heap
+   object per field.
+   ====================================== */
+
+#ifndef CUSTOMER_STORE_H
+#define CUSTOMER_STORE_H
+
+#include <algorithm>        // For std::min and std::max
+#include <cstdint>          // For fixed width integers
+#include <cstring>          // For memcpy
+#include <functional>       // For std::hash
+#include <memory>           // For the arena blocks
+#include <string>           // For formatting packed numbers
+#include <string_view>      // For text kept in the arena
+#include <vector>           // For the record array
+#include "customer_index.h" // For IdTable and packDigits
+#include "loyalty_ledger.h" // For LoyaltyAccount
+
+using CustomerId = uint32_t;
+constexpr CustomerId NO_CUSTOMER = IdTable::NONE;
+
+/**
+ * @class StringArena
+ * @brief Append-only text in blocks that never move.
+ *
+ * A view of added text stays valid until clear(). Text is never freed
+ * one string at a time; a replaced value simply stops being referenced.
+ */
+class StringArena {
+public:
+    using Ref = uint64_t; // (offset << LENGTH_BITS) | length; the top bit is always clear
+    static constexpr unsigned LENGTH_BITS = 23;
+    static constexpr size_t MAX_LENGTH = (size_t(1) << LENGTH_BITS) - 1;
+
+private:
+    static constexpr unsigned BLOCK_BITS = 20;
+    static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockUsed = 0;     // Bytes taken in the last block
+    size_t blockCapacity = 0; // Size of the last block
+    size_t allocated = 0;
+
+public:
+    void clear() {
+        blocks.clear();
+        blockUsed = blockCapacity = allocated = 0;
+    }
+
+    /**
+     * @brief Copy text into the arena; text longer than MAX_LENGTH is cut short.
+     */
+    Ref add(std::string_view text) {
+        const size_t length = std::min(text.size(), MAX_LENGTH);
+        if (length == 0) return 0;
+        if (blockUsed + length > blockCapacity) {
+            blockCapacity = std::max(BLOCK_SIZE, length);
+            blocks.emplace_back(new char[blockCapacity]);
+            allocated += blockCapacity;
+            blockUsed = 0;
+        }
+        const uint64_t offset = (static_cast<uint64_t>(blocks.size() - 1) << BLOCK_BITS) | blockUsed;
+        std::memcpy(blocks.back().get() + blockUsed, text.data(), length);
+        // An oversized block holds its one string; offsets within a block must fit in BLOCK_BITS
+        blockUsed = blockCapacity > BLOCK_SIZE ? blockCapacity : blockUsed + length;
+        return (offset << LENGTH_BITS) | length;
+    }
+
+    std::string_view view(Ref ref) const {
+        const size_t length = ref & MAX_LENGTH;
+        if (length == 0) return {};
+        const uint64_t offset = ref >> LENGTH_BITS;
+        return {blocks[offset >> BLOCK_BITS].get() + (offset & (BLOCK_SIZE - 1)), length};
+    }
+
+    size_t memoryBytes() const { return allocated; }
+};
+
+/**
+ * @struct CustomerRecord
+ * @brief One customer: arena references for the text and packed numbers.
+ */
+struct CustomerRecord {
+    StringArena::Ref username, name, email, password;
+    uint64_t phone;  // Digits packed into an integer, or DIGITS_AS_TEXT | arena ref if they are not all digits
+    uint64_t adhaar; // Same encoding as phone
+    LoyaltyAccount account;
+};
+
+/**
+ * @class CustomerTable
+ * @brief Customers in id order with hash indexes on their keys.
+ *
+ * Ids are dense and never reused, so a full scan is a walk over one array.
+ * Usernames are unique. The first customer added with an email, phone or
+ * Adhaar number holds it in that index; a phone or Adhaar number that is
+ * not exactly 10 or 12 digits (possible only in hand-edited data files) is
+ * kept as text and is not indexed.
+ */
+class CustomerTable {
+    static constexpr uint64_t DIGITS_AS_TEXT = 1ULL << 63;
+
+    std::vector<CustomerRecord> records;
+    StringArena text;
+    IdTable byUsername; // Key: hash of the username
+    IdTable byEmail;    // Key: hash of the email
+    IdTable byPhone;    // Key: packed phone number
+    IdTable byAdhaar;   // Key: packed Adhaar number
+
+    static uint64_t hashOf(std::string_view key) { return std::hash<std::string_view>()(key); }
+
+    uint64_t storeDigits(std::string_view value, size_t digits) {
+        uint64_t packed;
+        return packDigits(value, digits, packed) ? packed : DIGITS_AS_TEXT | text.add(value);
+    }
+
+    std::string formatDigits(uint64_t field, size_t digits) const {
+        if (field & DIGITS_AS_TEXT) return std::string(text.view(field & ~DIGITS_AS_TEXT));
+        std::string result(digits, '0');
+        for (size_t i = digits; i-- > 0; field /= 10) {
+            result[i] = static_cast<char>('0' + field % 10);
+        }
+        return result;
+    }
+
+    // Add or drop a customer's email, phone and Adhaar entries
+    void indexContacts(CustomerId id) {
+        const CustomerRecord& record = records[id];
+        const std::string_view email = text.view(record.email);
+        byEmail.insert(hashOf(email), id, [this, email](uint32_t other) { return getEmail(other) == email; });
+        const uint64_t phone = record.phone, adhaar = record.adhaar;
+        if (!(phone & DIGITS_AS_TEXT)) byPhone.insert(phone, id, [this, phone](uint32_t other) { return records[other].phone == phone; });
+        if (!(adhaar & DIGITS_AS_TEXT)) byAdhaar.insert(adhaar, id, [this, adhaar](uint32_t other) { return records[other].adhaar == adhaar; });
+    }
+
+    void unindexContacts(CustomerId id) {
+        const CustomerRecord& record = records[id];
+        byEmail.erase(hashOf(text.view(record.email)), id);
+        if (!(record.phone & DIGITS_AS_TEXT)) byPhone.erase(record.phone, id);
+        if (!(record.adhaar & DIGITS_AS_TEXT)) byAdhaar.erase(record.adhaar, id);
+    }
+
+public:
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+
+    void clear() {
+        std::vector<CustomerRecord>().swap(records);
+        text.clear();
+        byUsername.clear();
+        byEmail.clear();
+        byPhone.clear();
+        byAdhaar.clear();
+    }
+
+    void reserve(size_t count) {
+        records.reserve(count);
+        byUsername.reserve(count);
+        byEmail.reserve(count);
+        byPhone.reserve(count);
+        byAdhaar.reserve(count);
+    }
+
+    /**
+     * @brief Add a customer; the username must not be taken (see find()).
+     */
+    CustomerId add(std::string_view username, std::string_view name, std::string_view email,
+                   std::string_view phone, std::string_view adhaar, std::string_view password,
+                   LoyaltyAccount account) {
+        const CustomerId id = static_cast<CustomerId>(records.size());
+        records.push_back({text.add(username), text.add(name), text.add(email), text.add(password),
+                           storeDigits(phone, PHONE_DIGITS), storeDigits(adhaar, ADHAAR_DIGITS), account});
+        byUsername.insert(hashOf(username), id, [](uint32_t) { return false; });
+        indexContacts(id);
+        return id;
+    }
+
+    /**
+     * @brief Drop the customers added last, keeping the first count. Their text stays in the arena until clear().
+     */
+    void truncate(size_t count) {
+        while (records.size() > count) {
+            const CustomerId id = static_cast<CustomerId>(records.size() - 1);
+            byUsername.erase(hashOf(getUsername(id)), id);
+            unindexContacts(id);
+            records.pop_back();
+        }
+    }
+
+    /**
+     * @brief Replace everything but the username and loyalty account, e.g. for a customer listed twice in a file.
+     */
+    void update(CustomerId id, std::string_view name, std::string_view email, std::string_view phone,
+                std::string_view adhaar, std::string_view password) {
+        unindexContacts(id);
+        CustomerRecord& record = records[id];
+        record.name = text.add(name);
+        record.email = text.add(email);
+        record.password = text.add(password);
+        record.phone = storeDigits(phone, PHONE_DIGITS);
+        record.adhaar = storeDigits(adhaar, ADHAAR_DIGITS);
+        indexContacts(id);
+    }
+
+    CustomerId find(std::string_view username) const {
+        return byUsername.find(hashOf(username), [this, username](uint32_t id) { return getUsername(id) == username; });
+    }
+
+    CustomerId findByEmail(std::string_view email) const {
+        return byEmail.find(hashOf(email), [this, email](uint32_t id) { return getEmail(id) == email; });
+    }
+
+    CustomerId findByPhone(std::string_view phone) const {
+        uint64_t packed;
+        if (!packDigits(phone, PHONE_DIGITS, packed)) return NO_CUSTOMER;
+        return byPhone.find(packed, [this, packed](uint32_t id) { return records[id].phone == packed; });
+    }
+
+    CustomerId findByAdhaar(std::string_view adhaar) const {
+        uint64_t packed;
+        if (!packDigits(adhaar, ADHAAR_DIGITS, packed)) return NO_CUSTOMER;
+        return byAdhaar.find(packed, [this, packed](uint32_t id) { return records[id].adhaar == packed; });
+    }
+
+    // Views into the arena stay valid until clear()
+    std::string_view getUsername(CustomerId id) const { return text.view(records[id].username); }
+    std::string_view getName(CustomerId id) const { return text.view(records[id].name); }
+    std::string_view getEmail(CustomerId id) const { return text.view(records[id].email); }
+    std::string_view getPassword(CustomerId id) const { return text.view(records[id].password); }
+    std::string getPhone(CustomerId id) const { return formatDigits(records[id].phone, PHONE_DIGITS); }
+    std::string getAdhaar(CustomerId id) const { return formatDigits(records[id].adhaar, ADHAAR_DIGITS); }
+    LoyaltyAccount getAccount(CustomerId id) const { return records[id].account; }
+
+    /**
+     * @brief Bytes held by the records, their text and the indexes.
+     */
+    size_t memoryBytes() const {
+        return records.capacity() * sizeof(CustomerRecord) + text.memoryBytes() + byUsername.memoryBytes() +
+               byEmail.memoryBytes() + byPhone.memoryBytes() + byAdhaar.memoryBytes();
+    }
+};
+
+#endif // CUSTOMER_STORE_H
@@ -0,0 +1,352 @@
+/* ======================================
+   Occupancy Forecast
+   Monte Carlo seasons over the next nights of the booking horizon. Each
+   simulated season starts from the stays already booked, cancels some of
+   those not yet started, then draws new check-ins night by night for every
+   room type and books the ones that still fit. Seasons are independent, so
+   they are spread over a thread pool; every worker folds its seasons into
+   its own occupancy histograms, which are merged into percentile bands per
+   night and room type at the end.
+   ====================================== */
+
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <algorithm>        // For std::min, std::max and nth_element
+#include <cstdint>          // For fixed width integers
+#include <random>           // For the Poisson draws
+#include <vector>           // For using vector container
+#include "calendar.h"       // For the booking horizon
+#include "pricing.h"        // For nightlyRateFor
+#include "room_inventory.h" // For RoomType
+#include "thread_pool.h"    // For WorkStealingPool
+
+constexpr size_t MAX_STAY_NIGHTS = 30;
+
+/**
+ * @struct DemandModel
+ * @brief Demand for one room type in a simulated season.
+ */
+struct DemandModel {
+    double arrivalsPerNight = 0; // Mean requests to check in on a night (Poisson)
+    double cancelRate = 0.1;     // Chance that a stay not yet started is cancelled
+    std::vector<double> stayWeights{30, 25, 18, 12, 8, 4, 3}; // Relative odds of a stay of 1, 2, 3, ... nights
+
+    double meanStay() const {
+        double total = 0, weighted = 0;
+        for (size_t i = 0; i < stayWeights.size(); ++i) {
+            total += stayWeights[i];
+            weighted += stayWeights[i] * static_cast<double>(i + 1);
+        }
+        return total > 0 ? weighted / total : 1.0;
+    }
+
+    /**
+     * @brief Demand that would keep rooms about percentFull percent occupied if nobody were turned away.
+     */
+    static DemandModel forRooms(int32_t rooms, double percentFull = 75) {
+        DemandModel model;
+        model.arrivalsPerNight = percentFull / 100 * rooms / (model.meanStay() * (1 - model.cancelRate));
+        return model;
+    }
+};
+
+/**
+ * @struct ForecastConfig
+ * @brief How far ahead and how many seasons to simulate, and the demand for each room type.
+ */
+struct ForecastConfig {
+    int nights = 90;    // Nights forecast, starting with the first bookable night
+    size_t runs = 10000;
+    uint64_t seed = 1;  // Equal seeds give equal forecasts, whatever the thread count
+    DemandModel demand[ROOM_TYPE_COUNT];
+};
+
+/**
+ * @struct ForecastBand
+ * @brief 10th, 50th and 90th percentile of a value over the simulated seasons.
+ */
+struct ForecastBand {
+    int64_t p10 = 0;
+    int64_t p50 = 0;
+    int64_t p90 = 0;
+};
+
+/**
+ * @struct OccupancyForecast
+ * @brief Percentile bands of occupied rooms and room revenue.
+ *
+ * Revenue is occupied rooms times the nightly rate that occupancy would
+ * set on that night, before loyalty discounts.
+ */
+struct OccupancyForecast {
+    int firstNight = 0;
+    int nights = 0;
+    size_t runs = 0;
+    int32_t roomsOfType[ROOM_TYPE_COUNT] = {};
+    std::vector<ForecastBand> occupancy; // type * nights + night -> rooms occupied
+    std::vector<ForecastBand> revenue;   // type * nights + night -> revenue in INR
+    std::vector<ForecastBand> allRooms;  // night -> rooms occupied over every type
+    ForecastBand seasonRevenue[ROOM_TYPE_COUNT]; // Revenue of all forecast nights, per type
+    ForecastBand totalRevenue;                   // Revenue of all forecast nights and types
+
+    const ForecastBand& occupancyOf(RoomType type, int night) const {
+        return occupancy[static_cast<size_t>(type) * static_cast<size_t>(nights) + static_cast<size_t>(night)];
+    }
+    const ForecastBand& revenueOf(RoomType type, int night) const {
+        return revenue[static_cast<size_t>(type) * static_cast<size_t>(nights) + static_cast<size_t>(night)];
+    }
+};
+
+/**
+ * @class SplitMix64
+ * @brief Small, fast generator; one per simulated season, seeded from the season number.
+ */
+class SplitMix64 {
+    uint64_t state;
+
+public:
+    using result_type = uint64_t;
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+
+    uint64_t operator()() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+};
+
+/**
+ * @class OccupancyForecaster
+ * @brief Simulates seasons for a property's rooms and stays.
+ *
+ * Demand is simulated per room type, not per room: a request fits if the
+ * type has a free room on each of its nights. A cancelled request never
+ * holds a room, so cancellations thin the arrivals of each night (still a
+ * Poisson draw) rather than being drawn one request at a time.
+ */
+class OccupancyForecaster {
+    static constexpr size_t MAX_BINS = 1024; // Histogram buckets per night; larger counts share buckets
+
+    struct Stay {
+        int32_t from; // Nights [from, to) of the window
+        int32_t to;
+    };
+
+    int firstNight;
+    int nights;
+    int32_t roomsOfType[ROOM_TYPE_COUNT] = {};
+    std::vector<int32_t> underWay[ROOM_TYPE_COUNT]; // night -> rooms held by stays that have begun
+    std::vector<Stay> future[ROOM_TYPE_COUNT];      // Stays not yet begun, which may still be cancelled
+
+    // Draws at or below the threshold happen with probability p
+    static uint64_t threshold(double p) {
+        if (p <= 0) return 0;
+        return p >= 1 ? UINT64_MAX : static_cast<uint64_t>(p * 18446744073709551616.0);
+    }
+
+    static uint64_t seasonSeed(uint64_t seed, uint64_t run) {
+        uint64_t z = seed * 0xff51afd7ed558ccdULL + run;
+        z = (z ^ (z >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+        return z ^ (z >> 33);
+    }
+
+    // Value at quantile q of a histogram of count samples, each bucket width wide
+    static int64_t quantile(const uint32_t* histogram, size_t bins, int64_t width, size_t count, double q) {
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(count) + 0.999999));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < bins; ++b) {
+            seen += histogram[b];
+            if (seen >= rank) return static_cast<int64_t>(b) * width;
+        }
+        return static_cast<int64_t>(bins - 1) * width;
+    }
+
+    static ForecastBand bandOf(std::vector<int64_t>& values) {
+        ForecastBand band;
+        if (values.empty()) return band;
+        auto at = [&values](double q) {
+            auto nth = values.begin() + static_cast<std::ptrdiff_t>(q * static_cast<double>(values.size() - 1));
+            std::nth_element(values.begin(), nth, values.end());
+            return *nth;
+        };
+        band.p10 = at(0.10);
+        band.p50 = at(0.50);
+        band.p90 = at(0.90);
+        return band;
+    }
+
+public:
+    /**
+     * @brief Forecast nights [first, first + count), at most the booking horizon.
+     */
+    OccupancyForecaster(int first, int count)
+        : firstNight(first), nights(std::max(1, std::min(count, AvailabilityCalendar::HORIZON_NIGHTS))) {
+        for (auto& held : underWay) held.assign(static_cast<size_t>(nights), 0);
+    }
+
+    void addRoom(RoomType type) { ++roomsOfType[static_cast<size_t>(type)]; }
+
+    /**
+     * @brief Add a booked stay; only its nights inside the window count.
+     */
+    void addStay(RoomType type, int checkIn, int checkOut) {
+        const int from = std::max(checkIn - firstNight, 0);
+        const int to = std::min(checkOut - firstNight, nights);
+        if (from >= to) return;
+        const size_t t = static_cast<size_t>(type);
+        if (checkIn < firstNight) {
+            for (int n = from; n < to; ++n) ++underWay[t][static_cast<size_t>(n)];
+        }
+        else {
+            future[t].push_back({from, to});
+        }
+    }
+
+    /**
+     * @brief Simulate config.runs seasons on the pool's workers and the calling thread.
+     */
+    OccupancyForecast run(const ForecastConfig& config, WorkStealingPool& pool) const {
+        const size_t N = static_cast<size_t>(nights);
+        const size_t runs = std::max<size_t>(1, config.runs);
+
+        // Histogram layout shared by every worker: each type, then all rooms, each N rows of bins
+        int64_t width[ROOM_TYPE_COUNT + 1];
+        size_t bins[ROOM_TYPE_COUNT + 1];
+        size_t offset[ROOM_TYPE_COUNT + 2] = {0};
+        int32_t totalRooms = 0;
+        for (size_t t = 0; t <= ROOM_TYPE_COUNT; ++t) {
+            int32_t rooms = t < ROOM_TYPE_COUNT ? roomsOfType[t] : totalRooms;
+            if (t < ROOM_TYPE_COUNT) totalRooms += rooms;
+            width[t] = static_cast<int64_t>((static_cast<size_t>(rooms) + MAX_BINS) / MAX_BINS);
+            bins[t] = static_cast<size_t>(rooms / width[t]) + 1;
+            offset[t + 1] = offset[t] + bins[t] * N;
+        }
+
+        // Seasons go to workers in equal contiguous slices; each run is seeded by its number alone
+        const size_t slices = std::min(runs, pool.size() + 1);
+        std::vector<std::vector<uint32_t>> histograms(slices);
+        std::vector<int64_t> seasonRevenue[ROOM_TYPE_COUNT];
+        for (auto& values : seasonRevenue) values.assign(runs, 0);
+        std::vector<int64_t> totalRevenue(runs, 0);
+
+        pool.run(slices, [&](size_t slice) {
+            std::vector<uint32_t>& histogram = histograms[slice];
+            histogram.assign(offset[ROOM_TYPE_COUNT + 1], 0);
+            std::vector<int32_t> occupied(N), allOccupied(N);
+
+            std::poisson_distribution<int> arrivals[ROOM_TYPE_COUNT];
+            std::vector<uint64_t> stayCutoffs[ROOM_TYPE_COUNT]; // Draw <= cutoff[i] means a stay of i + 1 nights
+            for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+                const DemandModel& demand = config.demand[t];
+                arrivals[t] = std::poisson_distribution<int>(
+                    std::max(1e-9, demand.arrivalsPerNight * (1 - demand.cancelRate)));
+                double total = 0;
+                for (double weight : demand.stayWeights) total += weight;
+                double sum = 0;
+                for (size_t i = 0; i < demand.stayWeights.size() && i < MAX_STAY_NIGHTS; ++i) {
+                    sum += demand.stayWeights[i];
+                    stayCutoffs[t].push_back(threshold(sum / total));
+                }
+                if (stayCutoffs[t].empty()) stayCutoffs[t].push_back(UINT64_MAX);
+                stayCutoffs[t].back() = UINT64_MAX;
+            }
+
+            for (size_t run = slice * runs / slices; run < (slice + 1) * runs / slices; ++run) {
+                SplitMix64 rng(seasonSeed(config.seed, run));
+                std::fill(allOccupied.begin(), allOccupied.end(), 0);
+                int64_t revenue = 0;
+                for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+                    const int32_t capacity = roomsOfType[t];
+                    const RoomType type = static_cast<RoomType>(t);
+                    std::copy(underWay[t].begin(), underWay[t].end(), occupied.begin());
+
+                    const uint64_t keep = threshold(1 - config.demand[t].cancelRate);
+                    for (const Stay& stay : future[t]) {
+                        if (rng() > keep) continue;
+                        for (int32_t n = stay.from; n < stay.to; ++n) ++occupied[static_cast<size_t>(n)];
+                    }
+
+                    if (capacity > 0 && config.demand[t].arrivalsPerNight > 0) {
+                        const std::vector<uint64_t>& cutoffs = stayCutoffs[t];
+                        for (size_t n = 0; n < N; ++n) {
+                            for (int k = arrivals[t](rng); k > 0; --k) {
+                                if (occupied[n] >= capacity) break; // Every later request of the night is turned away too
+                                const uint64_t draw = rng();
+                                size_t length = 1;
+                                while (draw > cutoffs[length - 1]) ++length;
+                                const size_t end = std::min(N, n + length);
+                                size_t m = n + 1;
+                                while (m < end && occupied[m] < capacity) ++m;
+                                if (m < end) continue;
+                                for (m = n; m < end; ++m) ++occupied[m];
+                            }
+                        }
+                    }
+
+                    int64_t typeRevenue = 0;
+                    uint32_t* rows = &histogram[offset[t]];
+                    for (size_t n = 0; n < N; ++n) {
+                        const int32_t count = occupied[n];
+                        const int32_t binned = std::min(count, capacity);
+                        ++rows[n * bins[t] + static_cast<size_t>(binned / width[t])];
+                        allOccupied[n] += count;
+                        typeRevenue += int64_t(count) * nightlyRateFor(type, count, capacity, firstNight + static_cast<int>(n));
+                    }
+                    seasonRevenue[t][run] = typeRevenue;
+                    revenue += typeRevenue;
+                }
+                uint32_t* rows = &histogram[offset[ROOM_TYPE_COUNT]];
+                for (size_t n = 0; n < N; ++n) {
+                    const int32_t binned = std::min(allOccupied[n], totalRooms);
+                    ++rows[n * bins[ROOM_TYPE_COUNT] + static_cast<size_t>(binned / width[ROOM_TYPE_COUNT])];
+                }
+                totalRevenue[run] = revenue;
+            }
+        });
+
+        std::vector<uint32_t>& merged = histograms[0];
+        for (size_t s = 1; s < slices; ++s) {
+            for (size_t i = 0; i < merged.size(); ++i) merged[i] += histograms[s][i];
+            std::vector<uint32_t>().swap(histograms[s]);
+        }
+
+        OccupancyForecast forecast;
+        forecast.firstNight = firstNight;
+        forecast.nights = nights;
+        forecast.runs = runs;
+        forecast.occupancy.resize(ROOM_TYPE_COUNT * N);
+        forecast.revenue.resize(ROOM_TYPE_COUNT * N);
+        forecast.allRooms.resize(N);
+        for (size_t t = 0; t <= ROOM_TYPE_COUNT; ++t) {
+            if (t < ROOM_TYPE_COUNT) forecast.roomsOfType[t] = roomsOfType[t];
+            for (size_t n = 0; n < N; ++n) {
+                const uint32_t* row = &merged[offset[t] + n * bins[t]];
+                ForecastBand band{quantile(row, bins[t], width[t], runs, 0.10), quantile(row, bins[t], width[t], runs, 0.50),
+                                  quantile(row, bins[t], width[t], runs, 0.90)};
+                if (t == ROOM_TYPE_COUNT) {
+                    forecast.allRooms[n] = band;
+                    continue;
+                }
+                // Revenue grows with occupancy, so its percentiles are those of the occupancy
+                const RoomType type = static_cast<RoomType>(t);
+                const int day = firstNight + static_cast<int>(n);
+                auto revenueAt = [&](int64_t rooms) {
+                    return rooms * nightlyRateFor(type, static_cast<int32_t>(rooms), roomsOfType[t], day);
+                };
+                forecast.occupancy[t * N + n] = band;
+                forecast.revenue[t * N + n] = {revenueAt(band.p10), revenueAt(band.p50), revenueAt(band.p90)};
+            }
+        }
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            forecast.seasonRevenue[t] = bandOf(seasonRevenue[t]);
+        }
+        forecast.totalRevenue = bandOf(totalRevenue);
+        return forecast;
+    }
+};
+
+#endif // FORECAST_H
@@ -0,0 +1,358 @@
+/* ======================================
+   Hotel Behavior Tests
+   Small end-to-end checks of the persistence paths: journal replay after
+   a crash left a torn or corrupted tail or a malformed record, and bulk customer import with
+   duplicate and invalid rows. The availability calendar is checked at
+   its word and horizon edges and against a plain list of stays. Every
+   test works in its own scratch directory. Prints one line per failed check and exits non-zero if any
+   check failed.
+   ====================================== */
+
+#define HOTEL_NO_MAIN
+#include "main.cpp"      // The Hotel under test
+
+#include <cstdlib>       // For mkdtemp
+#include <filesystem>    // For copying and sizing data directories
+#include <random>        // For the calendar cross-check
+#include <unistd.h>      // For chdir, truncate
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+            ++failures;                                                          \
+        }                                                                        \
+    } while (0)
+
+// A new empty directory under the scratch directory, ending in '/'
+static string scratchDir(const string& name) {
+    fs::create_directory(name);
+    return name + "/";
+}
+
+static void writeFile(const string& path, const string& data) {
+    ofstream out(path, ios::binary | ios::trunc);
+    out << data;
+}
+
+static string readFile(const string& path) {
+    ifstream in(path, ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+static vector<string> recoverAll(BookingJournal& journal) {
+    vector<string> records;
+    journal.recover([&records](const string& record) { records.push_back(record); });
+    return records;
+}
+
+static void registerGuest(Hotel& hotel, const string& username, int n) {
+    string digits = to_string(1000 + n);
+    hotel.registerCustomer(username, "pw" + digits, "Guest " + digits, username + "@example.com",
+                           "900000" + digits, "10000000" + digits);
+}
+
+// A record cut off mid-write is dropped and cut from the file, and later records follow the intact ones
+static void testJournalTornTail() {
+    const string dir = scratchDir("torn");
+    const string path = dir + "journal.log";
+    {
+        BookingJournal journal(path);
+        recoverAll(journal);
+        journal.append("A,1");
+        journal.append("A,2");
+        CHECK(journal.commit());
+    }
+    const auto intact = fs::file_size(path);
+    {
+        ofstream out(path, ios::binary | ios::app);
+        out << "A,3|1234"; // No checksum end, no newline
+    }
+    {
+        BookingJournal journal(path);
+        vector<string> records = recoverAll(journal);
+        CHECK((records == vector<string>{"A,1", "A,2"}));
+        CHECK(fs::file_size(path) == intact);
+        journal.append("A,4");
+        CHECK(journal.commit());
+    }
+    BookingJournal journal(path);
+    CHECK((recoverAll(journal) == vector<string>{"A,1", "A,2", "A,4"}));
+}
+
+// A complete last line whose checksum does not match ends the replay just the same
+static void testJournalCorruptedRecord() {
+    const string dir = scratchDir("corrupt");
+    const string path = dir + "journal.log";
+    {
+        BookingJournal journal(path);
+        recoverAll(journal);
+        journal.append("A,1");
+        journal.append("A,2");
+        CHECK(journal.commit());
+    }
+    string data = readFile(path);
+    data[data.find("A,2")] = 'B';
+    writeFile(path, data);
+
+    BookingJournal journal(path);
+    CHECK((recoverAll(journal) == vector<string>{"A,1"}));
+    CHECK(readFile(path) == data.substr(0, data.find("B,2")));
+}
+
+// Fields holding the journal's separators replay unchanged
+static void testJournalFieldEscaping() {
+    string record = "R";
+    vector<string> values{"plain", "a,b", "back\\slash", "two\nlines\r", ""};
+    for (const string& value : values) {
+        appendJournalField(record, value);
+    }
+    vector<string> fields;
+    splitJournalRecord(record, fields);
+    values.insert(values.begin(), "R");
+    CHECK(fields == values);
+}
+
+// A hotel killed mid-append keeps every registration committed before the torn one
+static void testHotelReplayAfterTornTail() {
+    const string live = scratchDir("hotel");
+    const string crashed = scratchDir("hotel-crashed");
+    { Hotel hotel(live); } // Writes the first snapshot
+    {
+        Hotel hotel(live);
+        registerGuest(hotel, "alice", 1);
+        registerGuest(hotel, "bob", 2);
+        // The files as a crash at this point would leave them, minus the end of bob's record
+        fs::copy(live, crashed, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+        const string journalPath = crashed + "journal.log";
+        CHECK(truncate(journalPath.c_str(), static_cast<off_t>(fs::file_size(journalPath) - 5)) == 0);
+    }
+    {
+        Hotel hotel(crashed);
+        CHECK(hotel.findCustomer("alice"));
+        CHECK(!hotel.findCustomer("bob"));
+        registerGuest(hotel, "bob", 2);
+    }
+    Hotel hotel(crashed);
+    CHECK(hotel.findCustomer("alice"));
+    CHECK(hotel.findCustomer("bob"));
+}
+
+// A record with an intact checksum but a field that is not a number is skipped, and replay goes on
+static void testHotelReplaySkipsMalformedRecord() {
+    const string dir = scratchDir("malformed");
+    const string stay = formatDate(todayDayNumber() + 1) + "," + formatDate(todayDayNumber() + 2);
+    { Hotel hotel(dir); } // Writes the first snapshot
+    {
+        BookingJournal journal(dir + "journal.log");
+        recoverAll(journal);
+        journal.append("R,alice,Alice,alice@example.com,9000001001,100000001001,pw");
+        journal.append("B,101,alice,300,lots," + stay + ",3000");
+        journal.append("B,x,alice,300,300," + stay + ",3000");
+        journal.append("B,102,alice,500,500," + stay + ",5000");
+        CHECK(journal.commit());
+    }
+    Hotel hotel(dir);
+    vector<pair<int, Booking>> stays = hotel.getCustomerBookings("alice");
+    CHECK(stays.size() == 1 && stays[0].first == 102);
+    CHECK(hotel.findCustomer("alice").getLoyaltyPoints() == 500);
+}
+
+// Import accepts rows in file order and rejects any row reusing a key already taken
+static void testImportDedup() {
+    const string dir = scratchDir("import");
+    const string csv = dir + "customers.csv";
+    const string rejects = dir + "rejects.csv";
+    writeFile(csv,
+        "carol,Carol,carol@example.com,9000000001,100000000001,pw1\n"
+        "dave,Dave,dave@example.com,9000000002,100000000002,pw2\n"
+        "dave,Dave Two,dave2@example.com,9000000003,100000000003,pw3\n"
+        "erin,Erin,dave@example.com,9000000004,100000000004,pw4\n"
+        "frank,Frank,frank@example,9000000005,100000000005,pw5\n"
+        "grace,Grace,grace@example.com,9000000099,100000000006,pw6\n"
+        "heidi,Heidi,heidi@example.com,9000000007,100000000007,pw7\n");
+    {
+        Hotel hotel(dir);
+        hotel.registerCustomer("ivan", "pw0", "Ivan", "ivan@example.com", "9000000099", "100000000099");
+        ImportResult result = hotel.importCustomers(csv, rejects);
+        CHECK(result.rows == 7);
+        CHECK(result.imported == 3);
+        CHECK(result.rejected == 4);
+        CHECK(hotel.findCustomer("dave").getEmail() == "dave@example.com");
+        CHECK(!hotel.findCustomer("erin"));
+        CHECK(!hotel.findCustomer("grace"));
+    }
+    string rejected = readFile(rejects);
+    CHECK(rejected.find("3,duplicate username (first on line 2),") != string::npos);
+    CHECK(rejected.find("4,duplicate email (first on line 2),") != string::npos);
+    CHECK(rejected.find("5,invalid email,") != string::npos);
+    CHECK(rejected.find("6,phone number already registered,") != string::npos);
+
+    // The import's checkpoint keeps it across a restart
+    Hotel hotel(dir);
+    CHECK(hotel.findCustomer("carol"));
+    CHECK(hotel.findCustomer("heidi"));
+    CHECK(hotel.findCustomer("ivan"));
+}
+
+// An inventory of count Standard rooms, 50 to a floor, so room ids cross several 64-bit words
+static RoomInventory standardRooms(int count) {
+    vector<pair<int, RoomType>> list;
+    for (int i = 0; i < count; ++i) {
+        list.emplace_back((i / 50 + 1) * RoomInventory::FLOOR_STRIDE + i % 50 + 1, RoomType::STANDARD);
+    }
+    RoomInventory rooms;
+    rooms.assign(list);
+    return rooms;
+}
+
+static vector<RoomId> freeRooms(const AvailabilityCalendar& calendar, int checkIn, int checkOut) {
+    return calendar.freeRoomsOfType(RoomType::STANDARD, checkIn, checkOut);
+}
+
+// Stays that meet or cross a 64-night word, and rooms on either side of a 64-room word
+static void testCalendarWordEdges() {
+    const int first = daysFromCivil(2030, 1, 1);
+    RoomInventory rooms = standardRooms(130);
+    AvailabilityCalendar calendar;
+    calendar.reset(first, rooms);
+
+    CHECK(calendar.book(0, first + 63, first + 65)); // Last night of word 0, first of word 1
+    CHECK(!calendar.book(0, first + 64, first + 66));
+    CHECK(calendar.isFree(0, first + 62, first + 63));
+    CHECK(!calendar.isFree(0, first + 63, first + 64));
+    CHECK(!calendar.isFree(0, first + 64, first + 65));
+    CHECK(calendar.isFree(0, first + 65, first + 130));
+    CHECK(!calendar.isFree(0, first, first + 128));
+
+    CHECK(calendar.book(63, first + 128, first + 129));
+    CHECK(calendar.book(64, first + 127, first + 129));
+    CHECK(calendar.book(127, first + 128, first + 192));
+    CHECK(calendar.book(128, first + 191, first + 192));
+    vector<RoomId> free = freeRooms(calendar, first + 128, first + 129);
+    CHECK(free.size() == 127);
+    for (RoomId id : {63, 64, 127}) {
+        CHECK(find(free.begin(), free.end(), id) == free.end());
+    }
+    for (RoomId id : {0, 62, 65, 126, 128, 129}) {
+        CHECK(find(free.begin(), free.end(), id) != free.end());
+    }
+    free = freeRooms(calendar, first + 191, first + 192);
+    CHECK(free.size() == 128 && free.front() == 0 && free.back() == 129);
+
+    // Stopping early visits the rooms in id order up to the stop
+    vector<RoomId> visited;
+    CHECK(!calendar.forEachFreeRoomWhile(RoomType::STANDARD, first + 63, first + 64,
+                                         [&visited](RoomId id) { visited.push_back(id); return visited.size() < 2; }));
+    CHECK((visited == vector<RoomId>{1, 2}));
+}
+
+// Nights outside the horizon are never booked and never conflict
+static void testCalendarHorizonEdges() {
+    const int first = daysFromCivil(2030, 1, 1);
+    const int end = first + AvailabilityCalendar::HORIZON_NIGHTS; // First night past the horizon
+    RoomInventory rooms = standardRooms(3);
+    AvailabilityCalendar calendar;
+    calendar.reset(first, rooms);
+
+    CHECK(calendar.inHorizon(first, end));
+    CHECK(!calendar.inHorizon(first - 1, first + 1));
+    CHECK(!calendar.inHorizon(end - 1, end + 1));
+    CHECK(!calendar.inHorizon(first + 2, first + 2));
+
+    // A stay already under way keeps only its nights from the first one on
+    CHECK(calendar.book(0, first - 5, first + 2));
+    CHECK(!calendar.isFree(0, first, first + 1));
+    CHECK(!calendar.isFree(0, first + 1, first + 2));
+    CHECK(calendar.isFree(0, first + 2, first + 3));
+    CHECK(calendar.isFree(0, first - 10, first));
+    CHECK(calendar.book(0, first - 10, first));
+
+    // A stay running past the horizon keeps its nights up to the last one
+    CHECK(calendar.book(1, end - 2, end + 30));
+    CHECK(!calendar.isFree(1, end - 1, end));
+    CHECK(calendar.isFree(1, end, end + 30));
+    CHECK(calendar.book(1, end, end + 5));
+    CHECK((freeRooms(calendar, end - 1, end) == vector<RoomId>{0, 2}));
+
+    // Releasing clamps the same way, and frees exactly what booking took
+    calendar.release(0, first - 5, first + 2);
+    CHECK(calendar.isFree(0, first, first + 3));
+    calendar.release(1, end - 2, end + 30);
+    CHECK((freeRooms(calendar, end - 1, end) == vector<RoomId>{0, 1, 2}));
+}
+
+// Random bookings, releases and rebookings agree with a plain list of stays per room
+static void testCalendarAgainstStays() {
+    const int first = daysFromCivil(2030, 1, 1);
+    const int nights = AvailabilityCalendar::HORIZON_NIGHTS;
+    RoomInventory rooms = standardRooms(150);
+    AvailabilityCalendar calendar;
+    calendar.reset(first, rooms);
+    vector<vector<pair<int, int>>> stays(rooms.size());
+    auto overlaps = [&stays](RoomId id, int checkIn, int checkOut) {
+        for (const auto& [in, out] : stays[id]) {
+            if (in < checkOut && checkIn < out) return true;
+        }
+        return false;
+    };
+
+    mt19937 rng(7);
+    int mismatches = 0;
+    for (int step = 0; step < 20000; ++step) {
+        RoomId id = static_cast<RoomId>(rng() % rooms.size());
+        int checkIn = first + static_cast<int>(rng() % nights);
+        int checkOut = min(checkIn + 1 + static_cast<int>(rng() % 130), first + nights);
+        vector<pair<int, int>>& own = stays[id];
+        if (!own.empty() && rng() % 3 == 0) {
+            size_t pick = rng() % own.size();
+            calendar.release(id, own[pick].first, own[pick].second);
+            own.erase(own.begin() + static_cast<ptrdiff_t>(pick));
+        }
+        else if (calendar.book(id, checkIn, checkOut) == overlaps(id, checkIn, checkOut)) {
+            ++mismatches;
+        }
+        else if (!overlaps(id, checkIn, checkOut)) {
+            own.emplace_back(checkIn, checkOut);
+        }
+
+        if (step % 100 == 0) {
+            vector<RoomId> expected;
+            for (RoomId r = 0; r < static_cast<RoomId>(rooms.size()); ++r) {
+                if (!overlaps(r, checkIn, checkOut)) expected.push_back(r);
+            }
+            if (freeRooms(calendar, checkIn, checkOut) != expected) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+int main() {
+    char pattern[] = "/tmp/hotel-tests-XXXXXX";
+    if (!mkdtemp(pattern) || chdir(pattern) != 0) {
+        cerr << "Error creating a scratch directory.\n";
+        return 1;
+    }
+    try {
+        testJournalTornTail();
+        testJournalCorruptedRecord();
+        testJournalFieldEscaping();
+        testHotelReplayAfterTornTail();
+        testHotelReplaySkipsMalformedRecord();
+        testImportDedup();
+        testCalendarWordEdges();
+        testCalendarHorizonEdges();
+        testCalendarAgainstStays();
+    }
+    catch (const exception& e) {
+        cerr << "Unexpected exception: " << e.what() << "\n";
+        ++failures;
+    }
+    if (chdir("/") == 0) fs::remove_all(pattern);
+    cerr << (failures == 0 ? "All tests passed.\n" : to_string(failures) + " checks failed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+/* ======================================
+   Booking Journal
+   Append-only write-ahead log used by Hotel so that a single booking,
+   cancellation, checkout or registration costs one appended line instead
+   of rewriting customers.txt, rooms.txt and bookings.txt.
+   ====================================== */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <array>              // For the checksum table
+#include <condition_variable> // For waking threads waiting on a group commit
+#include <cstdint>            // For fixed width integers
+#include <cstdio>             // For std::rename, snprintf
+#include <cstdlib>            // For strtoul
+#include <cstring>            // For memcpy
+#include <iostream>           // For error messages
+#include <mutex>              // For guarding the pending buffer
+#include <string>             // For using string class
+#include <string_view>        // For record fields
+#include <vector>             // For the fields of a record
+#include <fcntl.h>            // For open
+#include <unistd.h>           // For write, fsync, ftruncate
+
+/**
+ * @brief CRC-32 (IEEE) checksum used to detect torn or corrupted records.
+ *
+ * Processes eight bytes per step (slicing-by-8) so that large snapshots can
+ * be verified quickly. Checksums chain: crc32(b, nb, crc32(a, na)) equals the
+ * checksum of a followed by b.
+ * @param data Bytes to checksum.
+ * @param len Number of bytes.
+ * @param previous Checksum of the preceding bytes, 0 to start.
+ * @return Checksum value.
+ */
+inline uint32_t crc32(const char* data, size_t len, uint32_t previous = 0) {
+    static const std::array<std::array<uint32_t, 256>, 8> tables = [] {
+        std::array<std::array<uint32_t, 256>, 8> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+            for (size_t s = 1; s < 8; ++s)
+                t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+        return t;
+    }();
+    uint32_t crc = ~previous;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (len >= 8) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, p, 4);
+        std::memcpy(&hi, p + 4, 4);
+        lo ^= crc;
+        crc = tables[7][lo & 0xFF] ^ tables[6][(lo >> 8) & 0xFF] ^ tables[5][(lo >> 16) & 0xFF] ^ tables[4][lo >> 24] ^
+              tables[3][hi & 0xFF] ^ tables[2][(hi >> 8) & 0xFF] ^ tables[1][(hi >> 16) & 0xFF] ^ tables[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+#endif
+    for (size_t i = 0; i < len; ++i)
+        crc = tables[0][(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/**
+ * @brief Flush a file's data to stable storage.
+ * @param fd Open file descriptor.
+ * @return False if the data may not have reached the disk.
+ */
+inline bool syncFileData(int fd) {
+#if defined(__APPLE__)
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0;
+#endif
+}
+
+/**
+ * @brief Sync the directory holding a file, making a rename or creation inside it durable.
+ * @param path File whose directory to sync.
+ * @return False if the directory could not be synced.
+ */
+inline bool syncParentDirectory(const std::string& path) {
+    const size_t slash = path.rfind('/');
+    const std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        std::cout << "Error opening " << dir << " for syncing.\n";
+        return false;
+    }
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced) std::cout << "Error syncing " << dir << ".\n";
+    return synced;
+}
+
+/**
+ * @brief Durably replace a file with a freshly written temporary file.
+ *
+ * The data is synced before the rename and the directory after it, so once
+ * this returns true a crash leaves the new contents under path.
+ * @param tmpPath Fully written temporary file.
+ * @param path Destination file name.
+ * @return True if the destination now holds the new contents.
+ */
+inline bool durableReplace(const std::string& tmpPath, const std::string& path) {
+    int fd = ::open(tmpPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "Error opening " << tmpPath << " for syncing.\n";
+        return false;
+    }
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced) {
+        std::cout << "Error syncing " << tmpPath << ".\n";
+        return false;
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cout << "Error replacing " << path << ".\n";
+        return false;
+    }
+    return syncParentDirectory(path);
+}
+
+/**
+ * @brief Append a comma-separated field to a journal record.
+ *
+ * Commas, backslashes and line breaks in free text (a name, a password) are
+ * escaped with a backslash so the field survives splitJournalRecord intact.
+ * @param record Record to extend; a comma is added first unless it is empty.
+ * @param field Field text.
+ */
+inline void appendJournalField(std::string& record, std::string_view field) {
+    if (!record.empty()) record += ',';
+    for (char c : field) {
+        if (c == ',' || c == '\\') {
+            record += '\\';
+            record += c;
+        }
+        else if (c == '\n') {
+            record += "\\n";
+        }
+        else if (c == '\r') {
+            record += "\\r";
+        }
+        else {
+            record += c;
+        }
+    }
+}
+
+/**
+ * @brief Split a journal record at its unescaped commas, undoing appendJournalField.
+ * @param record Record payload.
+ * @param fields Receives the fields.
+ */
+inline void splitJournalRecord(std::string_view record, std::vector<std::string>& fields) {
+    fields.clear();
+    fields.emplace_back();
+    for (size_t i = 0; i < record.size(); ++i) {
+        char c = record[i];
+        if (c == ',') {
+            fields.emplace_back();
+        }
+        else if (c == '\\' && i + 1 < record.size()) {
+            char next = record[++i];
+            fields.back() += next == 'n' ? '\n' : next == 'r' ? '\r' : next;
+        }
+        else {
+            fields.back() += c;
+        }
+    }
+}
+
+/**
+ * @class BookingJournal
+ * @brief Write-ahead journal with group commit.
+ *
+ * Every record is one line of the form "payload|crc32". Records describe the
+ * resulting state (for example a customer's new points total) rather than a
+ * bare delta, so replaying a record that already reached a checkpoint is
+ * harmless. Concurrent callers of commit() are batched: one thread writes and
+ * syncs everything appended so far while the others wait for it.
+ *
+ * A record whose payload starts with '#' is a header describing the journal
+ * itself rather than a change: reset() can start the new journal with
+ * headers, and recover() replays them without counting them as changes.
+ */
+class BookingJournal {
+    std::string path;
+    int fd = -1;
+    std::mutex mtx;
+    std::condition_variable flushed;
+    std::string pending;       // Appended but not yet written
+    uint64_t appendedLsn = 0;  // Sequence number of the last appended record
+    uint64_t durableLsn = 0;   // Sequence number of the last synced record
+    uint64_t failedLsn = 0;    // Sequence number of the last record a failed batch held
+    bool flushing = false;     // True while a leader is writing a batch
+    size_t sinceCheckpoint = 0;
+    off_t fileBytes = 0;       // Length of the journal up to the last synced record
+
+    void openForAppend() {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            std::cout << "Error opening " << path << " for writing.\n";
+            return;
+        }
+        fileBytes = ::lseek(fd, 0, SEEK_END);
+    }
+
+    static void frame(std::string& out, const std::string& payload) {
+        char crc[9];
+        std::snprintf(crc, sizeof(crc), "%08x", crc32(payload.data(), payload.size()));
+        out += payload;
+        out += '|';
+        out.append(crc, 8);
+        out += '\n';
+    }
+
+    bool writeAll(const std::string& batch) {
+        const char* p = batch.data();
+        size_t left = batch.size();
+        while (left > 0) {
+            ssize_t n = ::write(fd, p, left);
+            if (n < 0) {
+                std::cout << "Error writing to " << path << ".\n";
+                return false;
+            }
+            p += n;
+            left -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @brief Constructor for BookingJournal. The file is opened by recover().
+     * @param file Journal file name.
+     */
+    explicit BookingJournal(const std::string& file) : path(file) {}
+
+    ~BookingJournal() {
+        commit();
+        if (fd >= 0) ::close(fd);
+    }
+
+    BookingJournal(const BookingJournal&) = delete;
+    BookingJournal& operator=(const BookingJournal&) = delete;
+
+    /**
+     * @brief Replay every intact record and open the journal for appending.
+     *
+     * A torn or corrupted tail (for example from a crash mid-write) ends the
+     * replay and is cut off so new records are not appended after garbage.
+     * @param apply Callback invoked with each record payload in order.
+     * @return Number of records replayed, not counting headers.
+     */
+    template<typename Apply>
+    size_t recover(Apply apply) {
+        std::string data;
+        int in = ::open(path.c_str(), O_RDONLY);
+        if (in >= 0) {
+            char buf[1 << 16];
+            ssize_t n;
+            while ((n = ::read(in, buf, sizeof(buf))) > 0)
+                data.append(buf, static_cast<size_t>(n));
+            ::close(in);
+        }
+
+        size_t pos = 0, replayed = 0;
+        while (pos < data.size()) {
+            size_t end = data.find('\n', pos);
+            if (end == std::string::npos) break;
+            size_t bar = data.rfind('|', end);
+            if (bar == std::string::npos || bar < pos || end - bar != 9) break;
+            std::string hex = data.substr(bar + 1, 8);
+            char* hexEnd = nullptr;
+            unsigned long stored = std::strtoul(hex.c_str(), &hexEnd, 16);
+            if (hexEnd != hex.c_str() + 8 || stored != crc32(data.data() + pos, bar - pos)) break;
+            apply(data.substr(pos, bar - pos));
+            if (data[pos] != '#') ++replayed;
+            pos = end + 1;
+        }
+        if (pos < data.size()) {
+            std::cout << "Warning: discarding " << (data.size() - pos)
+                      << " bytes of incomplete journal tail.\n";
+            if (::truncate(path.c_str(), static_cast<off_t>(pos)) != 0) {
+                std::cout << "Error truncating " << path << ".\n";
+            }
+        }
+
+        openForAppend();
+        sinceCheckpoint = replayed;
+        return replayed;
+    }
+
+    /**
+     * @brief Buffer one record. It is not durable until commit() covers it.
+     * @param payload Record contents (must not contain a newline).
+     * @return Sequence number to pass to commit().
+     */
+    uint64_t append(const std::string& payload) {
+        std::lock_guard<std::mutex> lock(mtx);
+        frame(pending, payload);
+        ++sinceCheckpoint;
+        return ++appendedLsn;
+    }
+
+    /**
+     * @brief Block until the record with the given sequence number is synced.
+     *
+     * The first waiter becomes the leader and writes every pending record with
+     * a single sync; records appended meanwhile are picked up by the next one.
+     * If the write or the sync fails, the journal is cut back to its last
+     * synced record and the batch stays pending, to be written by a later
+     * commit; every caller waiting on it is told it failed.
+     * @param lsn Sequence number returned by append().
+     * @return False if the record could not be made durable.
+     */
+    bool commit(uint64_t lsn) {
+        std::unique_lock<std::mutex> lock(mtx);
+        const uint64_t failedBefore = failedLsn;
+        while (durableLsn < lsn) {
+            if (failedLsn != failedBefore && failedLsn >= lsn) return false;
+            if (flushing) {
+                flushed.wait(lock);
+                continue;
+            }
+            flushing = true;
+            std::string batch;
+            batch.swap(pending);
+            uint64_t batchLsn = appendedLsn;
+            lock.unlock();
+
+            const bool written = fd >= 0 && writeAll(batch);
+            const bool synced = written && syncFileData(fd);
+            if (written && !synced) {
+                std::cout << "Error syncing " << path << ".\n";
+            }
+            if (!synced && fd >= 0 && ::ftruncate(fd, fileBytes) != 0) {
+                std::cout << "Error truncating " << path << ".\n";
+            }
+
+            lock.lock();
+            flushing = false;
+            if (synced) {
+                fileBytes += static_cast<off_t>(batch.size());
+                durableLsn = batchLsn;
+            }
+            else {
+                pending.insert(0, batch);
+                failedLsn = batchLsn;
+            }
+            flushed.notify_all();
+            if (!synced) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Sync everything appended so far.
+     * @return False if some record could not be made durable.
+     */
+    bool commit() {
+        uint64_t lsn;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            lsn = appendedLsn;
+        }
+        return commit(lsn);
+    }
+
+    /**
+     * @brief Sequence number of the last record appended so far, to pass to commit().
+     */
+    uint64_t lastLsn() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return appendedLsn;
+    }
+
+    /**
+     * @brief Number of records written since the last checkpoint.
+     */
+    size_t recordsSinceCheckpoint() const { return sinceCheckpoint; }
+
+    /**
+     * @brief Empty the journal once a checkpoint has captured its records.
+     *
+     * With headers, the emptied journal starts with them; it is written aside
+     * and renamed into place, so a crash leaves either the old records or the
+     * headers, never an empty journal without them.
+     * @param headers Payloads starting with '#'.
+     * @return False if the headers could not be written; the old records are then kept.
+     */
+    bool reset(const std::vector<std::string>& headers = {}) {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (flushing) flushed.wait(lock);
+        // The checkpoint holds every change so far, including records that were never written
+        pending.clear();
+        durableLsn = appendedLsn;
+        flushed.notify_all();
+        sinceCheckpoint = 0;
+        if (headers.empty()) {
+            if (fd >= 0 && ::ftruncate(fd, 0) != 0) {
+                std::cout << "Error truncating " << path << ".\n";
+            }
+            fileBytes = 0;
+            return true;
+        }
+
+        std::string data;
+        for (const std::string& header : headers) {
+            frame(data, header);
+        }
+        const std::string tmpPath = path + ".tmp";
+        int out = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool written = out >= 0;
+        for (size_t done = 0; written && done < data.size();) {
+            ssize_t n = ::write(out, data.data() + done, data.size() - done);
+            written = n > 0;
+            if (written) done += static_cast<size_t>(n);
+        }
+        if (out >= 0 && ::close(out) != 0) written = false;
+        if (!written || !durableReplace(tmpPath, path)) {
+            std::cout << "Error writing " << tmpPath << "; " << path << " keeps its old records.\n";
+            return false;
+        }
+        if (fd >= 0) ::close(fd);
+        openForAppend();
+        return true;
+    }
+};
+
+#endif // JOURNAL_H
@@ -0,0 +1,216 @@
+/* ======================================
+   JSON Lines
+   Minimal reader and writer for the flat one-object-per-line JSON used by
+   batch mode: string, number, boolean and null values, no nesting.
+   ====================================== */
+
+#ifndef JSON_LINES_H
+#define JSON_LINES_H
+
+#include <charconv>    // For from_chars
+#include <cstdio>      // For snprintf
+#include <cstdlib>     // For strtod
+#include <deque>       // For stable storage of unescaped strings
+#include <string>      // For using string class
+#include <string_view> // For views into the input line
+#include <utility>     // For std::pair
+#include <vector>      // For using vector container
+
+/**
+ * @class JsonLine
+ * @brief Parsed view of one flat JSON object.
+ *
+ * Keys and values point into the parsed line, so the line must outlive the
+ * object. Strings containing escapes are decoded into internal storage. A
+ * JsonLine is meant to be reused for every line to avoid reallocating.
+ */
+class JsonLine {
+    std::vector<std::pair<std::string_view, std::string_view>> fields;
+    std::deque<std::string> decoded; // Unescaped copies of strings with backslashes
+
+    static void skipSpace(std::string_view s, size_t& i) {
+        while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) ++i;
+    }
+
+    // Read a quoted string starting at s[i] == '"'
+    bool readString(std::string_view s, size_t& i, std::string_view& out) {
+        size_t start = ++i;
+        bool escaped = false;
+        while (i < s.size() && s[i] != '"') {
+            if (s[i] == '\\') {
+                escaped = true;
+                ++i;
+            }
+            ++i;
+        }
+        if (i >= s.size()) return false;
+        out = s.substr(start, i - start);
+        ++i;
+        if (escaped) {
+            std::string text;
+            for (size_t k = 0; k < out.size(); ++k) {
+                char c = out[k];
+                if (c != '\\' || k + 1 == out.size()) {
+                    text += c;
+                    continue;
+                }
+                switch (out[++k]) {
+                    case 'n': text += '\n'; break;
+                    case 't': text += '\t'; break;
+                    case 'r': text += '\r'; break;
+                    case 'b': text += '\b'; break;
+                    case 'f': text += '\f'; break;
+                    case 'u': {
+                        unsigned code = 0;
+                        if (k + 4 < out.size()) {
+                            std::from_chars(out.data() + k + 1, out.data() + k + 5, code, 16);
+                            k += 4;
+                        }
+                        // Only the ASCII range matters for our fields
+                        text += code < 0x80 ? static_cast<char>(code) : '?';
+                        break;
+                    }
+                    default: text += out[k];
+                }
+            }
+            decoded.push_back(std::move(text));
+            out = decoded.back();
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @brief Parse a line holding one flat JSON object.
+     * @return False if the line is not a well-formed flat object.
+     */
+    bool parse(std::string_view line) {
+        fields.clear();
+        decoded.clear();
+        size_t i = 0;
+        skipSpace(line, i);
+        if (i >= line.size() || line[i] != '{') return false;
+        ++i;
+        skipSpace(line, i);
+        if (i < line.size() && line[i] == '}') return true;
+
+        while (i < line.size()) {
+            skipSpace(line, i);
+            std::string_view key, value;
+            if (i >= line.size() || line[i] != '"' || !readString(line, i, key)) return false;
+            skipSpace(line, i);
+            if (i >= line.size() || line[i] != ':') return false;
+            ++i;
+            skipSpace(line, i);
+            if (i >= line.size()) return false;
+            if (line[i] == '"') {
+                if (!readString(line, i, value)) return false;
+            }
+            else {
+                size_t start = i;
+                while (i < line.size() && line[i] != ',' && line[i] != '}' &&
+                       line[i] != ' ' && line[i] != '\t') ++i;
+                value = line.substr(start, i - start);
+                if (value.empty() || value == "null") value = std::string_view();
+            }
+            fields.emplace_back(key, value);
+            skipSpace(line, i);
+            if (i < line.size() && line[i] == ',') {
+                ++i;
+                continue;
+            }
+            if (i < line.size() && line[i] == '}') return true;
+            return false;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Value of a field, or an empty view if it is absent or null.
+     */
+    std::string_view get(std::string_view key) const {
+        for (const auto& [k, v] : fields) {
+            if (k == key) return v;
+        }
+        return std::string_view();
+    }
+
+    bool has(std::string_view key) const {
+        for (const auto& field : fields) {
+            if (field.first == key) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Read an integer field.
+     * @return False if the field is absent or not an integer.
+     */
+    bool getInt(std::string_view key, int& out) const {
+        std::string_view v = get(key);
+        if (v.empty()) return false;
+        auto [end, ec] = std::from_chars(v.data(), v.data() + v.size(), out);
+        return ec == std::errc() && end == v.data() + v.size();
+    }
+
+    /**
+     * @brief Read a numeric field.
+     * @return False if the field is absent or not a number.
+     */
+    bool getDouble(std::string_view key, double& out) const {
+        std::string_view v = get(key);
+        if (v.empty()) return false;
+        std::string text(v); // strtod needs a terminated string
+        char* end = nullptr;
+        out = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size();
+    }
+};
+
+/**
+ * @brief Append a JSON string literal (with quotes) to a buffer.
+ */
+inline void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    out += buf;
+                }
+                else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief Append ,"key":"value" (or {"key":"value" for the first field).
+ */
+inline void appendJsonField(std::string& out, std::string_view key, std::string_view value) {
+    out += out.empty() || out.back() == '{' ? "" : ",";
+    appendJsonString(out, key);
+    out += ':';
+    appendJsonString(out, value);
+}
+
+/**
+ * @brief Append ,"key":<raw> where raw is already valid JSON (number, bool, array).
+ */
+inline void appendJsonRaw(std::string& out, std::string_view key, std::string_view raw) {
+    out += out.empty() || out.back() == '{' ? "" : ",";
+    appendJsonString(out, key);
+    out += ':';
+    out += raw;
+}
+
+#endif // JSON_LINES_H
@@ -0,0 +1,381 @@
+/* ======================================
+   Line Server
+   Single-threaded epoll event loop that accepts TCP or Unix-domain
+   connections, splits their input into newline-terminated requests and
+   hands each connection's pending requests to a worker pool. Replies are
+   written back by the loop in request order.
+   ====================================== */
+
+#ifndef LINE_SERVER_H
+#define LINE_SERVER_H
+
+#include <csignal>          // For blocking SIGINT and SIGTERM
+#include <cstdint>          // For fixed width integers
+#include <cstdlib>          // For atoi
+#include <cstring>          // For strerror
+#include <functional>       // For std::function
+#include <iostream>         // For status and error messages
+#include <memory>           // For unique_ptr
+#include <mutex>            // For the completion queue
+#include <string>           // For using string class
+#include <unordered_map>    // For the connection table
+#include <utility>          // For std::move
+#include <vector>           // For using vector container
+#include <arpa/inet.h>      // For inet_pton
+#include <netinet/in.h>     // For sockaddr_in
+#include <netinet/tcp.h>    // For TCP_NODELAY
+#include <sys/epoll.h>      // For the event loop
+#include <sys/eventfd.h>    // For waking the loop from workers
+#include <sys/signalfd.h>   // For shutting down on signals
+#include <sys/socket.h>     // For socket, bind, listen, accept4
+#include <sys/un.h>         // For sockaddr_un
+#include <unistd.h>         // For read, write, close
+#include "thread_pool.h"    // For the worker pool
+
+/**
+ * @class LineSession
+ * @brief Per-connection request handler used by LineServer.
+ *
+ * A session is only ever called by one worker at a time, so it may keep
+ * per-connection state (such as the logged-in user) without locking.
+ */
+class LineSession {
+public:
+    virtual ~LineSession() = default;
+
+    /**
+     * @brief Handle one or more requests.
+     * @param lines Complete requests, each terminated by '\n'.
+     * @param out Receives the replies, one line per request.
+     */
+    virtual void process(const std::string& lines, std::string& out) = 0;
+};
+
+/**
+ * @class LineServer
+ * @brief Newline-delimited request/reply server on an epoll loop.
+ *
+ * The loop thread only does socket I/O. While a connection's batch of
+ * requests is being processed by a worker, further input is buffered, and
+ * it is dispatched as the next batch once the replies come back. Each
+ * connection therefore sees its replies in order, while different
+ * connections are served in parallel. SIGINT or SIGTERM stops the server
+ * after in-flight batches have finished.
+ */
+class LineServer {
+public:
+    using SessionFactory = std::function<std::unique_ptr<LineSession>()>;
+
+    static constexpr size_t MAX_LINE = 64 * 1024;          // Longest accepted request
+    static constexpr size_t MAX_PENDING_INPUT = 1 << 20;   // Stop reading a connection beyond this
+
+private:
+    struct Connection {
+        int fd;
+        std::unique_ptr<LineSession> session;
+        std::string input;     // Received but not yet dispatched
+        std::string output;    // Replies not yet written
+        uint32_t events = 0;   // Events currently registered with epoll
+        bool busy = false;     // A worker owns the session
+        bool peerClosed = false;
+    };
+
+    struct Completion {
+        Connection* conn;
+        std::string replies;
+    };
+
+    std::string address;
+    SessionFactory makeSession;
+    size_t workerCount;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    int signalFd = -1;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::mutex completionMtx;
+    std::vector<Completion> completions;
+    std::unique_ptr<ThreadPool> pool;
+    uint64_t acceptedCount = 0;
+
+    bool fail(const std::string& what) {
+        std::cerr << "Error: " << what << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    bool watch(int fd, uint32_t events, int op) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        return ::epoll_ctl(epollFd, op, fd, &ev) == 0;
+    }
+
+    // Listen on "unix:<path>" or "[host]:<port>"
+    bool openListener() {
+        if (address.rfind("unix:", 0) == 0) {
+            std::string path = address.substr(5);
+            sockaddr_un addr{};
+            if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+                std::cerr << "Error: invalid Unix socket path '" << path << "'.\n";
+                return false;
+            }
+            addr.sun_family = AF_UNIX;
+            path.copy(addr.sun_path, path.size());
+            ::unlink(path.c_str());
+            listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listenFd < 0) return fail("socket");
+            if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return fail("bind " + path);
+        }
+        else {
+            size_t colon = address.rfind(':');
+            std::string host = colon == std::string::npos ? "" : address.substr(0, colon);
+            std::string port = colon == std::string::npos ? address : address.substr(colon + 1);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<uint16_t>(std::atoi(port.c_str())));
+            if (host.empty() || host == "*") {
+                addr.sin_addr.s_addr = htonl(INADDR_ANY);
+            }
+            else if (host == "localhost") {
+                addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            }
+            else if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+                std::cerr << "Error: invalid listen address '" << address << "'.\n";
+                return false;
+            }
+            listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listenFd < 0) return fail("socket");
+            int one = 1;
+            ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return fail("bind " + address);
+        }
+        if (::listen(listenFd, SOMAXCONN) != 0) return fail("listen");
+        return true;
+    }
+
+    void acceptConnections() {
+        while (true) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    fail("accept");
+                }
+                return;
+            }
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // Harmless failure on Unix sockets
+            auto conn = std::make_unique<Connection>();
+            conn->fd = fd;
+            conn->session = makeSession();
+            conn->events = EPOLLIN | EPOLLRDHUP;
+            if (!watch(fd, conn->events, EPOLL_CTL_ADD)) {
+                fail("epoll_ctl");
+                ::close(fd);
+                continue;
+            }
+            connections.emplace(fd, std::move(conn));
+            ++acceptedCount;
+        }
+    }
+
+    void closeConnection(Connection* conn) {
+        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, nullptr);
+        ::close(conn->fd);
+        connections.erase(conn->fd);
+    }
+
+    // Register interest in reading while there is room to buffer, and in writing while replies are pending
+    void updateInterest(Connection* conn) {
+        uint32_t events = 0;
+        if (!conn->peerClosed) events |= EPOLLRDHUP;
+        if (!conn->peerClosed && conn->input.size() < MAX_PENDING_INPUT) events |= EPOLLIN;
+        if (!conn->output.empty()) events |= EPOLLOUT;
+        if (events != conn->events) {
+            conn->events = events;
+            watch(conn->fd, events, EPOLL_CTL_MOD);
+        }
+    }
+
+    // Write as much pending output as the socket takes; false if the connection broke
+    bool flush(Connection* conn) {
+        size_t sent = 0;
+        while (sent < conn->output.size()) {
+            ssize_t n = ::send(conn->fd, conn->output.data() + sent, conn->output.size() - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                conn->output.clear();
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        conn->output.erase(0, sent);
+        return true;
+    }
+
+    // Hand every complete buffered request to a worker unless one is already running
+    void dispatch(Connection* conn) {
+        if (conn->busy || !pool) return;
+        size_t end = conn->input.rfind('\n');
+        if (end == std::string::npos) {
+            if (conn->input.size() > MAX_LINE) {
+                conn->output += "{\"ok\":false,\"error\":\"Request too long.\"}\n";
+                conn->input.clear();
+                conn->peerClosed = true;
+            }
+            return;
+        }
+        std::string batch = conn->input.substr(0, end + 1);
+        conn->input.erase(0, end + 1);
+        conn->busy = true;
+        pool->submit([this, conn, batch = std::move(batch)] {
+            std::string replies;
+            conn->session->process(batch, replies);
+            {
+                std::lock_guard<std::mutex> lock(completionMtx);
+                completions.push_back({conn, std::move(replies)});
+            }
+            uint64_t one = 1;
+            ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        });
+    }
+
+    // Decide what a connection needs after any change: more work, more output, or closing
+    void settle(Connection* conn) {
+        dispatch(conn);
+        if (!flush(conn)) {
+            conn->peerClosed = true;
+        }
+        if (conn->peerClosed && !conn->busy && conn->output.empty()) {
+            closeConnection(conn);
+            return;
+        }
+        updateInterest(conn);
+    }
+
+    void readFrom(Connection* conn) {
+        char buf[64 * 1024];
+        while (conn->input.size() < MAX_PENDING_INPUT) {
+            ssize_t n = ::recv(conn->fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                conn->input.append(buf, static_cast<size_t>(n));
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                conn->peerClosed = true;
+            }
+            break;
+        }
+    }
+
+    void drainCompletions() {
+        uint64_t count;
+        ssize_t ignored = ::read(wakeFd, &count, sizeof(count));
+        (void)ignored;
+        std::vector<Completion> done;
+        {
+            std::lock_guard<std::mutex> lock(completionMtx);
+            done.swap(completions);
+        }
+        for (auto& completion : done) {
+            Connection* conn = completion.conn;
+            conn->output += completion.replies;
+            conn->busy = false;
+            settle(conn);
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor for LineServer.
+     * @param listenAddress "host:port", ":port" or "unix:/path/to/socket".
+     * @param factory Creates the session for each new connection.
+     * @param workers Number of worker threads.
+     */
+    LineServer(const std::string& listenAddress, SessionFactory factory, size_t workers)
+        : address(listenAddress), makeSession(std::move(factory)), workerCount(workers) {}
+
+    ~LineServer() {
+        pool.reset();
+        for (auto& entry : connections) {
+            ::close(entry.first);
+        }
+        for (int fd : {listenFd, epollFd, wakeFd, signalFd}) {
+            if (fd >= 0) ::close(fd);
+        }
+        if (address.rfind("unix:", 0) == 0) {
+            ::unlink(address.substr(5).c_str());
+        }
+    }
+
+    LineServer(const LineServer&) = delete;
+    LineServer& operator=(const LineServer&) = delete;
+
+    /**
+     * @brief Serve connections until SIGINT or SIGTERM.
+     * @return False if the server could not start.
+     */
+    bool run() {
+        // Block the shutdown signals before starting workers so only the signalfd sees them
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGINT);
+        sigaddset(&mask, SIGTERM);
+        if (::pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) return fail("pthread_sigmask");
+        signalFd = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (signalFd < 0 || epollFd < 0 || wakeFd < 0) return fail("event loop setup");
+        if (!openListener()) return false;
+        watch(listenFd, EPOLLIN, EPOLL_CTL_ADD);
+        watch(wakeFd, EPOLLIN, EPOLL_CTL_ADD);
+        watch(signalFd, EPOLLIN, EPOLL_CTL_ADD);
+        pool = std::make_unique<ThreadPool>(workerCount);
+        std::cerr << "Listening on " << address << " with " << pool->size() << " worker(s).\n";
+
+        std::vector<epoll_event> events(1024);
+        bool running = true;
+        while (running) {
+            int n = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return fail("epoll_wait");
+            }
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptConnections();
+                    continue;
+                }
+                if (fd == wakeFd) {
+                    drainCompletions();
+                    continue;
+                }
+                if (fd == signalFd) {
+                    running = false;
+                    continue;
+                }
+                auto it = connections.find(fd);
+                if (it == connections.end()) continue;
+                Connection* conn = it->second.get();
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                    readFrom(conn);
+                }
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    conn->peerClosed = true;
+                }
+                settle(conn);
+            }
+        }
+
+        // Let in-flight batches finish, then deliver what can still be delivered
+        pool.reset();
+        drainCompletions();
+        std::cerr << "Server stopped after " << acceptedCount << " connection(s).\n";
+        return true;
+    }
+};
+
+#endif // LINE_SERVER_H
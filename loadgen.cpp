@@ -0,0 +1,337 @@
+/* ======================================
+   Load Generator
+   Drives a running `hotel_booking_system --serve` instance with many
+   concurrent client connections and reports throughput and latency
+   percentiles. Each connection logs in as its own user and then issues a
+   mix of bookings, cancellations, date searches and account queries, one
+   request at a time.
+   ====================================== */
+
+#include <iostream>      // For standard input and output
+#include <string>        // For using string class
+#include <vector>        // For using vector container
+#include <memory>        // For unique_ptr
+#include <algorithm>     // For sort
+#include <chrono>        // For timing requests
+#include <thread>        // For client threads
+#include <cstring>       // For strerror
+#include <cstdlib>       // For atoi
+#include <arpa/inet.h>   // For inet_pton
+#include <netinet/in.h>  // For sockaddr_in
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <sys/epoll.h>   // For waiting on many connections
+#include <sys/socket.h>  // For socket, connect, send, recv
+#include <sys/un.h>      // For sockaddr_un
+#include <unistd.h>      // For close
+#include "calendar.h"    // For request dates
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const char* const ROOM_TYPES[] = {"Standard", "Deluxe", "Suite"};
+
+// Open a blocking connection to "unix:<path>" or "host:port"
+int connectTo(const string& address) {
+    int fd;
+    if (address.rfind("unix:", 0) == 0) {
+        sockaddr_un addr{};
+        string path = address.substr(5);
+        if (path.size() >= sizeof(addr.sun_path)) return -1;
+        addr.sun_family = AF_UNIX;
+        path.copy(addr.sun_path, path.size());
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+    size_t colon = address.rfind(':');
+    string host = colon == string::npos || colon == 0 ? "127.0.0.1" : address.substr(0, colon);
+    if (host == "localhost") host = "127.0.0.1";
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(atoi(address.substr(colon == string::npos ? 0 : colon + 1).c_str())));
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) return -1;
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// Integer value following "key": in a reply line, or -1
+int replyInt(const string& line, const string& key) {
+    size_t pos = line.find("\"" + key + "\":");
+    if (pos == string::npos) return -1;
+    return atoi(line.c_str() + pos + key.size() + 3);
+}
+
+// String value following "key": in a reply line
+string replyString(const string& line, const string& key) {
+    size_t pos = line.find("\"" + key + "\":\"");
+    if (pos == string::npos) return "";
+    pos += key.size() + 4;
+    return line.substr(pos, line.find('"', pos) - pos);
+}
+
+/**
+ * @class ClientConnection
+ * @brief One simulated user with at most one request in flight.
+ */
+class ClientConnection {
+    enum class Stage { REGISTERING, LOGGING_IN, RUNNING, FAILED };
+
+    int fd;
+    string username;
+    string phone, adhaar; // Unique per user, as registration requires
+    string input;
+    Stage stage = Stage::REGISTERING;
+    uint64_t rng;
+    int today;
+    bool lastWasBook = false;
+    vector<pair<int, string>> myBookings; // (room, checkIn) of successful bookings
+    Clock::time_point sentAt;
+
+    uint32_t nextRandom() {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return static_cast<uint32_t>(rng);
+    }
+
+    bool sendLine(const string& line) {
+        sentAt = Clock::now();
+        size_t sent = 0;
+        while (sent < line.size()) {
+            ssize_t n = send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    string stayFields() {
+        return ",\"checkIn\":\"" + formatDate(today + static_cast<int>(nextRandom() % 300)) +
+               "\",\"nights\":" + to_string(1 + nextRandom() % 3);
+    }
+
+    // Pick the next request of the workload mix
+    string nextRequest() {
+        uint32_t pick = nextRandom() % 100;
+        lastWasBook = false;
+        const char* type = ROOM_TYPES[nextRandom() % 3];
+        if (pick < 35) {
+            lastWasBook = true;
+            return string("{\"op\":\"book\",\"type\":\"") + type + "\"" + stayFields() + "}\n";
+        }
+        if (pick < 55 && !myBookings.empty()) {
+            auto [room, checkIn] = myBookings.back();
+            myBookings.pop_back();
+            return "{\"op\":\"cancel\",\"room\":" + to_string(room) + ",\"checkIn\":\"" + checkIn + "\"}\n";
+        }
+        if (pick < 80) {
+            return string("{\"op\":\"search\",\"type\":\"") + type + "\"" + stayFields() + "}\n";
+        }
+        if (pick < 90) {
+            return "{\"op\":\"bookings\"}\n";
+        }
+        return "{\"op\":\"loyalty\"}\n";
+    }
+
+public:
+    ClientConnection(int socketFd, int index, int todayNumber)
+        : fd(socketFd), username("lg" + to_string(index)), rng(0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(index + 1)),
+          today(todayNumber) {
+        string digits = to_string(index);
+        phone = "9" + string(9 - digits.size(), '0') + digits;
+        adhaar = "1" + string(11 - digits.size(), '0') + digits;
+    }
+
+    ~ClientConnection() { close(fd); }
+
+    int getFd() const { return fd; }
+
+    bool start() {
+        return sendLine("{\"op\":\"register\",\"username\":\"" + username + "\",\"password\":\"loadgen\",\"name\":\"Load Gen\","
+                        "\"email\":\"" + username + "@example.com\",\"phone\":\"" + phone + "\",\"adhaar\":\"" + adhaar + "\"}\n");
+    }
+
+    /**
+     * @brief Read whatever the server sent and send the next request per complete reply.
+     * @param latencies Receives the latency in nanoseconds of each measured reply.
+     * @param errors Incremented for every reply with "ok":false.
+     * @return False if the connection closed.
+     */
+    bool onReadable(vector<uint32_t>& latencies, uint64_t& errors) {
+        char buf[16384];
+        ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n <= 0) {
+            stage = Stage::FAILED;
+            return false;
+        }
+        input.append(buf, static_cast<size_t>(n));
+        size_t end;
+        while ((end = input.find('\n')) != string::npos) {
+            string line = input.substr(0, end);
+            input.erase(0, end + 1);
+            bool ok = line.find("\"ok\":true") != string::npos;
+            string request;
+            switch (stage) {
+                case Stage::REGISTERING: // Already registered by an earlier run is fine
+                    stage = Stage::LOGGING_IN;
+                    request = "{\"op\":\"login\",\"username\":\"" + username + "\",\"password\":\"loadgen\"}\n";
+                    break;
+                case Stage::LOGGING_IN:
+                    if (!ok) {
+                        cerr << "Login failed for " << username << ": " << line << "\n";
+                        stage = Stage::FAILED;
+                        return false;
+                    }
+                    stage = Stage::RUNNING;
+                    break;
+                case Stage::RUNNING: {
+                    auto nanos = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - sentAt).count();
+                    latencies.push_back(static_cast<uint32_t>(min<int64_t>(nanos, UINT32_MAX)));
+                    if (!ok) {
+                        ++errors;
+                    }
+                    else if (lastWasBook) {
+                        myBookings.emplace_back(replyInt(line, "room"), replyString(line, "checkIn"));
+                    }
+                    break;
+                }
+                case Stage::FAILED:
+                    return false;
+            }
+            if (stage == Stage::RUNNING) {
+                request = nextRequest();
+            }
+            if (!sendLine(request)) {
+                stage = Stage::FAILED;
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+struct ThreadResult {
+    vector<uint32_t> latencies;
+    uint64_t errors = 0;
+    int failedConnections = 0;
+};
+
+// Run a share of the connections on one epoll set until the deadline
+void runClients(const string& address, int first, int count, Clock::time_point deadline, ThreadResult& result) {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<unique_ptr<ClientConnection>> clients;
+    int today = todayDayNumber();
+    for (int i = first; i < first + count; ++i) {
+        int fd = connectTo(address);
+        if (fd < 0) {
+            cerr << "Error connecting to " << address << ": " << strerror(errno) << "\n";
+            ++result.failedConnections;
+            continue;
+        }
+        clients.push_back(make_unique<ClientConnection>(fd, i, today));
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = clients.back().get();
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        if (!clients.back()->start()) {
+            ++result.failedConnections;
+        }
+    }
+
+    vector<epoll_event> events(256);
+    size_t open = clients.size();
+    while (open > 0 && Clock::now() < deadline) {
+        auto left = chrono::duration_cast<chrono::milliseconds>(deadline - Clock::now()).count();
+        int n = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), static_cast<int>(max<int64_t>(left, 1)));
+        for (int k = 0; k < n; ++k) {
+            auto* client = static_cast<ClientConnection*>(events[k].data.ptr);
+            if (!client->onReadable(result.latencies, result.errors)) {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, client->getFd(), nullptr);
+                ++result.failedConnections;
+                --open;
+            }
+        }
+    }
+    close(epollFd);
+}
+
+// Main function
+int main(int argc, char* argv[]) {
+    string address;
+    int connections = 64;
+    int threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    double duration = 10.0;
+    bool usageError = false;
+    for (int i = 1; i < argc && !usageError; ++i) {
+        string arg = argv[i];
+        if (arg == "--connect" && i + 1 < argc) {
+            address = argv[++i];
+        }
+        else if (arg == "--connections" && i + 1 < argc) {
+            connections = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            threads = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--duration" && i + 1 < argc) {
+            duration = atof(argv[++i]);
+        }
+        else {
+            usageError = true;
+        }
+    }
+    if (usageError || address.empty() || duration <= 0) {
+        cerr << "Usage: " << argv[0] << " --connect <host:port | unix:path> [--connections N] [--threads T] [--duration seconds]\n";
+        return 1;
+    }
+    threads = min(threads, connections);
+
+    auto start = Clock::now();
+    auto deadline = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(duration));
+    vector<ThreadResult> results(static_cast<size_t>(threads));
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        int first = connections * t / threads;
+        int count = connections * (t + 1) / threads - first;
+        workers.emplace_back(runClients, address, first, count, deadline, ref(results[static_cast<size_t>(t)]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<uint32_t> latencies;
+    uint64_t errors = 0;
+    int failed = 0;
+    for (auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+        failed += result.failedConnections;
+    }
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) -> double {
+        if (latencies.empty()) return 0.0;
+        return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))] / 1000.0;
+    };
+
+    // One machine-readable summary line on stdout
+    char summary[512];
+    snprintf(summary, sizeof(summary),
+             "{\"connections\":%d,\"threads\":%d,\"seconds\":%.2f,\"requests\":%zu,\"errors\":%llu,"
+             "\"failedConnections\":%d,\"throughput\":%.1f,\"p50_us\":%.1f,\"p90_us\":%.1f,"
+             "\"p99_us\":%.1f,\"p999_us\":%.1f,\"max_us\":%.1f}",
+             connections, threads, seconds, latencies.size(), static_cast<unsigned long long>(errors), failed,
+             static_cast<double>(latencies.size()) / seconds, percentile(0.50), percentile(0.90),
+             percentile(0.99), percentile(0.999), percentile(1.0));
+    cout << summary << endl;
+    return 0;
+}
@@ -0,0 +1,184 @@
+/* ======================================
+   Loyalty Ledger
+   Append-only history of loyalty point changes with the running totals of
+   every account kept in flat arrays indexed by account id. A booking or
+   cancellation appends one entry and adds to the account's pending change;
+   the end-of-day close folds all pending changes into the settled balances
+   and expires the points of inactive accounts in passes over those arrays.
+   Tiers are not stored: they are derived from the balance when asked for.
+   ====================================== */
+
+#ifndef LOYALTY_LEDGER_H
+#define LOYALTY_LEDGER_H
+
+#include <algorithm> // For std::min
+#include <cstdint>   // For fixed width integers
+#include <vector>    // For using vector container
+
+using LoyaltyAccount = uint32_t;
+
+enum class LoyaltyTier : uint8_t { REGULAR, SILVER, GOLD, PLATINUM };
+
+/**
+ * @brief Tier earned by a points balance.
+ */
+constexpr LoyaltyTier loyaltyTierFor(int points) {
+    return points >= 1000 ? LoyaltyTier::PLATINUM
+         : points >= 500  ? LoyaltyTier::GOLD
+         : points >= 200  ? LoyaltyTier::SILVER
+                          : LoyaltyTier::REGULAR;
+}
+
+enum class LedgerKind : uint8_t { EARN, REVERSE, EXPIRE };
+
+constexpr const char* LEDGER_KIND_NAMES[] = {"earn", "reverse", "expire"};
+
+/**
+ * @struct LedgerEntry
+ * @brief One change to an account; points are negative for reversals and expiry.
+ */
+struct LedgerEntry {
+    LoyaltyAccount account;
+    int32_t day;    // Day number of the change
+    int32_t points;
+    LedgerKind kind;
+};
+
+/**
+ * @struct DayClose
+ * @brief Totals of one end-of-day close.
+ */
+struct DayClose {
+    int64_t settled = 0;        // Net points folded into the balances
+    int64_t expiredPoints = 0;
+    size_t expiredAccounts = 0;
+};
+
+/**
+ * @class LoyaltyLedger
+ * @brief Points history and per-account totals.
+ *
+ * Balances loaded from a checkpoint open their account without an entry;
+ * the history only records what changed since. Balances never go below 0:
+ * a reversal takes at most what the account holds.
+ */
+class LoyaltyLedger {
+    std::vector<LedgerEntry> entries;
+    std::vector<int32_t> settled;     // Balance as of the last close
+    std::vector<int32_t> pending;     // Net change since the last close
+    std::vector<int32_t> lastEarnDay; // Day each account last earned points
+    int lastClosedDay = 0;            // 0 if no day was closed yet
+
+public:
+    void clear() {
+        entries.clear();
+        settled.clear();
+        pending.clear();
+        lastEarnDay.clear();
+        lastClosedDay = 0;
+    }
+
+    void reserve(size_t accounts) {
+        settled.reserve(accounts);
+        pending.reserve(accounts);
+        lastEarnDay.reserve(accounts);
+    }
+
+    /**
+     * @brief Add an account holding points, with no history entry.
+     * @param earnDay Day the account last earned points (starts its expiry clock).
+     */
+    LoyaltyAccount open(int points, int earnDay) {
+        settled.push_back(std::max(0, points));
+        pending.push_back(0);
+        lastEarnDay.push_back(earnDay);
+        return static_cast<LoyaltyAccount>(settled.size() - 1);
+    }
+
+    // Replace an account's balance, as when a later record of the same customer is loaded
+    void restate(LoyaltyAccount account, int points, int earnDay) {
+        settled[account] = std::max(0, points);
+        pending[account] = 0;
+        lastEarnDay[account] = earnDay;
+    }
+
+    size_t accountCount() const { return settled.size(); }
+
+    // Close the accounts opened last, keeping the first count; they must have no history entries
+    void truncate(size_t count) {
+        settled.resize(count);
+        pending.resize(count);
+        lastEarnDay.resize(count);
+    }
+
+    int balance(LoyaltyAccount account) const { return settled[account] + pending[account]; }
+    LoyaltyTier tier(LoyaltyAccount account) const { return loyaltyTierFor(balance(account)); }
+    int getLastEarnDay(LoyaltyAccount account) const { return lastEarnDay[account]; }
+
+    void earn(LoyaltyAccount account, int points, int day) {
+        if (points <= 0) return;
+        entries.push_back({account, day, points, LedgerKind::EARN});
+        pending[account] += points;
+        lastEarnDay[account] = std::max(lastEarnDay[account], day);
+    }
+
+    /**
+     * @brief Take back up to points from an account.
+     * @return Points actually taken.
+     */
+    int reverse(LoyaltyAccount account, int points, int day) {
+        int taken = std::min(points, balance(account));
+        if (taken <= 0) return 0;
+        entries.push_back({account, day, -taken, LedgerKind::REVERSE});
+        pending[account] -= taken;
+        return taken;
+    }
+
+    int getLastClosedDay() const { return lastClosedDay; }
+    void setLastClosedDay(int day) { lastClosedDay = day; }
+
+    /**
+     * @brief Settle the pending changes of every account and expire inactive ones.
+     *
+     * An account expires once expiryDays have passed since it last earned
+     * points: its whole balance is taken back with an EXPIRE entry.
+     *
+     * @param day Day being closed; must be later than the last closed day.
+     */
+    DayClose closeDay(int day, int expiryDays) {
+        DayClose result;
+        const size_t count = settled.size();
+        int32_t* balances = settled.data();
+        int32_t* changes = pending.data();
+        const int32_t* earned = lastEarnDay.data();
+
+        // Branch-free so the compiler can vectorize it
+        int64_t settledPoints = 0;
+        for (size_t i = 0; i < count; ++i) {
+            settledPoints += changes[i];
+            balances[i] += changes[i];
+            changes[i] = 0;
+        }
+        result.settled = settledPoints;
+
+        const int32_t lastActiveDay = day - expiryDays;
+        for (size_t i = 0; i < count; ++i) {
+            if (balances[i] > 0 && earned[i] <= lastActiveDay) {
+                entries.push_back({static_cast<LoyaltyAccount>(i), day, -balances[i], LedgerKind::EXPIRE});
+                result.expiredPoints += balances[i];
+                ++result.expiredAccounts;
+                balances[i] = 0;
+            }
+        }
+        lastClosedDay = day;
+        return result;
+    }
+
+    // Entries appended since the history was last cleared
+    const std::vector<LedgerEntry>& getEntries() const { return entries; }
+
+    // Forget the entries once they are stored elsewhere; balances are unaffected
+    void clearEntries() { entries.clear(); }
+};
+
+#endif // LOYALTY_LEDGER_H
@@ -13,14 +13,38 @@
 #include <unordered_map> // For using unordered_map container
 #include <algorithm>     // For using algorithms like sort, find, etc.
 #include <iomanip>       // For setting output format
-#include <regex>         // For using regular expressions
 #include <limits>        // For numeric limits
 #include <deque>         // For using deque container
 #include <fstream>       // For file input and output
-#include <sstream>       // For string stream operations
 #include <chrono>        // For date and time operations
 #include <ctime>         // For C-style date and time operations
 #include <map>           // For using map container
+#include <set>           // For the point changes found at startup
+#include <iterator>      // For back_inserter
+#include "journal.h"     // For the append-only booking journal
+#include "snapshot.h"    // For the binary snapshot
+#include "csv_loader.h"  // For importing the text files
+#include "validator.h"   // For prompts and field validation
+#include "metrics.h"     // For operation latency histograms
+#include "loyalty_ledger.h" // For loyalty points and their history
+#include "table_writer.h" // For buffered, paged listings
+#include <sys/stat.h>    // For comparing file modification times
+#include "room_inventory.h" // For the dense room table
+#include "report_counters.h" // For live report totals
+#include "calendar.h"    // For date-ranged room availability
+#include "pricing.h"     // For nightly rates and stay quotes
+#include "waitlist.h"    // For guests waiting for a room to be released
+#include "customer_store.h" // For compact customer records and their indexes
+#include "json_lines.h"  // For batch mode input and output
+#include "line_server.h" // For server mode
+#include <mutex>         // For serializing server requests on the hotel
+#include <thread>        // For the default worker count
+#include "thread_pool.h" // For the chain's search fan-out
+#include "forecast.h"    // For Monte Carlo occupancy forecasts
+#include "stay_archive.h" // For the history of ended stays
+#include "availability_view.h" // For the room state shared with front-desk terminals
+#include <dirent.h>      // For listing the properties of a chain
+#include <cerrno>        // For EEXIST
 
 using namespace std;
 
@@ -55,837 +79,3895 @@ public:
     }
 };
 
-// Room base class
-/**
- * @class Room
- * @brief Abstract base class for different types of rooms.
- */
-class Room {
-protected:
-    int roomNumber;
-    double price;
-    bool isBooked;
+// A registered customer: a handle to their record in the hotel's CustomerTable.
+// Copying a handle is cheap; it stays valid while the hotel is open.
+class Customer {
+private:
+    const CustomerTable* table = nullptr;
+    const LoyaltyLedger* ledger = nullptr; // Holds the points
+    CustomerId id = NO_CUSTOMER;
 
 public:
-    /**
-     * @brief Constructor for Room.
-     * @param number Room number.
-     * @param price Price of the room.
-     */
-    Room(int number, double price) : roomNumber(number), price(price), isBooked(false) {}
-    /**
-     * @brief Virtual destructor for Room.
-     */
-    virtual ~Room() = default;
-
-    /**
-     * @brief Get the booking status of the room.
-     * @return True if the room is booked, false otherwise.
-     */
-
-    bool getIsBooked() const { return isBooked; }
-
-    /**
-     * @brief Set the booking status of the room.
-     * @param status Booking status to set.
-     */
+    Customer() = default; // No customer
+    Customer(const CustomerTable& table, const LoyaltyLedger& ledger, CustomerId id)
+        : table(&table), ledger(&ledger), id(id) {}
 
-    void setBooked(bool status) { isBooked = status; }
+    explicit operator bool() const { return table != nullptr; }
 
-    /**
-     * @brief Get the room number.
-     * @return Room number.
-     */
-
-    int getRoomNumber() const { return roomNumber; }
+    // Getter methods
+    CustomerId getId() const { return id; }
+    string_view getUsername() const { return table->getUsername(id); }
+    string_view getName() const { return table->getName(id); }
+    string_view getEmail() const { return table->getEmail(id); }
+    string getPhone() const { return table->getPhone(id); }
+    string getAdhaar() const { return table->getAdhaar(id); }
+    string_view getPassword() const { return table->getPassword(id); }
+    LoyaltyAccount getLoyaltyAccount() const { return table->getAccount(id); }
+    int getLoyaltyPoints() const { return ledger->balance(getLoyaltyAccount()); }
+    LoyaltyTier getTier() const { return loyaltyTierFor(getLoyaltyPoints()); }
+    string getTierName() const { return tierToString(getTier()); }
 
-    /**
-     * @brief Get the price of the room.
-     * @return Price of the room.
-     */ 
+    void display() const {
+        cout << "Name: " << getName() << endl
+             << "Email: " << getEmail() << endl
+             << "Phone: " << getPhone() << endl
+             << "Adhaar: " << getAdhaar() << endl
+             << "Loyalty Points: " << getLoyaltyPoints() << endl
+             << "Tier: " << getTierName() << endl;
+    }
 
-    double getPrice() const { return price; }
-   
-    /**
-     * @brief Pure virtual function to display room information.
-     */
-    virtual void displayInfo() const = 0;
-    /**
-     * @brief Pure virtual function to get the room type.
-     * @return Room type as a string.
-     */
-    virtual string getRoomType() const = 0;
+    static string tierToString(LoyaltyTier t) { // Helper function to convert LoyaltyTier to string
+        switch (t) {
+            case LoyaltyTier::REGULAR: return "Regular";
+            case LoyaltyTier::SILVER: return "Silver";
+            case LoyaltyTier::GOLD: return "Gold";
+            case LoyaltyTier::PLATINUM: return "Platinum";
+            default: return "Unknown";
+        }
+    }
 };
-// StandardRoom class
+
 /**
- * @class StandardRoom
- * @brief Derived class for standard rooms.
+ * @struct Booking
+ * @brief A reservation of one room for the nights [checkIn, checkOut).
  */
-class StandardRoom : public Room {
-public:
-    StandardRoom(int number) : Room(number, 3000.0) {} // Price in INR
-
-    void displayInfo() const override {
-        cout << "Room " << roomNumber << " - Standard (₹" << price << ")\n";
-    }
+struct Booking {
+    string username;
+    int checkIn;  // Day number of the first night
+    int checkOut; // Day number of departure
+    int32_t price = 0; // INR charged for the stay, quoted when it was booked; 0 if unknown
+};
 
-    string getRoomType() const override {
-        return "Standard";
-    }
+/**
+ * @struct ImportResult
+ * @brief Row counts of a bulk customer import.
+ */
+struct ImportResult {
+    size_t rows = 0;     // Non-empty lines in the file
+    size_t imported = 0; // New customers registered
+    size_t rejected = 0; // Rows written to the rejects file
 };
 
-class DeluxeRoom : public Room {
-public:
-    DeluxeRoom(int number) : Room(number, 5000.0) {} // Price in INR
+/**
+ * @brief Where the rooms of a group booking must lie relative to each other.
+ */
+enum class GroupPlacement : uint8_t { ANY, SAME_FLOOR, ADJACENT };
 
-    void displayInfo() const override {
-        cout << "Room " << roomNumber << " - Deluxe (₹" << price << ")\n";
-    }
+constexpr const char* GROUP_PLACEMENT_NAMES[] = {"any", "floor", "adjacent"};
 
-    string getRoomType() const override {
-        return "Deluxe";
+inline bool parseGroupPlacement(string_view name, GroupPlacement& placement) {
+    for (size_t p = 0; p < size(GROUP_PLACEMENT_NAMES); ++p) {
+        if (name == GROUP_PLACEMENT_NAMES[p]) {
+            placement = static_cast<GroupPlacement>(p);
+            return true;
+        }
     }
-};
+    return false;
+}
 
-class SuiteRoom : public Room {
-public:
-    SuiteRoom(int number) : Room(number, 8000.0) {} // Price in INR
+/**
+ * @struct GroupBooking
+ * @brief Rooms taken by one group booking and the loyalty points it earned.
+ */
+struct GroupBooking {
+    vector<int> roomNumbers;
+    int points = 0;
+};
 
-    void displayInfo() const override {
-        cout << "Room " << roomNumber << " - Suite (₹" << price << ")\n";
+// Hotel class with Reporting Features
+// Report printers, shared by the hotel and by front-desk terminals reading an AvailabilitySnapshot.
+// Rooms offers the reads of RoomInventory used here, Counters those of ReportCounters.
+
+// Print one row of a room listing, opening a new floor section when the floor changes
+template<typename Rooms>
+void printRoomRow(TableWriter& table, const Rooms& rooms, RoomId id, int& currentFloor) {
+    if (rooms.getFloor(id) != currentFloor) {
+        currentFloor = rooms.getFloor(id);
+        table.line("");
+        table.line("--- Floor " + to_string(currentFloor) + " ---");
+        table.row("Room No", "Type");
+        table.line("------------------------------");
     }
+    table.row(rooms.getNumber(id), roomTypeName(rooms.getType(id)));
+}
 
-    string getRoomType() const override {
-        return "Suite";
+template<typename Rooms>
+void printAvailableRooms(const Rooms& rooms) {
+    // Free rooms are visited in room-number order, i.e. floor by floor
+    int currentFloor = -1;
+    {
+        TableWriter table(cout, {10, 15});
+        rooms.forEachFree([&rooms, &table, &currentFloor](RoomId id) { printRoomRow(table, rooms, id, currentFloor); });
     }
-};
-
-// Customer class with additional getter methods
-class Customer {
-public:
-    enum class LoyaltyTier { REGULAR, SILVER, GOLD, PLATINUM };
-
-private:
-    string name;
-    string email;
-    string phone;
-    string adhaar;
-    string password;
-    int loyaltyPoints;
-    LoyaltyTier tier;
-
-public:
-    Customer(const string& name, const string& email, const string& phone, const string& adhaar, const string& pwd)
-        : name(name), email(email), phone(phone), adhaar(adhaar), password(pwd), loyaltyPoints(0), tier(LoyaltyTier::REGULAR) {}
-
-    // Getter methods
-    string getName() const { return name; }
-    string getEmail() const { return email; }
-    string getPhone() const { return phone; }
-    string getAdhaar() const { return adhaar; }
-    string getPassword() const { return password; }
-    int getLoyaltyPoints() const { return loyaltyPoints; }
-
-    void addLoyaltyPoints(int points) {
-        if (points > 0) {
-            loyaltyPoints += points;
-            updateTier();
-        }
-        else if (points < 0) {
-            loyaltyPoints += points;
-            if (loyaltyPoints < 0)
-                loyaltyPoints = 0;
-            updateTier();
-        }
+    if (currentFloor < 0) {
+        cout << "No rooms are free tonight.\n";
+        return;
     }
-
-    void display() const {
-        cout << "Name: " << name << endl
-             << "Email: " << email << endl
-             << "Phone: " << phone << endl
-             << "Adhaar: " << adhaar << endl
-             << "Loyalty Points: " << loyaltyPoints << endl
-             << "Tier: " << tierToString(tier) << endl;
+    cout << "\nFree tonight:";
+    for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+        cout << " " << ROOM_TYPE_NAMES[t] << " " << rooms.getFreeCount(static_cast<RoomType>(t));
     }
+    cout << "\n";
+}
 
-    string tierToString(LoyaltyTier t) const { // Helper function to convert LoyaltyTier to string
-        switch (t) {
-            case LoyaltyTier::REGULAR: return "Regular";
-            case LoyaltyTier::SILVER: return "Silver";
-            case LoyaltyTier::GOLD: return "Gold";
-            case LoyaltyTier::PLATINUM: return "Platinum";
-            default: return "Unknown";
-        }
+template<typename Counters>
+void printOccupancyReport(const Counters& counters) {
+    size_t totalRooms = counters.getTotalRooms(), bookedRooms = counters.getBookedRooms();
+    double occupancyRate = (static_cast<double>(bookedRooms) / totalRooms) * 100.0;
+
+    cout << "\n=== Occupancy Report ===\n";
+    cout << "Total Rooms: " << totalRooms << endl;
+    cout << "Rooms Booked Tonight: " << bookedRooms << endl;
+    cout << "Rooms Free Tonight: " << (totalRooms - bookedRooms) << endl;
+    cout << fixed << setprecision(2) << "Occupancy Rate: " << occupancyRate << "%" << endl;
+    cout << "Active Bookings: " << counters.getReservations() << endl;
+    cout << "Revenue Booked: INR " << counters.getRevenue() << endl;
+    cout << "Loyalty Points Issued: " << counters.getPointsIssued()
+         << " (held by customers: " << counters.getLoyaltyBalance() << ")" << endl;
+
+    cout << "\n" << left << setw(12) << "Type" << setw(10) << "Booked" << setw(10) << "Free" << endl;
+    cout << "--------------------------------\n";
+    for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+        RoomType type = static_cast<RoomType>(t);
+        cout << left << setw(12) << roomTypeName(type) << setw(10) << counters.getBookedRooms(type)
+             << setw(10) << counters.getFreeRooms(type) << endl;
     }
 
-private: // Helper function to update tier based on loyalty points
-    void updateTier() {
-        if (loyaltyPoints >= 1000) tier = LoyaltyTier::PLATINUM;
-        else if (loyaltyPoints >= 500) tier = LoyaltyTier::GOLD;
-        else if (loyaltyPoints >= 200) tier = LoyaltyTier::SILVER;
-        else tier = LoyaltyTier::REGULAR;
+    cout << "\n" << left << setw(12) << "Floor" << setw(10) << "Booked" << setw(10) << "Free" << endl;
+    cout << "--------------------------------\n";
+    for (int floor = 0; floor <= counters.getTopFloor(); ++floor) {
+        if (counters.getRoomsOnFloor(floor) == 0) continue;
+        cout << left << setw(12) << floor << setw(10) << counters.getBookedOnFloor(floor)
+             << setw(10) << counters.getRoomsOnFloor(floor) - counters.getBookedOnFloor(floor) << endl;
     }
-};
+}
 
-// Validator Class
-class Validator {
-public:
-    template<typename T>
-    static T getInput(const string& prompt) {
-        T input;
-        while (true) {
-            cout << prompt;
-            cin >> input;
-            if (cin.fail()) {
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                cout << "Invalid input. Please try again.\n";
-            }
-            else {
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                return input;
-            }
+// Room types with their booking counts, most popular first
+template<typename Counters>
+vector<pair<string, int>> popularRoomTypes(const Counters& counters) {
+    vector<pair<string, int>> sortedRoomTypes;
+    for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+        int count = static_cast<int>(counters.getReservations(static_cast<RoomType>(t)));
+        if (count > 0) {
+            sortedRoomTypes.emplace_back(ROOM_TYPE_NAMES[t], count);
         }
     }
+    stable_sort(sortedRoomTypes.begin(), sortedRoomTypes.end(),
+        [](const pair<string, int>& a, const pair<string, int>& b) -> bool {
+            return a.second > b.second;
+        });
+    return sortedRoomTypes;
+}
 
-    static bool isValidEmail(const string& email) {
-        const regex pattern("[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}");
-        return regex_match(email, pattern);
-    }
-
-    static bool isValidPhone(const string& phone) {
-        return phone.length() == 10 && all_of(phone.begin(), phone.end(), ::isdigit);
+inline void printPopularRoomTypes(const vector<pair<string, int>>& sortedRoomTypes) {
+    cout << "\n=== Popular Room Types Report ===\n";
+    if (sortedRoomTypes.empty()) {
+        cout << "No bookings yet.\n";
+        return;
     }
 
-    static bool isValidAdhaar(const string& adhaar) {
-        return adhaar.length() == 12 && all_of(adhaar.begin(), adhaar.end(), ::isdigit);
+    cout << left << setw(20) << "Room Type" << setw(10) << "Bookings" << endl;
+    cout << "------------------------------\n";
+    for (const auto& [type, count] : sortedRoomTypes) {
+        cout << left << setw(20) << type << setw(10) << count << endl;
     }
-};
+}
 
-// Hotel class with Reporting Features
 class Hotel {
 private:
-    unordered_map<string, shared_ptr<Customer>> customers; // username -> Customer
-    unordered_map<int, shared_ptr<Room>> rooms; // room number -> Room
-    unordered_map<int, string> bookings; // roomNumber -> username
-
-    const string CUSTOMERS_FILE = "customers.txt";
-    const string ROOMS_FILE = "rooms.txt";
-    const string BOOKINGS_FILE = "bookings.txt";
-
-    void saveCustomersToFile() {
-        ofstream file(CUSTOMERS_FILE);
+    // Customers and their points live in one hotel: this one, or the first property of a HotelChain
+    Hotel* const customerHome;
+    CustomerTable ownCustomers;
+    LoyaltyLedger ownLoyalty;
+
+    CustomerTable& customers; // customer records by id, indexed by username, email, phone and Adhaar
+    RoomInventory rooms; // dense room table indexed by RoomId; a room is flagged booked while occupied tonight
+    vector<vector<Booking>> bookings; // RoomId -> reservations ordered by check-in
+    vector<uint8_t> heldRooms; // RoomId -> 1 if loaded as booked with no reservation, until checked out or booked
+    unordered_map<string, vector<pair<RoomId, int>>> customerBookings; // username -> (room, checkIn) of each booking
+    ReportCounters counters; // running totals for the reports
+    AvailabilityCalendar calendar; // night-level availability of every room
+    PricingEngine pricing; // nightly rates by type, re-rated as bookings change occupancy
+    LoyaltyLedger& loyalty; // points of every customer and their changes since the last checkpoint
+    Waitlist waitlist; // guests waiting for a room type, served as rooms are released
+
+    const string dataDir; // Prefix of every file below: empty, or a directory ending in '/'
+    const string CUSTOMERS_FILE = dataDir + "customers.txt";
+    const string ROOMS_FILE = dataDir + "rooms.txt";
+    const string BOOKINGS_FILE = dataDir + "bookings.txt";
+    const string JOURNAL_FILE = dataDir + "journal.log";
+    const string SNAPSHOT_FILE = dataDir + "hotel.snap";
+    const string LOYALTY_LEDGER_FILE = dataDir + "loyalty_ledger.txt";
+    const string WAITLIST_FILE = dataDir + "waitlist.txt";
+    const string HISTORY_DIR = dataDir + "history/";
+
+    // The snapshot and text files are only rewritten once this many journal records have accumulated
+    static constexpr size_t CHECKPOINT_INTERVAL = 100000;
+
+    // Points expire once a customer has earned nothing for this many days
+    static constexpr int LOYALTY_EXPIRY_DAYS = 365;
+
+    // Rows per page in the admin customer and booking listings
+    static constexpr size_t ADMIN_PAGE_SIZE = 25;
+
+    // Most seasons a single occupancy forecast may simulate
+    static constexpr size_t MAX_FORECAST_RUNS = 1000000;
+
+    friend class HotelBench; // bench.cpp times the private persistence routines
+
+    BookingJournal journal;
+    StayArchive stayHistory; // stays ended since the hotel opened, by checkout or cancellation
+    AvailabilityPublisher availabilityView; // rooms and report totals for front-desk terminals, once loaded
+    bool deferCommits = false; // True while a batch is collecting records for one flush
+    bool snapshotStale = false; // True if the state was imported from the text files
+    size_t nextCheckpointAt = CHECKPOINT_INTERVAL; // Journal records that trigger the next automatic checkpoint
+    time_t nextHorizonCheck = 0; // When checkpointIfDue next looks for a new night
+
+    // A point change made at a chain property is journaled twice, and either record can be lost
+    // in a crash: as a numbered P record at the customers' hotel, and as a Q record at the
+    // property wrapping the booking change that caused it. Opening the property replays the
+    // missing half of each pair (see applyPointChange and reconcilePointChanges).
+    struct PropertyPoints {
+        uint64_t checkpointed = 0; // Changes up to this number are in the snapshot
+        uint64_t last = 0;         // Last change reflected in the balances
+        map<uint64_t, pair<string, int>> replayed; // Change -> (username, delta) of the P records replayed
+    };
+    unordered_map<string, PropertyPoints> propertyPoints; // By property name, at the customers' hotel
+    vector<Hotel*> properties; // Open properties booking against this hotel's customers
+
+    const string propertyName; // Name within its chain of a property; empty for the customers' hotel
+    uint64_t lastPointChange = 0; // Number of the property's last point change
+    uint64_t checkpointedPointChange = 0; // Changes up to this number are in the property's snapshot
+    set<uint64_t> replayedPointChanges; // Changes of the Q records replayed at startup
+    string pointChangePrefix; // "Q,change,username,delta," for the record of a change not yet journaled here
+
+    bool ownsCustomers() const { return customerHome == this; }
+
+    Customer customerAt(CustomerId id) const { return Customer(customers, loyalty, id); }
+
+    // Each save returns false, after an error message, if its file could not be durably replaced
+    bool saveCustomersToFile() {
+        if (!ownsCustomers()) return true;
+        TIME_OPERATION(Metric::SAVE_CUSTOMERS);
+        const string tmpFile = CUSTOMERS_FILE + ".tmp";
+        ofstream file(tmpFile);
         if (!file) {
-            cout << "Error opening " << CUSTOMERS_FILE << " for writing.\n";
-            return;
+            cout << "Error opening " << tmpFile << " for writing.\n";
+            return false;
         }
-        for (const auto& [username, customer] : customers) {
+        // Lines are assembled in a large buffer; formatting each field through the stream is far slower
+        constexpr size_t FLUSH_BYTES = 1 << 20;
+        string buffer;
+        buffer.reserve(FLUSH_BYTES + 4096);
+        for (CustomerId id = 0; id < customers.size(); ++id) {
             // Format: username,name,email,phone,adhaar,password,loyaltyPoints
-            file << username << ","
-                 << customer->getName() << ","
-                 << customer->getEmail() << ","
-                 << customer->getPhone() << ","
-                 << customer->getAdhaar() << ","
-                 << customer->getPassword() << ","
-                 << customer->getLoyaltyPoints() << "\n";
+            buffer += customers.getUsername(id);
+            buffer += ',';
+            buffer += customers.getName(id);
+            buffer += ',';
+            buffer += customers.getEmail(id);
+            buffer += ',';
+            buffer += customers.getPhone(id);
+            buffer += ',';
+            buffer += customers.getAdhaar(id);
+            buffer += ',';
+            buffer += customers.getPassword(id);
+            buffer += ',';
+            buffer += to_string(loyalty.balance(customers.getAccount(id)));
+            buffer += '\n';
+            if (buffer.size() >= FLUSH_BYTES) {
+                file.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
         }
-        file.close();
+        file.write(buffer.data(), buffer.size());
+        return closeAndReplace(file, tmpFile, CUSTOMERS_FILE);
     }
 
     void loadCustomersFromFile() { // Load customers from customers.txt
-        ifstream file(CUSTOMERS_FILE);
-        if (!file.is_open()) {
+        if (!ownsCustomers()) return;
+        TIME_OPERATION(Metric::LOAD_CUSTOMERS);
+        MappedFile file;
+        if (!file.open(CUSTOMERS_FILE)) {
             // No customers file exists yet
             return;
         }
-        string line;
-
-        while (getline(file, line)) {
-            stringstream ss(line);
-            string username, name, email, phone, adhaar, password, pointsStr;
-            if (getline(ss, username, ',') &&
-                getline(ss, name, ',') &&
-                getline(ss, email, ',') &&
-                getline(ss, phone, ',') &&
-                getline(ss, adhaar, ',') &&
-                getline(ss, password, ',') &&
-                getline(ss, pointsStr)) {
-
-                int points = stoi(pointsStr);
-                auto customer = make_shared<Customer>(name, email, phone, adhaar, password);
-                customer->addLoyaltyPoints(points);
-                customers[username] = customer;
+        LoadErrors errors;
+        size_t lines = 0;
+        struct CustomerRow {
+            string_view fields[6]; // Point into the mapped file
+            int points;
+        };
+        auto chunks = parseLinesInParallel<CustomerRow>(file.view(),
+            [](string_view line, vector<CustomerRow>& rows) -> const char* {
+                // Format: username,name,email,phone,adhaar,password,loyaltyPoints
+                string_view fields[7];
+                if (splitFields(line, fields, 7) != 7) return "expected 7 fields";
+                int points;
+                if (!parseInt(fields[6], points)) return "invalid loyalty points";
+                if (fields[0].empty()) return "missing username";
+                rows.push_back({{fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]}, points});
+                return nullptr;
+            }, errors, lines);
+        errors.report(CUSTOMERS_FILE, lines);
+
+        // Records are appended in file order; the text is copied once, into the customer arena.
+        // The text files do not say when points were earned: their expiry clock starts today
+        const int today = todayDayNumber();
+        customers.reserve(customers.size() + lines);
+        loyalty.reserve(loyalty.accountCount() + lines);
+        for (const auto& chunk : chunks) {
+            for (const CustomerRow& row : chunk) {
+                const string_view* f = row.fields;
+                CustomerId id = customers.find(f[0]);
+                if (id == NO_CUSTOMER) {
+                    customers.add(f[0], f[1], f[2], f[3], f[4], f[5], loyalty.open(row.points, today));
+                }
+                else {
+                    // Later lines win, keeping the account of the earlier one
+                    loyalty.restate(customers.getAccount(id), row.points, today);
+                    customers.update(id, f[1], f[2], f[3], f[4], f[5]);
+                }
             }
         }
-        file.close();
+
+        int64_t balance = 0;
+        for (CustomerId id = 0; id < customers.size(); ++id) {
+            balance += loyalty.balance(customers.getAccount(id));
+        }
+        counters.setLoyaltyBalance(balance);
     }
 
-    void saveRoomsToFile() { // Save rooms to rooms.txt
-        ofstream file(ROOMS_FILE);
+    bool saveRoomsToFile() { // Save rooms to rooms.txt
+        TIME_OPERATION(Metric::SAVE_ROOMS);
+        const string tmpFile = ROOMS_FILE + ".tmp";
+        ofstream file(tmpFile);
         if (!file) {
-            cout << "Error opening " << ROOMS_FILE << " for writing.\n";
-            return;
+            cout << "Error opening " << tmpFile << " for writing.\n";
+            return false;
         }
-        for (const auto& [number, room] : rooms) {
-            file << number << "," 
-                 << (room->getIsBooked() ? "1" : "0") << ","
-                 << room->getRoomType() << "\n";
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            file << rooms.getNumber(id) << ","
+                 << (rooms.isBooked(id) ? "1" : "0") << ","
+                 << roomTypeName(rooms.getType(id)) << "\n";
         }
-        file.close();
+        return closeAndReplace(file, tmpFile, ROOMS_FILE);
     }
 
     void loadRoomsFromFile() { // Load rooms from rooms.txt
-        ifstream file(ROOMS_FILE);
-        if (!file.is_open()) {
+        TIME_OPERATION(Metric::LOAD_ROOMS);
+        MappedFile file;
+        if (!file.open(ROOMS_FILE)) {
             // No rooms file exists yet
             return;
         }
-        string line;
-
-        while (getline(file, line)) {
-            stringstream ss(line);
-            string numStr, bookedStr, roomType;
-            if (getline(ss, numStr, ',') && 
-                getline(ss, bookedStr, ',') && 
-                getline(ss, roomType)) {
-
-                int number;
-                try {
-                    number = stoi(numStr);
-                }
-                catch (const invalid_argument& e) {
-                    cout << "Invalid room number format in rooms file.\n";
-                    continue;
-                }
-
-                bool booked = (bookedStr == "1");
-                shared_ptr<Room> room;
-
-                if (roomType == "Standard") {
-                    room = make_shared<StandardRoom>(number);
-                }
-                else if (roomType == "Deluxe") {
-                    room = make_shared<DeluxeRoom>(number);
-                }
-                else if (roomType == "Suite") {
-                    room = make_shared<SuiteRoom>(number);
-                }
-                else {
-                    cout << "Unknown room type '" << roomType << "' for room number " << number << ".\n";
-                    continue;
-                }
+        struct RoomRow {
+            int number;
+            RoomType type;
+            bool booked;
+        };
+        LoadErrors errors;
+        size_t lines = 0;
+        auto chunks = parseLinesInParallel<RoomRow>(file.view(),
+            [](string_view line, vector<RoomRow>& rows) -> const char* {
+                // Format: number,booked,type
+                string_view fields[3];
+                if (splitFields(line, fields, 3) != 3) return "expected 3 fields";
+                RoomRow row;
+                if (!parseInt(fields[0], row.number)) return "invalid room number format";
+                if (row.number <= 0) return "room number must be positive";
+                if (!RoomInventory::isValidNumber(row.number)) return "room number too large";
+                if (!parseRoomType(fields[2], row.type)) return "unknown room type";
+                row.booked = fields[1] == "1";
+                rows.push_back(row);
+                return nullptr;
+            }, errors, lines);
+        errors.report(ROOMS_FILE, lines);
 
-                room->setBooked(booked);
-                rooms[number] = room;
+        map<int, pair<RoomType, bool>> parsed; // room number -> (type, booked); later lines win
+        for (const auto& chunk : chunks) {
+            for (const RoomRow& row : chunk) {
+                parsed[row.number] = {row.type, row.booked};
             }
         }
-        file.close();
+        vector<pair<int, RoomType>> roomList;
+        roomList.reserve(parsed.size());
+        for (const auto& [number, state] : parsed) {
+            roomList.emplace_back(number, state.first);
+        }
+        rooms.assign(roomList);
+        for (const auto& [number, state] : parsed) {
+            rooms.setBooked(rooms.find(number), state.second);
+        }
     }
 
     // Load bookings from bookings.txt
     void loadBookingsFromFile() {
-        ifstream file(BOOKINGS_FILE);
-        if (!file.is_open()) {
+        TIME_OPERATION(Metric::LOAD_BOOKINGS);
+        MappedFile file;
+        if (!file.open(BOOKINGS_FILE)) {
             // No bookings file exists yet
             return;
         }
-        string line;
-
-        while (getline(file, line)) {
-            if (line.empty()) {
-                cout << "Skipping empty line in bookings file.\n";
-                continue;
-            }
-
-            stringstream ss(line);
-            string roomStr, username;
-            
-            if (getline(ss, roomStr, ',') && getline(ss, username)) {
-                cout << "Processing booking: Room " << roomStr << ", User " << username << "\n";
-                try {
-                    int roomNumber = stoi(roomStr);
-                    
-                    // Validate room existence
-                    auto it = rooms.find(roomNumber);
-                    if (it != rooms.end()) {
-                        bookings[roomNumber] = username;
-                        it->second->setBooked(true);
-                    } else {
-                        cout << "Warning: Room number " << roomNumber 
-                             << " in bookings file does not exist.\n";
-                    }
+        struct BookingRow {
+            int roomNumber;
+            string_view username; // Points into the mapped file
+            int checkIn;
+            int checkOut;
+            int price;
+        };
+        // Older files have no dates; treat those bookings as a single night from today
+        const int legacyNight = calendar.getFirstNight();
+        LoadErrors errors;
+        size_t lines = 0;
+        auto chunks = parseLinesInParallel<BookingRow>(file.view(),
+            [legacyNight](string_view line, vector<BookingRow>& rows) -> const char* {
+                // Format: roomNumber,username[,checkIn,checkOut[,price]]
+                string_view fields[5];
+                size_t count = splitFields(line, fields, 5);
+                if (count < 2 || count == 3) return "malformed line";
+                BookingRow row{0, fields[1], legacyNight, legacyNight + 1, 0};
+                if (!parseInt(fields[0], row.roomNumber)) return "invalid room number";
+                if (row.username.empty()) return "missing username";
+                if (count >= 4 && (!fields[2].empty() || !fields[3].empty()) &&
+                    (!parseDate(fields[2], row.checkIn) || !parseDate(fields[3], row.checkOut) ||
+                     row.checkOut <= row.checkIn)) {
+                    return "invalid dates";
                 }
-                catch (const invalid_argument& e) {
-                    cout << "Error: Invalid room number '" << roomStr 
-                         << "'. " << e.what() << "\n";
-                    continue; // Skip invalid entries
+                if (count == 5 && (!parseInt(fields[4], row.price) || row.price < 0)) return "invalid price";
+                rows.push_back(row);
+                return nullptr;
+            }, errors, lines);
+
+        // Reservations go in sequentially: overlaps depend on file order
+        for (const auto& chunk : chunks) {
+            for (const BookingRow& row : chunk) {
+                RoomId id = rooms.find(row.roomNumber);
+                if (id == NO_ROOM) {
+                    errors.add(0, "room " + to_string(row.roomNumber) + " does not exist");
                 }
-                catch (const out_of_range& e) {
-                    cout << "Error: Room number '" << roomStr 
-                         << "' is out of range. " << e.what() << "\n";
-                    continue; // Skip out-of-range entries
+                else if (!addBooking(id, {string(row.username), row.checkIn, row.checkOut, row.price})) {
+                    errors.add(0, "room " + to_string(row.roomNumber) + " from " + formatDate(row.checkIn) +
+                                  " overlaps another booking");
                 }
             }
-            else {
-                cout << "Error: Malformed line '" << line 
-                     << "'. Skipping.\n";
-            }
         }
-        file.close();
+        errors.report(BOOKINGS_FILE, lines);
     }
 
     // Save bookings to bookings.txt
-    void saveBookingsToFile() {
-        ofstream file(BOOKINGS_FILE);
+    bool saveBookingsToFile() {
+        TIME_OPERATION(Metric::SAVE_BOOKINGS);
+        const string tmpFile = BOOKINGS_FILE + ".tmp";
+        ofstream file(tmpFile);
         if (!file) {
-            cout << "Error opening " << BOOKINGS_FILE << " for writing.\n";
-            return;
+            cout << "Error opening " << tmpFile << " for writing.\n";
+            return false;
         }
-        for (const auto& [roomNumber, username] : bookings) {
-            // Format: roomNumber,username
-            file << roomNumber << "," << username << "\n";
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            for (const auto& booking : bookings[id]) {
+                // Format: roomNumber,username,checkIn,checkOut,price
+                file << rooms.getNumber(id) << "," << booking.username << ","
+                     << formatDate(booking.checkIn) << "," << formatDate(booking.checkOut) << ","
+                     << booking.price << "\n";
+            }
         }
-        file.close();
+        return closeAndReplace(file, tmpFile, BOOKINGS_FILE);
     }
 
-    // Reporting Methods
-    void generateOccupancyReport() const {
-        int totalRooms = rooms.size();
-        int bookedRooms = bookings.size();
-        double occupancyRate = (static_cast<double>(bookedRooms) / totalRooms) * 100.0;
-
-        cout << "\n=== Occupancy Report ===\n";
-        cout << "Total Rooms: " << totalRooms << endl;
-        cout << "Booked Rooms: " << bookedRooms << endl;
-        cout << "Available Rooms: " << (totalRooms - bookedRooms) << endl;
-        cout << fixed << setprecision(2) << "Occupancy Rate: " << occupancyRate << "%" << endl;
+    // Reservation bookkeeping shared by the menus and journal replay
+
+    // Size the calendar and booking lists for the current rooms, starting tonight. Rooms the data
+    // files flagged booked are held until a reservation is loaded for them: files written before
+    // the calendar flag a guest's room without dates, and such a room stays occupied until checkout.
+    void resetBookings() {
+        bookings.assign(rooms.size(), {});
+        customerBookings.clear();
+        heldRooms.assign(rooms.size(), 0);
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            heldRooms[id] = rooms.isBooked(id);
+        }
+        calendar.reset(todayDayNumber(), rooms);
+        pricing.reset(calendar.getFirstNight(), rooms);
+        counters.reset(rooms);
     }
 
-    void generatePopularRoomTypesReport() const {
-        unordered_map<string, int> roomTypeCount;
+    // Flag a room booked while a stay covers tonight (or it is held) and keep the
+    // free-room sets, report counters and the published view in step
+    void refreshOccupancy(RoomId id) {
+        const int tonight = calendar.getFirstNight();
+        const bool occupied = heldRooms[id] || !calendar.isFree(id, tonight, tonight + 1);
+        if (occupied == rooms.isBooked(id)) return;
+        rooms.setBooked(id, occupied);
+        if (occupied) {
+            counters.occupyRoom(rooms.getType(id), rooms.getFloor(id));
+        }
+        else {
+            counters.releaseRoom(rooms.getType(id), rooms.getFloor(id));
+        }
+        availabilityView.publishRoom(id, rooms, counters);
+    }
 
-        for (const auto& [roomNumber, username] : bookings) {
-            auto it = rooms.find(roomNumber);
-            if (it != rooms.end()) {
-                string roomType = it->second->getRoomType();
-                roomTypeCount[roomType]++;
+    // Start the calendar and rate horizon tonight and book every stay into it again. A hotel that
+    // runs for days would otherwise keep the horizon it opened with, and refuse ever more of the
+    // nights ahead. Stays already under way keep only their remaining nights, as at startup.
+    void slideHorizon() {
+        nextHorizonCheck = time(nullptr) + 60;
+        const int today = todayDayNumber();
+        if (today <= calendar.getFirstNight()) return;
+        calendar.reset(today, rooms);
+        pricing.reset(today, rooms);
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            for (const Booking& booking : bookings[id]) {
+                calendar.book(id, booking.checkIn, booking.checkOut);
+                pricing.addStay(rooms.getType(id), booking.checkIn, booking.checkOut);
             }
+            refreshOccupancy(id); // Last night's guest may have left, tonight's may arrive
         }
+    }
 
-        // Sort room types by popularity
-        vector<pair<string, int>> sortedRoomTypes(roomTypeCount.begin(), roomTypeCount.end());
-        sort(sortedRoomTypes.begin(), sortedRoomTypes.end(),
-            [](const pair<string, int>& a, const pair<string, int>& b) -> bool {
-                return a.second > b.second;
-            });
+    // Loyalty points earned (or lost on cancellation) by a stay: a tenth of what it was charged
+    static int bookingPoints(const Booking& booking) {
+        return booking.price / 10;
+    }
+
+    // What a stay in a room costs at the current rates and the customer's tier
+    int32_t stayPrice(RoomId id, CustomerId customer, int checkIn, int checkOut) const {
+        return static_cast<int32_t>(pricing.quote(rooms.getType(id), customerAt(customer).getTier(), checkIn, checkOut));
+    }
 
-        cout << "\n=== Popular Room Types Report ===\n";
-        if (sortedRoomTypes.empty()) {
-            cout << "No bookings yet.\n";
+    int loyaltyPointsOf(CustomerId customer) const { return loyalty.balance(customers.getAccount(customer)); }
+
+    // Record a change to a customer's points and keep the hotel-wide balance in step.
+    // A chain property has the change made by the hotel holding the customers and numbers it:
+    // that hotel journals it as a P record, and the property's next record carries it too.
+    void adjustLoyaltyPoints(CustomerId customer, int delta) {
+        if (!ownsCustomers()) {
+            if (delta == 0) return;
+            customerHome->adjustLoyaltyPoints(customer, delta);
+            const string username(customers.getUsername(customer));
+            customerHome->appendPropertyPoints(propertyName, username, delta, ++lastPointChange);
+            pointChangePrefix = "Q," + to_string(lastPointChange) + "," + username + "," + to_string(delta) + ",";
             return;
         }
+        const LoyaltyAccount account = customers.getAccount(customer);
+        int before = loyalty.balance(account);
+        if (delta > 0) {
+            loyalty.earn(account, delta, todayDayNumber());
+        }
+        else if (delta < 0) {
+            loyalty.reverse(account, -delta, todayDayNumber());
+        }
+        counters.changeLoyaltyBalance(loyalty.balance(account) - before);
+        availabilityView.publishTotals(counters);
+    }
 
-        cout << left << setw(20) << "Room Type" << setw(10) << "Bookings" << endl;
-        cout << "------------------------------\n";
-        for (const auto& [type, count] : sortedRoomTypes) {
-            cout << left << setw(20) << type << setw(10) << count << endl;
+    // Reserve a room; fails if any night is taken. A stay with no recorded price (from
+    // files written before stays were priced by the rate table) is charged the list price.
+    bool addBooking(RoomId id, Booking booking) {
+        if (!calendar.book(id, booking.checkIn, booking.checkOut)) {
+            return false;
         }
+        if (booking.price <= 0) {
+            booking.price = static_cast<int32_t>(rooms.getPrice(id) * (booking.checkOut - booking.checkIn));
+        }
+        pricing.addStay(rooms.getType(id), booking.checkIn, booking.checkOut);
+        vector<Booking>& stays = bookings[id];
+        auto pos = find_if(stays.begin(), stays.end(),
+                           [&booking](const Booking& b) { return b.checkIn > booking.checkIn; });
+        stays.insert(pos, booking);
+        customerBookings[booking.username].emplace_back(id, booking.checkIn);
+        heldRooms[id] = 0; // The room's reservations now tell when it is occupied
+        counters.addReservation(rooms.getType(id), booking.price, bookingPoints(booking));
+        refreshOccupancy(id);
+        availabilityView.publishRoom(id, rooms, counters);
+        return true;
     }
 
-public:
-    Hotel() {
-        loadCustomersFromFile();
-        loadRoomsFromFile();
-        loadBookingsFromFile();
-        if (rooms.empty()) {
-            initializeRooms();
-            saveRoomsToFile();
+    // Drop the reservation of a room starting on checkIn and archive it; the room is free again once it has none left.
+    // Replay passes the archive row the journal recorded for the stay, which a checkpoint may already have
+    // flushed before a crash kept the journal from being reset; such a stay is not archived twice.
+    bool removeBooking(RoomId id, int checkIn, Booking& removed, StayOutcome outcome, size_t archiveRow = SIZE_MAX) {
+        vector<Booking>& stays = bookings[id];
+        auto pos = find_if(stays.begin(), stays.end(),
+                           [checkIn](const Booking& b) { return b.checkIn == checkIn; });
+        if (pos == stays.end()) return false;
+
+        removed = *pos;
+        calendar.release(id, removed.checkIn, removed.checkOut);
+        pricing.removeStay(rooms.getType(id), removed.checkIn, removed.checkOut);
+        stays.erase(pos);
+
+        auto ownIt = customerBookings.find(removed.username);
+        if (ownIt != customerBookings.end()) {
+            vector<pair<RoomId, int>>& own = ownIt->second;
+            auto entry = find(own.begin(), own.end(), make_pair(id, checkIn));
+            if (entry != own.end()) {
+                *entry = own.back();
+                own.pop_back();
+            }
+            if (own.empty()) {
+                customerBookings.erase(ownIt);
+            }
         }
+        counters.removeReservation(rooms.getType(id), removed.price, bookingPoints(removed));
+        refreshOccupancy(id);
+        availabilityView.publishRoom(id, rooms, counters);
+        if (archiveRow < stayHistory.size()) return true;
+        stayHistory.add({rooms.getNumber(id), rooms.getType(id), customers.find(removed.username), removed.checkIn,
+                         removed.checkOut, removed.price, bookingPoints(removed), outcome});
+        return true;
     }
 
-    ~Hotel() {
-        saveCustomersToFile();
-        saveRoomsToFile();
-        saveBookingsToFile();
+    // The reservation that blocks a stay, if any
+    const Booking* findOverlappingBooking(RoomId id, int checkIn, int checkOut) const {
+        for (const auto& booking : bookings[id]) {
+            if (booking.checkIn < checkOut && checkIn < booking.checkOut) return &booking;
+        }
+        return nullptr;
     }
 
-    void initializeRooms() {
-        // Initialize rooms for 5 floors, each with 3 types
-        // Room numbers: 101, 102, 103; 201, 202, 203; ..., 501, 502, 503
-        for (int floor = 1; floor <= 5; ++floor) {
-            int base = floor * 100;
-            rooms[base + 1] = make_shared<StandardRoom>(base + 1);
-            rooms[base + 2] = make_shared<DeluxeRoom>(base + 2);
-            rooms[base + 3] = make_shared<SuiteRoom>(base + 3);
+    // Book a released room for the waiting requests it can serve, best first, and append them to served.
+    // Each is dropped from the waitlist (L record) and then booked like any other stay (B record).
+    void serveWaitlist(RoomId id, vector<WaitRequest>* served) {
+        if (waitlist.size() == 0) return;
+        auto fits = [this, id](const WaitRequest& request) {
+            return calendar.inHorizon(request.checkIn, request.checkOut) &&
+                   calendar.isFree(id, request.checkIn, request.checkOut);
+        };
+        while (const WaitRequest* best = waitlist.best(rooms.getType(id), rooms.getFloor(id), fits)) {
+            WaitRequest request = *best;
+            waitlist.remove(request.ticket);
+            logMutation("L," + to_string(request.ticket));
+            bookRoom(request.username, rooms.getNumber(id), request.checkIn, request.checkOut);
+            if (served) served->push_back(move(request));
         }
     }
 
-    void registerCustomer() {
-        string username, password, name, email, phone, adhaar;
+    // A handle for an id from a customer lookup; no customer for NO_CUSTOMER
+    Customer customerIfFound(CustomerId id) const { return id == NO_CUSTOMER ? Customer() : customerAt(id); }
+
+    // Journal and Checkpoints
+    // Record formats (fields separated by ',', dates as YYYY-MM-DD):
+    //   R,username,name,email,phone,adhaar,password                    registration
+    //   B,room,username,pointsEarned,pointsTotal,checkIn,checkOut,price  booking
+    //   C,room,username,pointsLost,pointsTotal,checkIn                 cancellation
+    //   G,username,pointsEarned,pointsTotal,checkIn,checkOut,room:price,...  group booking
+    //   P,username,pointsChange,pointsTotal                           points changed at another chain property
+    //   O,room[,checkIn]                                                checkout
+    //   W,ticket,username,type,floor,checkIn,checkOut,tier             joined the waitlist
+    //   L,ticket                                                       left the waitlist (or was given a room)
+    // Loyalty changes carry the resulting total so replay is idempotent. A chain property
+    // ignores the totals in its own records: its point changes are replayed from P records
+    // in the journal of the hotel holding the customers.
+
+    // Append a record and wait for it to be durable; checkpoint when the journal grows large.
+    // A chain property also waits for the P records it appended at the customers' hotel.
+    void logMutation(const string& record) {
+        uint64_t lsn = journal.append(pointChangePrefix + record);
+        pointChangePrefix.clear();
+        if (deferCommits) {
+            return;
+        }
+        bool saved = journal.commit(lsn);
+        if (!ownsCustomers()) saved = customerHome->syncJournal() && saved;
+        if (!saved) {
+            throw BookingException("The change was made but could not be saved to " + JOURNAL_FILE +
+                                   "; it will be lost if the system stops before the next checkpoint.");
+        }
+        checkpointIfDue();
+        if (!ownsCustomers()) customerHome->checkpointIfDue();
+    }
 
-        cout << "=== User Registration ===\n";
-        cout << "Enter username: ";
-        getline(cin, username);
+    // Journal, at the customers' hotel, a point change a chain property made
+    void appendPropertyPoints(const string& property, const string& username, int delta, uint64_t change) {
+        CustomerId customer = customers.find(username);
+        journal.append("P," + username + "," + to_string(delta) + "," + to_string(loyaltyPointsOf(customer)) + "," +
+                       property + "," + to_string(change));
+        PropertyPoints& points = propertyPoints[property];
+        points.last = max(points.last, change);
+    }
 
-        if (customers.find(username) != customers.end()) {
-            cout << "Username already exists. Please choose a different username.\n";
+    // Replay a property's Q record: the booking change it wraps, then its point change at the
+    // customers' hotel unless that hotel already has it (its P record was replayed or checkpointed)
+    void applyPointChange(const string& record, const vector<string>& fields) {
+        size_t innerStart = 0; // Just past the fourth comma
+        for (int field = 0; field < 4 && innerStart != string::npos; ++field) {
+            innerStart = record.find(',', innerStart);
+            if (innerStart != string::npos) ++innerStart;
+        }
+        uint64_t change;
+        int delta;
+        if (fields.size() < 5 || innerStart == string::npos || !parseInt(fields[3], delta) ||
+            from_chars(fields[1].data(), fields[1].data() + fields[1].size(), change).ec != errc()) {
+            cout << "Error: Malformed journal record '" << record << "'.\n";
             return;
         }
+        applyJournalRecord(record.substr(innerStart));
+        replayedPointChanges.insert(change);
+        lastPointChange = max(lastPointChange, change);
+        if (ownsCustomers()) return;
+
+        PropertyPoints& home = customerHome->propertyPoints[propertyName];
+        CustomerId customer = customers.find(fields[2]);
+        if (change <= home.checkpointed || home.replayed.count(change) || customer == NO_CUSTOMER) return;
+        customerHome->adjustLoyaltyPoints(customer, delta);
+        customerHome->appendPropertyPoints(propertyName, fields[2], delta, change);
+    }
 
-        cout << "Enter password: ";
-        getline(cin, password);
+    // Undo the point changes the customers' hotel replayed for this property whose Q records
+    // were lost; returns true if any was undone
+    bool reconcilePointChanges() {
+        PropertyPoints& home = customerHome->propertyPoints[propertyName];
+        bool undone = false;
+        for (const auto& [change, made] : home.replayed) {
+            CustomerId customer = customers.find(made.first);
+            if (change <= checkpointedPointChange || replayedPointChanges.count(change) || customer == NO_CUSTOMER) continue;
+            customerHome->adjustLoyaltyPoints(customer, -made.second);
+            customerHome->logMutation("P," + made.first + "," + to_string(-made.second) + "," +
+                                      to_string(loyaltyPointsOf(customer)));
+            undone = true;
+        }
+        // Never number a change again, even one whose record was lost
+        lastPointChange = max({lastPointChange, home.last, home.checkpointed});
+        home.replayed.clear();
+        replayedPointChanges.clear();
+        return undone;
+    }
 
-        cout << "Enter your full name: ";
-        getline(cin, name);
+    // Finish a temporary file written by a save and move it over the real one
+    static bool closeAndReplace(ofstream& file, const string& tmpFile, const string& path) {
+        file.close();
+        if (!file) {
+            cout << "Error writing to " << tmpFile << ".\n";
+            return false;
+        }
+        return durableReplace(tmpFile, path);
+    }
 
-        while (true) {
-            cout << "Enter your email: ";
-            getline(cin, email);
-            if (Validator::isValidEmail(email)) {
-                break;
-            }
-            else {
-                cout << "Invalid email format. Please try again.\n";
-            }
+    // Rewrite the text files and the snapshot, then start an empty journal.
+    // The snapshot is written last so that it is never older than the text files. Stays that
+    // ended since the last checkpoint go to the archive first: the O and C records name their
+    // archive rows, so replaying a journal that a crash kept from being reset skips rows already
+    // on file, and a stay missing from the files is always still in the journal.
+    // If any file cannot be replaced the journal is kept, so the next start still replays every change.
+    bool checkpoint() {
+        TIME_OPERATION(Metric::CHECKPOINT);
+        slideHorizon();
+        // Both halves of every chain point change this checkpoint captures must be on disk
+        // first, or a crash could leave points without their booking, or a booking without its points
+        bool paired = ownsCustomers() || customerHome->syncJournal();
+        for (Hotel* property : properties) {
+            paired = property->syncJournal() && paired;
+        }
+        if (!paired) {
+            cout << "Error: checkpoint skipped; the chain's journals could not be synced.\n";
+            return false;
         }
+        bool saved = stayHistory.flush();
+        saved = saveCustomersToFile() && saved;
+        saved = saveRoomsToFile() && saved;
+        saved = saveBookingsToFile() && saved;
+        appendLoyaltyHistory();
+        saved = saveWaitlistToFile() && saved;
+        saved = saveSnapshot() && saved;
+        if (!saved) {
+            cout << "Error: checkpoint incomplete; keeping " << JOURNAL_FILE << " so no change is lost.\n";
+            return false;
+        }
+        // The new journal records the last point changes of the chain that the checkpoint holds
+        vector<string> headers;
+        if (!ownsCustomers()) {
+            headers.push_back("#Q," + to_string(lastPointChange));
+        }
+        for (const auto& [property, points] : propertyPoints) {
+            headers.push_back("#S," + property + "," + to_string(points.last));
+        }
+        if (!journal.reset(headers)) return false;
+        snapshotStale = false;
+        return true;
+    }
 
-        while (true) {
-            cout << "Enter your phone number (10 digits): ";
-            getline(cin, phone);
-            if (Validator::isValidPhone(phone)) {
-                break;
-            }
-            else {
-                cout << "Invalid phone number. Please enter exactly 10 digits.\n";
-            }
+    // Move the ledger entries recorded since the last checkpoint to the history file.
+    // Entries after the last checkpoint are rebuilt by journal replay after a crash.
+    void appendLoyaltyHistory() {
+        if (!ownsCustomers()) return;
+        const vector<LedgerEntry>& entries = loyalty.getEntries();
+        if (entries.empty()) return;
+        ofstream file(LOYALTY_LEDGER_FILE, ios::app);
+        if (!file) {
+            cout << "Error opening " << LOYALTY_LEDGER_FILE << " for writing.\n";
+            return;
+        }
+        vector<string_view> usernames(loyalty.accountCount());
+        for (CustomerId id = 0; id < customers.size(); ++id) {
+            usernames[customers.getAccount(id)] = customers.getUsername(id);
+        }
+        // Format: date,username,kind,points
+        string buffer;
+        for (const LedgerEntry& entry : entries) {
+            if (usernames[entry.account].empty()) continue;
+            buffer += formatDate(entry.day);
+            buffer += ',';
+            buffer += usernames[entry.account];
+            buffer += ',';
+            buffer += LEDGER_KIND_NAMES[static_cast<size_t>(entry.kind)];
+            buffer += ',';
+            buffer += to_string(entry.points);
+            buffer += '\n';
+        }
+        file.write(buffer.data(), buffer.size());
+        file.close();
+        if (!file) {
+            cout << "Error writing to " << LOYALTY_LEDGER_FILE << ".\n";
+            return;
         }
+        loyalty.clearEntries();
+    }
 
-        while (true) {
-            cout << "Enter your Adhaar number (12 digits): ";
-            getline(cin, adhaar);
-            if (Validator::isValidAdhaar(adhaar)) {
-                break;
-            }
-            else {
-                cout << "Invalid Adhaar number. Please enter exactly 12 digits.\n";
-            }
+    // Format: ticket,username,type,floor,checkIn,checkOut,tier (the fields of a W record)
+    static string formatWaitRequest(const WaitRequest& request) {
+        return to_string(request.ticket) + "," + request.username + "," + roomTypeName(request.type) + "," +
+               to_string(request.floor) + "," + formatDate(request.checkIn) + "," + formatDate(request.checkOut) +
+               "," + to_string(static_cast<int>(request.tier));
+    }
+
+    // Parse the fields written by formatWaitRequest; false if they are malformed
+    static bool parseWaitRequest(const string_view* fields, WaitRequest& request) {
+        const char* ticketEnd = fields[0].data() + fields[0].size();
+        auto ticket = from_chars(fields[0].data(), ticketEnd, request.ticket);
+        int tier;
+        if (ticket.ec != errc() || ticket.ptr != ticketEnd || request.ticket == 0 || fields[1].empty() ||
+            !parseRoomType(fields[2], request.type) || !parseInt(fields[3], request.floor) ||
+            request.floor < ANY_FLOOR || !parseDate(fields[4], request.checkIn) ||
+            !parseDate(fields[5], request.checkOut) || request.checkOut <= request.checkIn ||
+            !parseInt(fields[6], tier) || tier < 0 || tier > static_cast<int>(LoyaltyTier::PLATINUM)) {
+            return false;
         }
+        request.username = string(fields[1]);
+        request.tier = static_cast<LoyaltyTier>(tier);
+        return true;
+    }
 
-        auto customer = make_shared<Customer>(name, email, phone, adhaar, password);
-        customers[username] = customer;
-        saveCustomersToFile();
-        cout << "Registration successful!\n";
+    bool saveWaitlistToFile() const {
+        // Nothing to write for a hotel that has never had anyone waiting
+        struct stat existing;
+        if (waitlist.size() == 0 && stat(WAITLIST_FILE.c_str(), &existing) != 0) return true;
+        const string tmpFile = WAITLIST_FILE + ".tmp";
+        ofstream file(tmpFile);
+        if (!file) {
+            cout << "Error opening " << tmpFile << " for writing.\n";
+            return false;
+        }
+        string buffer;
+        waitlist.forEach([&buffer](const WaitRequest& request) {
+            buffer += formatWaitRequest(request);
+            buffer += '\n';
+        });
+        file.write(buffer.data(), buffer.size());
+        return closeAndReplace(file, tmpFile, WAITLIST_FILE);
     }
 
-    shared_ptr<Customer> login() {
-        string username, password;
-        cout << "=== User Login ===\n";
-        cout << "Enter username: ";
-        getline(cin, username);
-        cout << "Enter password: ";
-        getline(cin, password);
+    // Requests for stays that start before the bookable horizon can no longer be served and are dropped
+    void loadWaitlistFromFile() {
+        waitlist.clear();
+        ifstream file(WAITLIST_FILE);
+        string line;
+        size_t lineNumber = 0;
+        while (getline(file, line)) {
+            ++lineNumber;
+            string_view fields[7];
+            WaitRequest request;
+            if (splitFields(line, fields, 7) != 7 || !parseWaitRequest(fields, request)) {
+                cout << "Warning: skipping malformed line " << lineNumber << " in " << WAITLIST_FILE << ".\n";
+            }
+            else if (request.checkIn >= calendar.getFirstNight()) {
+                waitlist.add(move(request));
+            }
+        }
+    }
 
-        auto it = customers.find(username);
-        if (it != customers.end()) {
-            if (it->second->getPassword() == password) {
-                cout << "Login successful! Welcome, " << it->second->getName() << "!\n";
-                return it->second;
+    bool saveSnapshot() const {
+        TIME_OPERATION(Metric::SAVE_SNAPSHOT);
+        SnapshotWriter writer;
+        writer.reserve(ownsCustomers() ? customers.size() : 0, rooms.size(), counters.getReservations());
+        if (ownsCustomers()) {
+            for (CustomerId id = 0; id < customers.size(); ++id) {
+                writer.addCustomer(customers.getUsername(id), customers.getName(id), customers.getEmail(id),
+                                   customers.getPhone(id), customers.getAdhaar(id), customers.getPassword(id),
+                                   loyaltyPointsOf(id), loyalty.getLastEarnDay(customers.getAccount(id)));
             }
-            else {
-                cout << "Incorrect password. Please try again.\n";
-                return nullptr;
+            writer.setLastClosedDay(loyalty.getLastClosedDay());
+        }
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            writer.addRoom(rooms.getNumber(id), static_cast<uint8_t>(rooms.getType(id)), rooms.isBooked(id));
+        }
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            for (const auto& booking : bookings[id]) {
+                writer.addBooking(rooms.getNumber(id), booking.username, booking.checkIn, booking.checkOut, booking.price);
             }
         }
-        else {
-            cout << "Username not found. Please register first.\n";
-            return nullptr;
+        return writer.write(SNAPSHOT_FILE);
+    }
+
+    // True if the snapshot exists and no text file was modified after it (text edits are imports)
+    bool snapshotIsCurrent() const {
+        struct stat snap, text;
+        if (stat(SNAPSHOT_FILE.c_str(), &snap) != 0) return false;
+        for (const string& file : {CUSTOMERS_FILE, ROOMS_FILE, BOOKINGS_FILE}) {
+            if (stat(file.c_str(), &text) == 0 &&
+                (text.st_mtim.tv_sec > snap.st_mtim.tv_sec ||
+                 (text.st_mtim.tv_sec == snap.st_mtim.tv_sec && text.st_mtim.tv_nsec > snap.st_mtim.tv_nsec))) {
+                return false;
+            }
         }
+        return true;
     }
 
-    void userMenu(shared_ptr<Customer> customer) {
-        if (!customer) return;
+    // Load customers, rooms and bookings from the snapshot; false if it is missing or invalid
+    bool loadSnapshot() {
+        TIME_OPERATION(Metric::LOAD_SNAPSHOT);
+        if (!snapshotIsCurrent()) return false;
+        SnapshotReader snapshot;
+        if (!snapshot.open(SNAPSHOT_FILE)) return false;
+
+        vector<pair<int, RoomType>> roomList;
+        roomList.reserve(snapshot.roomCount());
+        const SnapshotRoom* snapRooms = snapshot.getRooms();
+        for (size_t i = 0; i < snapshot.roomCount(); ++i) {
+            if (!RoomInventory::isValidNumber(snapRooms[i].number) || snapRooms[i].type >= ROOM_TYPE_COUNT) {
+                cout << "Warning: ignoring snapshot " << SNAPSHOT_FILE << ": invalid room record.\n";
+                return false;
+            }
+            roomList.emplace_back(snapRooms[i].number, static_cast<RoomType>(snapRooms[i].type));
+        }
 
-        int userChoice;
-        do {
-            cout << "\n=== User Menu ===\n";
-            cout << "1. View Available Rooms\n";
-            cout << "2. Book Room\n";
-            cout << "3. Cancel Booking\n";
-            cout << "4. View Loyalty Points\n";
-            cout << "5. Logout\n";
-            cout << "Enter your choice: ";
-            cin >> userChoice;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+        // A chain property's snapshot has no customers; they belong to the hotel holding them
+        if (ownsCustomers()) {
+            customers.clear();
+            customers.reserve(snapshot.customerCount());
+            loyalty.clear();
+            loyalty.reserve(snapshot.customerCount());
+            loyalty.setLastClosedDay(snapshot.lastClosedDay());
+            const int today = todayDayNumber();
+            int64_t balance = 0;
+            const SnapshotCustomer* snapCustomers = snapshot.getCustomers();
+            for (size_t i = 0; i < snapshot.customerCount(); ++i) {
+                const SnapshotCustomer& c = snapCustomers[i];
+                string_view username = snapshot.str(c.username);
+                if (customers.find(username) != NO_CUSTOMER) continue; // The writer never repeats a username
+                LoyaltyAccount account = loyalty.open(c.loyaltyPoints, c.lastEarnDay != 0 ? c.lastEarnDay : today);
+                customers.add(username, snapshot.str(c.name), snapshot.str(c.email), snapshot.str(c.phone),
+                              snapshot.str(c.adhaar), snapshot.str(c.password), account);
+                balance += loyalty.balance(account);
+            }
+            counters.setLoyaltyBalance(balance);
+        }
 
-            switch (userChoice) {
-                case 1:
-                    viewAvailableRooms();
-                    break;
-                case 2:
-                    bookRoom(customer);
-                    break;
-                case 3:
-                    cancelBooking(customer);
-                    break;
-                case 4:
-                    cout << "Loyalty Points: " << customer->getLoyaltyPoints() << endl;
-                    break;
-                case 5:
-                    cout << "Logging out...\n";
-                    break;
-                default:
-                    cout << "Invalid choice. Please try again.\n";
+        rooms.assign(roomList);
+        for (size_t i = 0; i < snapshot.roomCount(); ++i) {
+            rooms.setBooked(rooms.find(snapRooms[i].number), snapRooms[i].booked != 0);
+        }
+        resetBookings();
+        const SnapshotBooking* snapBookings = snapshot.getBookings();
+        for (size_t i = 0; i < snapshot.bookingCount(); ++i) {
+            const SnapshotBooking& b = snapBookings[i];
+            RoomId id = rooms.find(b.roomNumber);
+            if (id == NO_ROOM || !addBooking(id, {string(snapshot.str(b.username)), b.checkIn, b.checkOut,
+                                                static_cast<int32_t>(b.price)})) {
+                cout << "Warning: skipping invalid booking for room " << b.roomNumber << " in snapshot.\n";
             }
-        } while (userChoice != 5);
+        }
+        return true;
     }
 
-   // Admin Menu
-    void adminMenu() {
-        int adminChoice;
-        do {
-            cout << "\n=== Admin Menu ===\n";
-            cout << "1. View Customer Details\n";
-            cout << "2. View Customer Bookings\n";
-            cout << "3. Generate Occupancy Report\n";
-            cout << "4. Generate Popular Room Types Report\n";
-            cout << "5. Checkout Room\n";
-            cout << "6. Logout\n";
-            cout << "Enter your choice: ";
-            cin >> adminChoice;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+    // Apply one journal record to the in-memory state (used during startup replay)
+    void applyJournalRecord(const string& record) {
+        vector<string> fields;
+        splitJournalRecord(record, fields);
+        const string& kind = fields[0];
+
+        if (kind == "R" && fields.size() == 7) {
+            // Already present if the record made it into the last checkpoint
+            if (customers.find(fields[1]) == NO_CUSTOMER) {
+                customers.add(fields[1], fields[2], fields[3], fields[4], fields[5], fields[6],
+                              loyalty.open(0, todayDayNumber()));
+            }
+            return;
+        }
 
-            switch (adminChoice) {
-                case 1:
-                    viewCustomerDetails();
-                    break;
-                case 2:
-                    viewCustomerBookings();
-                    break;
-                case 3:
-                    generateOccupancyReport();
-                    break;
-                case 4:
-                    generatePopularRoomTypesReport();
-                    break;
-                case 5:
-                    checkoutRoom();
-                    break;
-                case 6:
-                    cout << "Logging out from admin account...\n";
-                    break;
-                default:
-                    cout << "Invalid choice. Please try again.\n";
+        if (kind == "G") {
+            applyGroupRecord(record, fields);
+            return;
+        }
+
+        if (kind == "W") {
+            string_view requestFields[7];
+            for (size_t i = 0; i < 7 && i + 1 < fields.size(); ++i) requestFields[i] = fields[i + 1];
+            WaitRequest request;
+            if (fields.size() != 8 || !parseWaitRequest(requestFields, request)) {
+                cout << "Error: Malformed journal record '" << record << "'.\n";
+                return;
             }
-        } while (adminChoice != 6);
-    }
-   // Room Management
-    void checkoutRoom() {
-        int roomNumber;
-        cout << "Enter room number to checkout (e.g., 101): ";
-        cin >> roomNumber;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+            // Already waiting if the record made it into the last checkpoint
+            waitlist.add(move(request));
+            return;
+        }
 
-        auto it = rooms.find(roomNumber);
-        if (it != rooms.end()) {
-            if (it->second->getIsBooked()) {
-                // Remove from bookings map
-                auto bookingIt = bookings.find(roomNumber);
-                if (bookingIt != bookings.end()) {
-                    string username = bookingIt->second;
-                    bookings.erase(bookingIt);
-                    cout << "Room " << roomNumber << " has been checked out by user '" << username << "' and is now available.\n";
-                } else {
-                    cout << "Room " << roomNumber << " was booked but no booking record found.\n";
-                }
-                it->second->setBooked(false);
-                saveRoomsToFile();
-                saveBookingsToFile();
+        if (kind == "L") {
+            // A request given a room is followed by that booking's own record, so nothing is re-assigned here
+            uint64_t ticket = fields.size() == 2 ? strtoull(fields[1].c_str(), nullptr, 10) : 0;
+            waitlist.remove(ticket);
+            return;
+        }
+
+        if (kind == "P") {
+            CustomerId customer = fields.size() == 4 || fields.size() == 6 ? customers.find(fields[1]) : NO_CUSTOMER;
+            int total, delta;
+            if (customer != NO_CUSTOMER && parseInt(fields[3], total)) {
+                adjustLoyaltyPoints(customer, total - loyaltyPointsOf(customer));
             }
-            else {
-                cout << "Room " << roomNumber << " is already available.\n";
+            // A chain property's change, kept until the property has replayed its own records
+            uint64_t change;
+            if (fields.size() == 6 && parseInt(fields[2], delta) &&
+                from_chars(fields[5].data(), fields[5].data() + fields[5].size(), change).ec == errc()) {
+                PropertyPoints& points = propertyPoints[fields[4]];
+                points.replayed[change] = {fields[1], delta};
+                points.last = max(points.last, change);
+            }
+            return;
+        }
+
+        if (kind == "Q") {
+            applyPointChange(record, fields);
+            return;
+        }
+
+        // Headers of a journal started by a checkpoint: the last point changes that checkpoint holds
+        uint64_t change;
+        if (kind == "#S" && fields.size() == 3 &&
+            from_chars(fields[2].data(), fields[2].data() + fields[2].size(), change).ec == errc()) {
+            PropertyPoints& points = propertyPoints[fields[1]];
+            points.checkpointed = max(points.checkpointed, change);
+            points.last = max(points.last, change);
+            return;
+        }
+        if (kind == "#Q" && fields.size() == 2 &&
+            from_chars(fields[1].data(), fields[1].data() + fields[1].size(), change).ec == errc()) {
+            checkpointedPointChange = max(checkpointedPointChange, change);
+            lastPointChange = max(lastPointChange, change);
+            return;
+        }
+
+        int roomNumber, checkIn = 0, checkOut = 0;
+        if (fields.size() < 2 || !parseInt(fields[1], roomNumber)) {
+            cout << "Error: Malformed journal record '" << record << "'.\n";
+            return;
+        }
+        RoomId id = rooms.find(roomNumber);
+        if (id == NO_ROOM) {
+            cout << "Warning: Room number " << roomNumber << " in journal does not exist.\n";
+            return;
+        }
+
+        Booking removed;
+        if (kind == "O") {
+            if ((fields.size() == 3 || fields.size() == 4) && parseDate(fields[2], checkIn)) {
+                removeBooking(id, checkIn, removed, StayOutcome::CHECKED_OUT, archiveRowOf(fields, 3));
             }
+            else if (heldRooms[id]) {
+                heldRooms[id] = 0;
+                refreshOccupancy(id);
+            }
+            return;
+        }
+
+        int price = 0; // Records written before stays were priced have none
+        int pointsTotal;
+        bool valid = (kind == "B" && (fields.size() == 7 || fields.size() == 8) && parseDate(fields[5], checkIn) &&
+                      parseDate(fields[6], checkOut) && (fields.size() == 7 || parseInt(fields[7], price))) ||
+                     (kind == "C" && (fields.size() == 6 || fields.size() == 7) && parseDate(fields[5], checkIn));
+        if (!valid || !parseInt(fields[4], pointsTotal)) {
+            cout << "Error: Malformed journal record '" << record << "'.\n";
+            return;
+        }
+        const string& username = fields[2];
+        if (kind == "B") {
+            // Already present if the record made it into the last checkpoint
+            addBooking(id, {username, checkIn, checkOut, price});
         }
         else {
-            cout << "Invalid room number.\n";
+            const Booking* existing = findOverlappingBooking(id, checkIn, checkIn + 1);
+            if (existing && existing->username == username) {
+                removeBooking(id, checkIn, removed, StayOutcome::CANCELLED, archiveRowOf(fields, 6));
+            }
+        }
+        CustomerId customer = customers.find(username);
+        if (customer != NO_CUSTOMER && ownsCustomers()) {
+            adjustLoyaltyPoints(customer, pointsTotal - loyaltyPointsOf(customer));
+        }
+    }
+
+    // Archive row of the stay an O or C record ended; records written before rows were numbered have none
+    static size_t archiveRowOf(const vector<string>& fields, size_t index) {
+        if (index >= fields.size()) return SIZE_MAX;
+        const string& text = fields[index];
+        size_t row;
+        auto parsed = from_chars(text.data(), text.data() + text.size(), row);
+        return parsed.ec == errc() && parsed.ptr == text.data() + text.size() ? row : SIZE_MAX;
+    }
+
+    // Replay a group booking: reserve each room that is not already held, then restore the points total
+    void applyGroupRecord(const string& record, const vector<string>& fields) {
+        int checkIn, checkOut;
+        if (fields.size() < 7 || !parseDate(fields[4], checkIn) || !parseDate(fields[5], checkOut)) {
+            cout << "Error: Malformed journal record '" << record << "'.\n";
+            return;
+        }
+        const string& username = fields[1];
+        for (size_t i = 6; i < fields.size(); ++i) {
+            // room:price, or just the room in records written before stays were priced
+            string_view room = fields[i];
+            int roomNumber, price = 0;
+            size_t colon = room.find(':');
+            bool parsed = colon == string_view::npos || parseInt(room.substr(colon + 1), price);
+            RoomId id = parsed && parseInt(room.substr(0, colon), roomNumber) ? rooms.find(roomNumber) : NO_ROOM;
+            if (id == NO_ROOM) {
+                cout << "Warning: Room '" << fields[i] << "' in journal does not exist.\n";
+                continue;
+            }
+            // Already present if the record made it into the last checkpoint
+            addBooking(id, {username, checkIn, checkOut, price});
+        }
+        CustomerId customer = customers.find(username);
+        int total;
+        if (customer != NO_CUSTOMER && ownsCustomers() && parseInt(fields[3], total)) {
+            adjustLoyaltyPoints(customer, total - loyaltyPointsOf(customer));
         }
     }
 
-    void viewAvailableRooms() const {
-        // Organize rooms by floor
-        map<int, vector<shared_ptr<Room>>> floors; // Use map to maintain order
-        for (const auto& [number, room] : rooms) {
-            if (!room->getIsBooked()) {
-                int floor = number / 100;
-                floors[floor].push_back(room);
+    // Reporting Methods
+    void generateOccupancyReport() const {
+        TIME_OPERATION(Metric::OCCUPANCY_REPORT);
+        printOccupancyReport(counters);
+    }
+
+    void generatePopularRoomTypesReport() const {
+        TIME_OPERATION(Metric::POPULAR_TYPES_REPORT);
+        printPopularRoomTypes(getPopularRoomTypes());
+    }
+
+public:
+    Hotel() : Hotel("", nullptr) {}
+
+    // A hotel keeping all of its files in dataDir, which is empty or ends in '/'
+    explicit Hotel(const string& dataDir) : Hotel(dataDir, nullptr) {}
+
+    /**
+     * @brief A property of a HotelChain.
+     * @param dataDir Directory holding the property's rooms, bookings, journal and snapshot.
+     * @param customerHome Hotel whose customers book here and which keeps their points.
+     * @param name Name of the property within the chain; it tags the point changes made here.
+     */
+    Hotel(const string& dataDir, Hotel& customerHome, const string& name) : Hotel(dataDir, &customerHome, name) {}
+
+private:
+    Hotel(const string& dataDir, Hotel* home, const string& name = "")
+        : customerHome(home ? home : this), customers(home ? home->ownCustomers : ownCustomers),
+          loyalty(home ? home->ownLoyalty : ownLoyalty), dataDir(dataDir), journal(JOURNAL_FILE),
+          stayHistory(HISTORY_DIR), propertyName(name) {
+        // Start from the binary snapshot; the text files are the fallback and import format
+        if (!loadSnapshot()) {
+            snapshotStale = true;
+            loadCustomersFromFile();
+            loadRoomsFromFile();
+            if (rooms.empty()) {
+                initializeRooms();
+                saveRoomsToFile();
             }
+            resetBookings();
+            loadBookingsFromFile();
+        }
+        loadWaitlistFromFile();
+        // Replay mutations made since the last checkpoint on top of the loaded state
+        size_t replayed = journal.recover([this](const string& record) { applyJournalRecord(record); });
+        if (replayed > 0) {
+            cout << "Recovered " << replayed << " journal records.\n";
+        }
+        if (!ownsCustomers()) {
+            customerHome->properties.push_back(this);
+            if (reconcilePointChanges()) ++replayed;
+        }
+        if (replayed > 0) {
+            checkpoint();
+        }
+        // Terminals see the hotel only once it is fully loaded; from here on every change is published
+        availabilityView.open(availabilityViewName(dataDir), rooms, counters);
+    }
+
+public:
+    ~Hotel() {
+        // Nothing to write if the files on disk already match memory
+        if (snapshotStale || journal.recordsSinceCheckpoint() > 0) {
+            checkpoint();
+        }
+        if (!ownsCustomers()) {
+            auto& open = customerHome->properties;
+            open.erase(remove(open.begin(), open.end(), this), open.end());
         }
+    }
 
-        // Display rooms floor by floor in order
-        for (const auto& [floor, roomsOnFloor] : floors) {
-            cout << "\n--- Floor " << floor << " ---\n";
-            cout << left << setw(10) << "Room No" << setw(15) << "Type" << endl;
-            cout << "------------------------------\n";
-            for (const auto& room : roomsOnFloor) {
-                cout << left << setw(10) << room->getRoomNumber()
-                     << setw(15) << room->getRoomType()
-                     << endl;
+    void initializeRooms(int floors = 5, int roomsPerFloor = 3) {
+        // By default 5 floors, each with 3 types
+        // Room numbers: 101, 102, 103; 201, 202, 203; ..., 501, 502, 503
+        // Types repeat Standard, Deluxe, Suite along each floor
+        if (floors < 1 || roomsPerFloor < 1 || roomsPerFloor >= RoomInventory::FLOOR_STRIDE) {
+            throw BookingException("A floor holds 1 to " + to_string(RoomInventory::FLOOR_STRIDE - 1) + " rooms.");
+        }
+        if (floors > RoomInventory::MAX_FLOOR) {
+            throw BookingException("A hotel has at most " + to_string(RoomInventory::MAX_FLOOR) + " floors.");
+        }
+        vector<pair<int, RoomType>> roomList;
+        roomList.reserve(static_cast<size_t>(floors) * roomsPerFloor);
+        for (int floor = 1; floor <= floors; ++floor) {
+            int base = floor * RoomInventory::FLOOR_STRIDE;
+            for (int slot = 1; slot <= roomsPerFloor; ++slot) {
+                roomList.emplace_back(base + slot, static_cast<RoomType>((slot - 1) % ROOM_TYPE_COUNT));
             }
         }
+        rooms.assign(roomList);
     }
 
-    int getValidatedRoomNumber() const {
-        string input;
-        int roomNumber;
+    // Prompt-free operations
+    // Used by the menus and by batch mode. Failures throw BookingException with a user-facing message.
 
-        while (true) {
-            cout << "Enter room number: ";
-            getline(cin, input);
+    void registerCustomer(const string& username, const string& password, const string& name,
+                          const string& email, const string& phone, const string& adhaar) {
+        if (!ownsCustomers()) {
+            customerHome->registerCustomer(username, password, name, email, phone, adhaar);
+            return;
+        }
+        TIME_OPERATION(Metric::REGISTER);
+        if (username.empty()) {
+            throw BookingException("Username cannot be empty.");
+        }
+        // The username keys the rows of every data file and journal record
+        if (username.find_first_of(",\r\n") != string::npos) {
+            throw BookingException("Username cannot contain commas or line breaks.");
+        }
+        if (customers.find(username) != NO_CUSTOMER) {
+            throw BookingException("Username already exists. Please choose a different username.");
+        }
+        if (!Validator::isValidEmail(email)) {
+            throw BookingException("Invalid email format.");
+        }
+        if (!Validator::isValidPhone(phone)) {
+            throw BookingException("Invalid phone number. Please enter exactly 10 digits.");
+        }
+        if (!Validator::isValidAdhaar(adhaar)) {
+            throw BookingException("Invalid Adhaar number. Please enter exactly 12 digits.");
+        }
+        if (customers.findByEmail(email) != NO_CUSTOMER) {
+            throw BookingException("Email already registered.");
+        }
+        if (customers.findByPhone(phone) != NO_CUSTOMER) {
+            throw BookingException("Phone number already registered.");
+        }
+        if (customers.findByAdhaar(adhaar) != NO_CUSTOMER) {
+            throw BookingException("Adhaar number already registered.");
+        }
 
-            // Trim whitespace
-            input.erase(remove_if(input.begin(), input.end(), ::isspace), input.end());
+        customers.add(username, name, email, phone, adhaar, password, loyalty.open(0, todayDayNumber()));
+        // Names and passwords are free text, so their commas are escaped
+        string record = "R";
+        for (const string* field : {&username, &name, &email, &phone, &adhaar, &password}) {
+            appendJournalField(record, *field);
+        }
+        logMutation(record);
+    }
 
-            try {
-                roomNumber = stoi(input);
-                if (rooms.find(roomNumber) != rooms.end()) {
-                    return roomNumber;
+    // Register every valid, previously unseen customer of a CSV file
+    // (username,name,email,phone,adhaar,password per line) and persist them
+    // with one checkpoint. Rejected rows are written to rejectsPath as
+    // line,reason,original row.
+    ImportResult importCustomers(const string& path, const string& rejectsPath) {
+        if (!ownsCustomers()) {
+            return customerHome->importCustomers(path, rejectsPath);
+        }
+        TIME_OPERATION(Metric::IMPORT_CUSTOMERS);
+        MappedFile file;
+        if (!file.open(path)) {
+            throw BookingException("Cannot open " + path + " for import.");
+        }
+        struct ImportRow {
+            size_t line;
+            string_view text;     // Points into the mapped file
+            const char* reason;   // Why the fields were rejected, if they were
+            bool valid;           // Set if the fields are valid
+            string_view fields[6]; // The fields in the mapped file, if valid
+        };
+        // Fields are validated on every core
+        LoadErrors parseErrors; // Stays empty: rejections are kept on the rows
+        ImportResult result;
+        auto chunks = parseLinesInParallel<ImportRow>(file.view(),
+            [](string_view line, size_t lineNumber, vector<ImportRow>& rows) -> const char* {
+                ImportRow row{lineNumber, line, nullptr, false, {}};
+                string_view* fields = row.fields;
+                if (splitFields(line, fields, 6) != 6) row.reason = "expected 6 fields";
+                else if (fields[0].empty()) row.reason = "missing username";
+                else if (!Validator::isValidEmail(fields[2])) row.reason = "invalid email";
+                else if (!Validator::isValidPhone(fields[3])) row.reason = "invalid phone number";
+                else if (!Validator::isValidAdhaar(fields[4])) row.reason = "invalid Adhaar number";
+                else row.valid = true;
+                rows.push_back(row);
+                return nullptr;
+            }, parseErrors, result.rows);
+        vector<ImportRow> rows;
+        rows.reserve(result.rows);
+        for (auto& chunk : chunks) {
+            move(chunk.begin(), chunk.end(), back_inserter(rows));
+            vector<ImportRow>().swap(chunk);
+        }
+        if (customers.size() + rows.size() >= UINT32_MAX) {
+            throw BookingException("Import would exceed 4294967294 customers.");
+        }
+
+        // Rows are accepted in file order, as separate registrations would be: a row is
+        // rejected if any of its keys is already registered or held by an earlier accepted
+        // row, and only an accepted row claims its keys. The lookups are done up front,
+        // one key per thread: registered[k][i] is set if row i's value is in the customer
+        // table, and group[k][i] is the first row with the same value, so rows sharing a
+        // value share a group.
+        constexpr size_t KEYS = 4;
+        constexpr size_t KEY_FIELD[KEYS] = {0, 2, 3, 4};
+        constexpr uint32_t NO_ROW = UINT32_MAX;
+        auto isRegistered = [this](size_t k, string_view key) -> bool {
+            switch (k) {
+                case 0: return customers.find(key) != NO_CUSTOMER;
+                case 1: return customers.findByEmail(key) != NO_CUSTOMER;
+                case 2: return customers.findByPhone(key) != NO_CUSTOMER;
+                default: return customers.findByAdhaar(key) != NO_CUSTOMER;
+            }
+        };
+        vector<uint8_t> registered[KEYS];
+        vector<uint32_t> group[KEYS];
+        runInParallel(KEYS, [&](size_t k) {
+            vector<string_view> column;
+            vector<uint32_t> rowOf; // Column position -> row
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (!rows[i].valid) continue;
+                column.push_back(rows[i].fields[KEY_FIELD[k]]);
+                rowOf.push_back(static_cast<uint32_t>(i));
+            }
+
+            registered[k].assign(rows.size(), 0);
+            group[k].assign(rows.size(), NO_ROW);
+            StringViewIndex seen(column);
+            for (size_t p = 0; p < column.size(); ++p) {
+                registered[k][rowOf[p]] = isRegistered(k, column[p]);
+                group[k][rowOf[p]] = rowOf[seen.insert(static_cast<uint32_t>(p))];
+            }
+        });
+
+        static const char* const KEY_NAMES[KEYS] = {"username", "email", "phone number", "Adhaar number"};
+        vector<uint32_t> holder[KEYS]; // Group -> accepted row holding the value, or NO_ROW
+        for (size_t k = 0; k < KEYS; ++k) {
+            holder[k].assign(rows.size(), NO_ROW);
+        }
+        ofstream rejects;
+        const int today = todayDayNumber();
+        const size_t customersBefore = customers.size(), accountsBefore = loyalty.accountCount();
+        customers.reserve(customers.size() + rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            ImportRow& row = rows[i];
+            string reason = row.reason ? row.reason : "";
+            for (size_t k = 0; k < KEYS && reason.empty(); ++k) {
+                if (registered[k][i]) {
+                    reason = string(KEY_NAMES[k]) + " already registered";
                 }
-                else {
-                    cout << "Room number " << roomNumber << " does not exist. Please try again.\n";
+                else if (holder[k][group[k][i]] != NO_ROW) {
+                    reason = "duplicate " + string(KEY_NAMES[k]) + " (first on line " +
+                             to_string(rows[holder[k][group[k][i]]].line) + ")";
                 }
             }
-            catch (const invalid_argument& e) {
-                cout << "Invalid input. Please enter a valid numeric room number.\n";
+            if (reason.empty()) {
+                for (size_t k = 0; k < KEYS; ++k) {
+                    holder[k][group[k][i]] = static_cast<uint32_t>(i);
+                }
+                const string_view* fields = row.fields;
+                customers.add(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5],
+                              loyalty.open(0, today));
+                ++result.imported;
+                continue;
             }
-            catch (const out_of_range& e) {
-                cout << "Room number is out of range. Please enter a valid room number.\n";
+            if (result.rejected == 0) {
+                rejects.open(rejectsPath);
+                if (!rejects) {
+                    cout << "Error opening " << rejectsPath << " for writing.\n";
+                }
             }
+            rejects << row.line << "," << reason << "," << row.text << "\n";
+            ++result.rejected;
+        }
+        rejects.close();
+
+        // One persistence step for the whole import. The rows are not journaled, so if it
+        // fails they are dropped again rather than left to vanish at the next restart.
+        if (result.imported > 0 && !checkpoint()) {
+            customers.truncate(customersBefore);
+            loyalty.truncate(accountsBefore);
+            throw BookingException("The imported customers could not be saved; no customers were imported.");
         }
+        return result;
     }
-    // Booking and Cancellation
-    void bookRoom(shared_ptr<Customer> customer) {
-        // Show available rooms before booking
-        viewAvailableRooms();
 
-        int roomNumber = getValidatedRoomNumber();
+    Customer authenticate(const string& username, const string& password) const {
+        TIME_OPERATION(Metric::LOGIN);
+        CustomerId id = customers.find(username);
+        if (id == NO_CUSTOMER) {
+            throw BookingException("Username not found. Please register first.");
+        }
+        if (customers.getPassword(id) != password) {
+            throw BookingException("Incorrect password. Please try again.");
+        }
+        return customerAt(id);
+    }
 
-        auto it = rooms.find(roomNumber);
-        if (it != rooms.end()) {
-            if (!it->second->getIsBooked()) {
-                it->second->setBooked(true);
-                bookings[roomNumber] = getUsernameByCustomer(customer); // Associate room with username
-                int pointsEarned = static_cast<int>(it->second->getPrice() * 0.1);
-                customer->addLoyaltyPoints(pointsEarned);
-                saveCustomersToFile();
-                saveRoomsToFile();
-                saveBookingsToFile();
-                cout << "Room " << roomNumber << " booked successfully! You earned " << pointsEarned << " loyalty points.\n";
-            }
-            else {
-                cout << "Room " << roomNumber << " is already booked by user '" << bookings[roomNumber] << "'.\n";
-            }
+    // Book a room for the nights [checkIn, checkOut); returns the loyalty points earned
+    int bookRoom(const string& username, int roomNumber, int checkIn, int checkOut) {
+        TIME_OPERATION(Metric::BOOK);
+        CustomerId customer = customers.find(username);
+        if (customer == NO_CUSTOMER) {
+            throw BookingException("Username not found. Please register first.");
         }
-        else {
-            // This should not happen due to validation
-            cout << "Invalid room number.\n";
+        RoomId id = rooms.find(roomNumber);
+        if (id == NO_ROOM) {
+            throw BookingException("Room number " + to_string(roomNumber) + " does not exist.");
         }
+        if (!calendar.inHorizon(checkIn, checkOut)) {
+            throw BookingException("Stays must start today or later and end by " +
+                                   formatDate(calendar.getLastNight() + 1) + ".");
+        }
+        const Booking* conflict = findOverlappingBooking(id, checkIn, checkOut);
+        if (conflict) {
+            throw BookingException("Room " + to_string(roomNumber) + " is already booked from " +
+                                   formatDate(conflict->checkIn) + " to " + formatDate(conflict->checkOut) +
+                                   " by user '" + conflict->username + "'.");
+        }
+
+        // Charged the rate quoted before the stay itself raises the occupancy
+        Booking booking{username, checkIn, checkOut, stayPrice(id, customer, checkIn, checkOut)};
+        addBooking(id, booking); // Associate room with username
+        int pointsEarned = bookingPoints(booking);
+        adjustLoyaltyPoints(customer, pointsEarned);
+        logMutation("B," + to_string(roomNumber) + "," + username + "," +
+                    to_string(pointsEarned) + "," + to_string(loyaltyPointsOf(customer)) + "," +
+                    formatDate(checkIn) + "," + formatDate(checkOut) + "," + to_string(booking.price));
+        return pointsEarned;
     }
 
-    void cancelBooking(shared_ptr<Customer> customer) {
-        // Display rooms booked by this customer
-        vector<int> userRooms;
-        for (const auto& [roomNumber, username] : bookings) {
-            if (username == getUsernameByCustomer(customer)) {
-                userRooms.push_back(roomNumber);
-            }
+    /**
+     * @brief Book count rooms of a type for the same nights, all or nothing.
+     *
+     * The rooms are chosen in one pass over the calendar's free-room bits,
+     * stopping as soon as enough rooms are found. Points are awarded once
+     * for the whole group and the booking is one journal record. Each room
+     * can later be cancelled on its own.
+     */
+    GroupBooking bookRoomGroup(const string& username, RoomType type, int count, int checkIn, int checkOut,
+                               GroupPlacement placement) {
+        TIME_OPERATION(Metric::BOOK_GROUP);
+        CustomerId customer = customers.find(username);
+        if (customer == NO_CUSTOMER) {
+            throw BookingException("Username not found. Please register first.");
+        }
+        if (count < 1) {
+            throw BookingException("A group booking needs at least one room.");
+        }
+        if (!calendar.inHorizon(checkIn, checkOut)) {
+            throw BookingException("Stays must start today or later and end by " +
+                                   formatDate(calendar.getLastNight() + 1) + ".");
+        }
+        vector<RoomId> picked = pickGroupRooms(type, count, checkIn, checkOut, placement);
+        if (picked.empty()) {
+            static const char* const WHERE[] = {"", " on one floor", " next to each other"};
+            throw BookingException("Not enough " + string(roomTypeName(type)) + " rooms are free" +
+                                   WHERE[static_cast<size_t>(placement)] + " for " + to_string(count) +
+                                   " rooms from " + formatDate(checkIn) + " to " + formatDate(checkOut) + ".");
         }
 
-        if (userRooms.empty()) {
-            cout << "You have no bookings to cancel.\n";
-            return;
+        // Every room is charged the rate quoted for the group before any of it is booked
+        const Booking booking{username, checkIn, checkOut, stayPrice(picked.front(), customer, checkIn, checkOut)};
+        GroupBooking group;
+        group.roomNumbers.reserve(picked.size());
+        for (RoomId id : picked) {
+            addBooking(id, booking);
+            group.roomNumbers.push_back(rooms.getNumber(id));
+            group.points += bookingPoints(booking);
         }
+        adjustLoyaltyPoints(customer, group.points);
+
+        string record = "G," + username + "," + to_string(group.points) + "," +
+                        to_string(loyaltyPointsOf(customer)) + "," + formatDate(checkIn) + "," + formatDate(checkOut);
+        for (int roomNumber : group.roomNumbers) {
+            record += ',';
+            record += to_string(roomNumber);
+            record += ':';
+            record += to_string(booking.price);
+        }
+        logMutation(record);
+        return group;
+    }
 
-        cout << "\nYour Booked Rooms:\n";
-        cout << left << setw(10) << "Room No" << setw(15) << "Type" << endl;
-        cout << "------------------------------\n";
-        for (const auto& roomNumber : userRooms) {
-            cout << left << setw(10) << roomNumber
-                 << setw(15) << rooms[roomNumber]->getRoomType()
-                 << endl;
+    // Cancel the customer's stay in a room starting on checkIn; returns the loyalty points deducted.
+    // The freed nights go to the waitlist at once; requests given the room are appended to served.
+    int cancelBooking(const string& username, int roomNumber, int checkIn, vector<WaitRequest>* served = nullptr) {
+        TIME_OPERATION(Metric::CANCEL);
+        RoomId id = rooms.find(roomNumber);
+        const Booking* booking = id == NO_ROOM ? nullptr : findOverlappingBooking(id, checkIn, checkIn + 1);
+        if (!booking || booking->checkIn != checkIn || booking->username != username) {
+            throw BookingException("You do not have a booking for room " + to_string(roomNumber) +
+                                   " on " + formatDate(checkIn) + ".");
         }
 
-        int roomNumber;
-        cout << "\nEnter room number to cancel booking: ";
-        cin >> roomNumber;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+        Booking removed;
+        removeBooking(id, checkIn, removed, StayOutcome::CANCELLED);
+        CustomerId customer = customers.find(username);
+        int pointsDeducted = bookingPoints(removed);
+        adjustLoyaltyPoints(customer, -pointsDeducted);
+        logMutation("C," + to_string(roomNumber) + "," + username + "," +
+                    to_string(pointsDeducted) + "," + to_string(loyaltyPointsOf(customer)) + "," +
+                    formatDate(checkIn) + "," + to_string(stayHistory.size() - 1));
+        serveWaitlist(id, served);
+        return pointsDeducted;
+    }
 
-        auto it = bookings.find(roomNumber);
-        if (it != bookings.end() && it->second == getUsernameByCustomer(customer)) {
-            bookings.erase(it);
-            rooms[roomNumber]->setBooked(false);
-            int pointsDeducted = static_cast<int>(rooms[roomNumber]->getPrice() * 0.1);
-            customer->addLoyaltyPoints(-pointsDeducted);
-            saveCustomersToFile();
-            saveRoomsToFile();
-            saveBookingsToFile();
-            cout << "Booking for room " << roomNumber << " has been canceled. You lost " << pointsDeducted << " loyalty points.\n";
+    // End the stay in a room that covers tonight. The returned booking has an empty
+    // username if the room was flagged as booked without a booking record. Freed
+    // nights go to the waitlist as on cancellation.
+    Booking checkoutRoom(int roomNumber, vector<WaitRequest>* served = nullptr) {
+        TIME_OPERATION(Metric::CHECKOUT);
+        RoomId id = rooms.find(roomNumber);
+        if (id == NO_ROOM) {
+            throw BookingException("Invalid room number.");
+        }
+        // Reservations that have not started yet are cancelled, not checked out
+        if (!rooms.isBooked(id)) {
+            throw BookingException("Room " + to_string(roomNumber) + " has no stay in progress tonight.");
+        }
+
+        Booking stay{"", 0, 0};
+        if (heldRooms[id]) {
+            heldRooms[id] = 0;
+            refreshOccupancy(id);
+            logMutation("O," + to_string(roomNumber));
         }
         else {
-            cout << "You do not have a booking for room " << roomNumber << ".\n";
+            const int tonight = calendar.getFirstNight();
+            removeBooking(id, findOverlappingBooking(id, tonight, tonight + 1)->checkIn, stay, StayOutcome::CHECKED_OUT);
+            logMutation("O," + to_string(roomNumber) + "," + formatDate(stay.checkIn) + "," +
+                        to_string(stayHistory.size() - 1));
+            serveWaitlist(id, served);
         }
+        return stay;
     }
 
-    // Helper function to get username by customer pointer
-    string getUsernameByCustomer(shared_ptr<Customer> customer) const {
-        for (const auto& [username, cust] : customers) {
-            if (cust == customer) {
-                return username;
+    /**
+     * @brief Wait for a room of a type for the nights [checkIn, checkOut).
+     *
+     * If a matching room is free already it is booked straight away.
+     * Otherwise the request joins the queue for its type and floor, placed
+     * by the customer's loyalty tier and then by the time it was made, and
+     * is booked as soon as a cancellation or checkout frees a room for it.
+     *
+     * @param floor Floor the room must be on, or ANY_FLOOR.
+     * @param ticket Receives the request's ticket, or 0 if a room was booked.
+     * @return The room booked, or -1 if the customer is now waiting.
+     */
+    int joinWaitlist(const string& username, RoomType type, int floor, int checkIn, int checkOut, uint64_t& ticket) {
+        CustomerId customer = customers.find(username);
+        if (customer == NO_CUSTOMER) {
+            throw BookingException("Username not found. Please register first.");
+        }
+        if (!calendar.inHorizon(checkIn, checkOut)) {
+            throw BookingException("Stays must start today or later and end by " +
+                                   formatDate(calendar.getLastNight() + 1) + ".");
+        }
+        RoomId freeRoom = NO_ROOM;
+        calendar.forEachFreeRoomWhile(type, checkIn, checkOut, [&](RoomId id) {
+            if (floor != ANY_FLOOR && rooms.getFloor(id) != floor) return true;
+            freeRoom = id;
+            return false;
+        });
+        if (freeRoom == NO_ROOM) {
+            // A request no room could ever serve would wait forever
+            auto [first, last] = floor == ANY_FLOOR ? make_pair(RoomId(0), static_cast<RoomId>(rooms.size()))
+                                                    : rooms.floorRange(floor);
+            bool anyOfType = false;
+            for (RoomId id = first; id < last && !anyOfType; ++id) {
+                anyOfType = rooms.getType(id) == type;
+            }
+            if (!anyOfType) {
+                throw BookingException(string("There are no ") + roomTypeName(type) + " rooms" +
+                                       (floor == ANY_FLOOR ? "" : " on floor " + to_string(floor)) + ".");
             }
         }
-        return "";
+        ticket = 0;
+        if (freeRoom != NO_ROOM) {
+            int roomNumber = rooms.getNumber(freeRoom);
+            bookRoom(username, roomNumber, checkIn, checkOut);
+            return roomNumber;
+        }
+        WaitRequest request{0, username, type, floor, checkIn, checkOut, customerAt(customer).getTier()};
+        request.ticket = ticket = waitlist.add(request);
+        logMutation("W," + formatWaitRequest(request));
+        return -1;
     }
 
-    void viewCustomerDetails() const {
-        cout << left << setw(15) << "Username" << setw(15) << "Name" << setw(25) << "Email" << setw(15) << "Phone" << setw(15) << "Adhaar" << setw(15) << "Points" << endl;
-        cout << "-----------------------------------------------------------------------------------------------------------\n";
-        for (const auto& [username, customer] : customers) {
-            cout << left << setw(15) << username
-                 << setw(15) << customer->getName()
-                 << setw(25) << customer->getEmail()
-                 << setw(15) << customer->getPhone()
-                 << setw(15) << customer->getAdhaar()
-                 << setw(15) << customer->getLoyaltyPoints()
-                 << "\n";
+    // Withdraw one of the customer's waiting requests
+    void leaveWaitlist(const string& username, uint64_t ticket) {
+        const WaitRequest* request = waitlist.find(ticket);
+        if (!request || request->username != username) {
+            throw BookingException("You have no waiting request " + to_string(ticket) + ".");
         }
+        waitlist.remove(ticket);
+        logMutation("L," + to_string(ticket));
     }
 
-    void viewCustomerBookings() const {
-        if (bookings.empty()) {
-            cout << "No current bookings.\n";
-            return;
+    // The customer's waiting requests, oldest first
+    vector<WaitRequest> getWaitRequests(const string& username) const {
+        vector<WaitRequest> result;
+        waitlist.forEach([&](const WaitRequest& request) {
+            if (request.username == username) result.push_back(request);
+        });
+        sort(result.begin(), result.end(),
+             [](const WaitRequest& a, const WaitRequest& b) { return a.ticket < b.ticket; });
+        return result;
+    }
+
+    /**
+     * @brief End-of-day loyalty job: settle the day's points and expire inactive accounts.
+     *
+     * Every account is processed in one pass over the ledger's arrays, then
+     * the result is made durable with a checkpoint.
+     *
+     * @param day Day to close; must be later than the last closed day.
+     */
+    DayClose closeLoyaltyDay(int day) {
+        if (!ownsCustomers()) {
+            return customerHome->closeLoyaltyDay(day);
+        }
+        TIME_OPERATION(Metric::CLOSE_LOYALTY_DAY);
+        if (day <= loyalty.getLastClosedDay()) {
+            throw BookingException("Loyalty day " + formatDate(day) + " is already closed (last closed day: " +
+                                   formatDate(loyalty.getLastClosedDay()) + ").");
         }
+        DayClose result = loyalty.closeDay(day, LOYALTY_EXPIRY_DAYS);
+        counters.changeLoyaltyBalance(-result.expiredPoints);
+        availabilityView.publishTotals(counters);
+        checkpoint();
+        return result;
+    }
 
-        cout << left << setw(10) << "Room No" << setw(20) << "Username" << setw(15) << "Type" << endl;
-        cout << "-----------------------------------------------\n";
-        for (const auto& [roomNumber, username] : bookings) {
-            auto roomIt = rooms.find(roomNumber);
-            if (roomIt != rooms.end()) {
-                cout << left << setw(10) << roomNumber
-                     << setw(20) << username
-                     << setw(15) << roomIt->second->getRoomType()
-                     << endl;
-            }
-            else {
-                cout << left << setw(10) << roomNumber
-                     << setw(20) << "Unknown"
-                     << setw(15) << "Unknown"
-                     << endl;
-            }
+    // The customer with a username, if any
+    Customer findCustomer(string_view username) const {
+        return customerIfFound(customers.find(username));
+    }
+
+    // The customer registered with an email, phone number or Adhaar number, if any
+    Customer findCustomerByEmail(string_view email) const {
+        return customerIfFound(customers.findByEmail(email));
+    }
+
+    Customer findCustomerByPhone(string_view phone) const {
+        return customerIfFound(customers.findByPhone(phone));
+    }
+
+    Customer findCustomerByAdhaar(string_view adhaar) const {
+        return customerIfFound(customers.findByAdhaar(adhaar));
+    }
+
+    // Visit every customer, in registration order
+    template<typename Visit>
+    void forEachCustomer(Visit visit) const {
+        for (CustomerId id = 0; id < static_cast<CustomerId>(customers.size()); ++id) {
+            visit(customerAt(id));
+        }
+    }
+
+    // Visit every reservation as (room number, booking), in room order
+    template<typename Visit>
+    void forEachBooking(Visit visit) const {
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            for (const auto& booking : bookings[id]) {
+                visit(rooms.getNumber(id), booking);
+            }
+        }
+    }
+
+    const char* getRoomTypeName(int roomNumber) const {
+        RoomId id = rooms.find(roomNumber);
+        return id == NO_ROOM ? "Unknown" : roomTypeName(rooms.getType(id));
+    }
+
+    // Room numbers free tonight, optionally only those of one type
+    vector<int> getAvailableRooms(const RoomType* type = nullptr) const {
+        vector<int> result;
+        auto collect = [this, &result](RoomId id) { result.push_back(rooms.getNumber(id)); };
+        if (type) {
+            rooms.forEachFree(*type, collect);
+        }
+        else {
+            rooms.forEachFree(collect);
+        }
+        return result;
+    }
+
+    // Room numbers of a type that are free for every night of a stay
+    vector<int> getRoomsFreeFor(RoomType type, int checkIn, int checkOut) const {
+        TIME_OPERATION(Metric::SEARCH);
+        if (!calendar.inHorizon(checkIn, checkOut)) {
+            throw BookingException("Stays must start today or later and end by " +
+                                   formatDate(calendar.getLastNight() + 1) + ".");
+        }
+        vector<int> result;
+        calendar.forEachFreeRoom(type, checkIn, checkOut,
+                                 [this, &result](RoomId id) { result.push_back(rooms.getNumber(id)); });
+        return result;
+    }
+
+    // Price of a stay at today's rates, with the customer's loyalty tier discount
+    // (none for a username that is not registered)
+    int64_t quoteStay(const string& username, RoomType type, int checkIn, int checkOut) const {
+        TIME_OPERATION(Metric::QUOTE);
+        if (!calendar.inHorizon(checkIn, checkOut)) {
+            throw BookingException("Stays must start today or later and end by " +
+                                   formatDate(calendar.getLastNight() + 1) + ".");
+        }
+        CustomerId customer = customers.find(username);
+        LoyaltyTier tier = customer == NO_CUSTOMER ? LoyaltyTier::REGULAR : customerAt(customer).getTier();
+        return pricing.quote(type, tier, checkIn, checkOut);
+    }
+
+    // Price many stays at once; nights outside the booking horizon are not charged
+    vector<int64_t> quoteStays(const vector<StayQuery>& stays) const {
+        vector<int64_t> totals(stays.size());
+        pricing.quoteAll(stays.data(), stays.size(), totals.data());
+        return totals;
+    }
+
+    /**
+     * @brief Rooms of a type free for every night of a stay, without the full list.
+     * @param limit Most room numbers to return; the lowest are kept.
+     * @param roomNumbers Receives up to limit room numbers in ascending order.
+     * @return Number of rooms of the type that are free, or 0 if the stay is outside the horizon.
+     */
+    size_t findFreeRooms(RoomType type, int checkIn, int checkOut, size_t limit, vector<int>& roomNumbers) const {
+        TIME_OPERATION(Metric::SEARCH);
+        roomNumbers.clear();
+        if (!calendar.inHorizon(checkIn, checkOut)) return 0;
+        size_t found = 0;
+        calendar.forEachFreeRoom(type, checkIn, checkOut, [&](RoomId id) {
+            if (found++ < limit) roomNumbers.push_back(rooms.getNumber(id));
+        });
+        return found;
+    }
+
+    // All bookings held by a customer as (room number, booking) pairs, ordered by check-in
+    vector<pair<int, Booking>> getCustomerBookings(const string& username) const {
+        vector<pair<int, Booking>> result;
+        auto ownIt = customerBookings.find(username);
+        if (ownIt == customerBookings.end()) {
+            return result;
+        }
+        for (const auto& [id, checkIn] : ownIt->second) {
+            for (const auto& booking : bookings[id]) {
+                if (booking.checkIn == checkIn) {
+                    result.emplace_back(rooms.getNumber(id), booking);
+                    break;
+                }
+            }
+        }
+        sort(result.begin(), result.end(), [](const pair<int, Booking>& a, const pair<int, Booking>& b) {
+            return make_pair(a.second.checkIn, a.first) < make_pair(b.second.checkIn, b.first);
+        });
+        return result;
+    }
+
+    bool isRoomBooked(int roomNumber) const {
+        RoomId id = rooms.find(roomNumber);
+        return id != NO_ROOM && rooms.isBooked(id);
+    }
+
+    // Total rooms and rooms holding at least one booking
+    pair<int, int> getOccupancy() const {
+        return {static_cast<int>(counters.getTotalRooms()), static_cast<int>(counters.getBookedRooms())};
+    }
+
+    // Running totals by room type and floor, kept current on every booking change
+    const ReportCounters& getReportCounters() const { return counters; }
+
+    // Forecast settings with demand sized to keep each room type about 75% full
+    ForecastConfig defaultForecastConfig() const {
+        ForecastConfig config;
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            RoomType type = static_cast<RoomType>(t);
+            config.demand[t] = DemandModel::forRooms(static_cast<int32_t>(counters.getBookedRooms(type) +
+                                                                          counters.getFreeRooms(type)));
+        }
+        return config;
+    }
+
+    /**
+     * @brief Simulate config.runs seasons from today's rooms and bookings.
+     * @param threads Threads to simulate on, counting the calling one.
+     */
+    OccupancyForecast forecastOccupancy(const ForecastConfig& config,
+                                        size_t threads = max(1u, thread::hardware_concurrency())) const {
+        TIME_OPERATION(Metric::FORECAST);
+        if (config.nights < 1 || config.nights > AvailabilityCalendar::HORIZON_NIGHTS) {
+            throw BookingException("A forecast covers 1 to " + to_string(AvailabilityCalendar::HORIZON_NIGHTS) + " nights.");
+        }
+        if (config.runs < 1 || config.runs > MAX_FORECAST_RUNS) {
+            throw BookingException("A forecast runs 1 to " + to_string(MAX_FORECAST_RUNS) + " seasons.");
+        }
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            const DemandModel& demand = config.demand[t];
+            const string type = roomTypeName(static_cast<RoomType>(t));
+            double weights = 0;
+            bool negative = false;
+            for (double weight : demand.stayWeights) {
+                weights += weight;
+                negative = negative || weight < 0;
+            }
+            if (!(demand.arrivalsPerNight >= 0)) {
+                throw BookingException(type + " arrivals per night must not be negative.");
+            }
+            if (!(demand.cancelRate >= 0 && demand.cancelRate < 1)) {
+                throw BookingException(type + " cancellation rate must be at least 0 and below 1.");
+            }
+            if (demand.stayWeights.size() > MAX_STAY_NIGHTS || negative || !(weights > 0)) {
+                throw BookingException(type + " stay weights need 1 to " + to_string(MAX_STAY_NIGHTS) +
+                                       " non-negative values that are not all 0.");
+            }
+        }
+
+        OccupancyForecaster forecaster(calendar.getFirstNight(), config.nights);
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            RoomType type = rooms.getType(id);
+            forecaster.addRoom(type);
+            for (const Booking& booking : bookings[id]) {
+                forecaster.addStay(type, booking.checkIn, booking.checkOut);
+            }
+        }
+        WorkStealingPool pool(threads > 1 ? threads - 1 : 1);
+        return forecaster.run(config, pool);
+    }
+
+    // Stays archived so far, including those not yet flushed to the history files
+    size_t getArchivedStays() const { return stayHistory.size(); }
+
+    /**
+     * @brief Archived stays per start month and room type, oldest month first.
+     * @param threads Threads scanning the archive, the calling one included.
+     */
+    vector<StayMonthTotals> getStayTotalsByMonth(size_t threads = max(1u, thread::hardware_concurrency())) const {
+        TIME_OPERATION(Metric::STAYS_BY_MONTH);
+        WorkStealingPool pool(threads > 1 ? threads - 1 : 1);
+        return stayHistory.totalsByMonth(pool);
+    }
+
+    // The count customers who spent most on archived stays they checked out of, biggest spender first
+    vector<CustomerSpend> getTopCustomers(size_t count, size_t threads = max(1u, thread::hardware_concurrency())) const {
+        TIME_OPERATION(Metric::TOP_CUSTOMERS);
+        WorkStealingPool pool(threads > 1 ? threads - 1 : 1);
+        return stayHistory.topCustomers(count, static_cast<uint32_t>(customers.size()), pool);
+    }
+
+    // The customer with an id from a stay-history query
+    Customer getCustomer(CustomerId id) const { return customerAt(id); }
+
+    // Room types with their booking counts, most popular first
+    vector<pair<string, int>> getPopularRoomTypes() const { return popularRoomTypes(counters); }
+
+    int getFirstBookableNight() const { return calendar.getFirstNight(); }
+
+    // Any room of a type free for every night of a stay, or -1 if none is
+    int findFreeRoom(RoomType type, int checkIn, int checkOut) const {
+        RoomId id = NO_ROOM;
+        if (calendar.inHorizon(checkIn, checkOut)) {
+            calendar.forEachFreeRoomWhile(type, checkIn, checkOut, [&id](RoomId freeId) {
+                id = freeId;
+                return false;
+            });
+        }
+        return id == NO_ROOM ? -1 : rooms.getNumber(id);
+    }
+
+    // Rooms of a type free for a stay that satisfy a group placement, or none if there are not enough.
+    // Ids ascend by room number and each floor is one id range, so a floor or a run of
+    // adjacent rooms is found by restarting the pick whenever the floor or the run breaks.
+    vector<RoomId> pickGroupRooms(RoomType type, int count, int checkIn, int checkOut, GroupPlacement placement) const {
+        vector<RoomId> picked;
+        if (static_cast<size_t>(count) > rooms.size()) {
+            return picked;
+        }
+        picked.reserve(static_cast<size_t>(count));
+        calendar.forEachFreeRoomWhile(type, checkIn, checkOut, [&](RoomId id) {
+            if (!picked.empty()) {
+                RoomId last = picked.back();
+                bool breaks = (placement == GroupPlacement::SAME_FLOOR && rooms.getFloor(id) != rooms.getFloor(last)) ||
+                              (placement == GroupPlacement::ADJACENT &&
+                               (rooms.getNumber(id) != rooms.getNumber(last) + 1 || rooms.getFloor(id) != rooms.getFloor(last)));
+                if (breaks) picked.clear();
+            }
+            picked.push_back(id);
+            return picked.size() < static_cast<size_t>(count);
+        });
+        if (picked.size() < static_cast<size_t>(count)) picked.clear();
+        return picked;
+    }
+
+    // Collect journal records from several operations and flush them together
+    // (a chain property's batch also covers the point changes it journals at the customers' hotel)
+    void beginBatch() {
+        deferCommits = true;
+        if (!ownsCustomers()) customerHome->beginBatch();
+    }
+
+    // False, after an error message, if the batch's records could not be made durable
+    bool commitBatch() {
+        deferCommits = false;
+        bool synced = syncJournal();
+        if (!ownsCustomers()) synced = customerHome->commitBatch() && synced;
+        checkpointIfDue();
+        return synced;
+    }
+
+    // Make every journal record appended so far durable; false if they could not be written
+    bool syncJournal() {
+        TIME_OPERATION(Metric::JOURNAL_SYNC);
+        return journal.commit();
+    }
+
+    // Sequence number of the last journal record appended so far
+    uint64_t journalLsn() { return journal.lastLsn(); }
+
+    // Wait until the journal is durable up to lsn, syncing it together with any
+    // other waiters; false if the records could not be written. Needs no hotel lock.
+    bool syncJournal(uint64_t lsn) {
+        TIME_OPERATION(Metric::JOURNAL_SYNC);
+        return journal.commit(lsn);
+    }
+
+    // Fold the journal into the text files once it has grown long enough,
+    // and move the booking horizon on once a new night has begun
+    void checkpointIfDue() {
+        if (time(nullptr) >= nextHorizonCheck) {
+            slideHorizon();
+        }
+        if (journal.recordsSinceCheckpoint() >= nextCheckpointAt) {
+            // After a failure, try again once another interval of records has been journaled
+            nextCheckpointAt = checkpoint() ? CHECKPOINT_INTERVAL : journal.recordsSinceCheckpoint() + CHECKPOINT_INTERVAL;
+        }
+    }
+
+    void registerCustomer() {
+        string username, password, name, email, phone, adhaar;
+
+        cout << "=== User Registration ===\n";
+        cout << "Enter username: ";
+        getline(cin, username);
+
+        if (customers.find(username) != NO_CUSTOMER) {
+            cout << "Username already exists. Please choose a different username.\n";
+            return;
+        }
+
+        cout << "Enter password: ";
+        getline(cin, password);
+
+        cout << "Enter your full name: ";
+        getline(cin, name);
+
+        while (true) {
+            cout << "Enter your email: ";
+            getline(cin, email);
+            if (Validator::isValidEmail(email)) {
+                break;
+            }
+            else {
+                cout << "Invalid email format. Please try again.\n";
+            }
+        }
+
+        while (true) {
+            cout << "Enter your phone number (10 digits): ";
+            getline(cin, phone);
+            if (Validator::isValidPhone(phone)) {
+                break;
+            }
+            else {
+                cout << "Invalid phone number. Please enter exactly 10 digits.\n";
+            }
+        }
+
+        while (true) {
+            cout << "Enter your Adhaar number (12 digits): ";
+            getline(cin, adhaar);
+            if (Validator::isValidAdhaar(adhaar)) {
+                break;
+            }
+            else {
+                cout << "Invalid Adhaar number. Please enter exactly 12 digits.\n";
+            }
+        }
+
+        try {
+            registerCustomer(username, password, name, email, phone, adhaar);
+            cout << "Registration successful!\n";
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    Customer login() {
+        string username, password;
+        cout << "=== User Login ===\n";
+        cout << "Enter username: ";
+        getline(cin, username);
+        cout << "Enter password: ";
+        getline(cin, password);
+
+        try {
+            auto customer = authenticate(username, password);
+            cout << "Login successful! Welcome, " << customer.getName() << "!\n";
+            return customer;
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+            return Customer();
+        }
+    }
+
+    void userMenu(Customer customer) {
+        if (!customer) return;
+
+        int userChoice;
+        do {
+            cout << "\n=== User Menu ===\n";
+            cout << "1. View Available Rooms\n";
+            cout << "2. Book Room\n";
+            cout << "3. Cancel Booking\n";
+            cout << "4. View Loyalty Points\n";
+            cout << "5. Search Rooms by Date\n";
+            cout << "6. View My Bookings\n";
+            cout << "7. Book a Group of Rooms\n";
+            cout << "8. Join a Waitlist\n";
+            cout << "9. Logout\n";
+            cout << "Enter your choice: ";
+            cin >> userChoice;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+
+            switch (userChoice) {
+                case 1:
+                    viewAvailableRooms();
+                    break;
+                case 2:
+                    bookRoom(customer);
+                    break;
+                case 3:
+                    cancelBooking(customer);
+                    break;
+                case 4:
+                    cout << "Loyalty Points: " << customer.getLoyaltyPoints() << " (" << customer.getTierName() << ")" << endl;
+                    break;
+                case 5:
+                    searchRoomsByDate(customer);
+                    break;
+                case 6:
+                    viewMyBookings(customer);
+                    break;
+                case 7:
+                    bookRoomGroup(customer);
+                    break;
+                case 8:
+                    joinWaitlist(customer);
+                    break;
+                case 9:
+                    cout << "Logging out...\n";
+                    break;
+                default:
+                    cout << "Invalid choice. Please try again.\n";
+            }
+        } while (userChoice != 9);
+    }
+
+   // Admin Menu
+    void adminMenu() {
+        int adminChoice;
+        do {
+            cout << "\n=== Admin Menu ===\n";
+            cout << "1. View Customer Details\n";
+            cout << "2. View Customer Bookings\n";
+            cout << "3. Generate Occupancy Report\n";
+            cout << "4. Generate Popular Room Types Report\n";
+            cout << "5. Checkout Room\n";
+            cout << "6. Import Customers from CSV\n";
+            cout << "7. View Performance Metrics\n";
+            cout << "8. Close Loyalty Day\n";
+            cout << "9. Find Customer\n";
+            cout << "10. Forecast Occupancy\n";
+            cout << "11. Stay History Report\n";
+            cout << "12. Logout\n";
+            cout << "Enter your choice: ";
+            cin >> adminChoice;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+
+            switch (adminChoice) {
+                case 1:
+                    viewCustomerDetails();
+                    break;
+                case 2:
+                    viewCustomerBookings();
+                    break;
+                case 3:
+                    generateOccupancyReport();
+                    break;
+                case 4:
+                    generatePopularRoomTypesReport();
+                    break;
+                case 5:
+                    checkoutRoom();
+                    break;
+                case 6:
+                    importCustomers();
+                    break;
+                case 7:
+                    viewPerformanceMetrics();
+                    break;
+                case 8:
+                    closeLoyaltyDay();
+                    break;
+                case 9:
+                    findCustomer();
+                    break;
+                case 10:
+                    forecastOccupancy();
+                    break;
+                case 11:
+                    stayHistoryReport();
+                    break;
+                case 12:
+                    cout << "Logging out from admin account...\n";
+                    break;
+                default:
+                    cout << "Invalid choice. Please try again.\n";
+            }
+        } while (adminChoice != 12);
+    }
+
+    void viewPerformanceMetrics() const {
+        if (!METRICS_ENABLED) {
+            cout << "Metrics are not compiled into this build.\n";
+            return;
+        }
+        cout << "\n=== Performance Metrics (microseconds) ===\n";
+        cout << left << setw(22) << "Operation" << right << setw(10) << "Count" << setw(10) << "Failed"
+             << setw(12) << "Mean" << setw(12) << "p50" << setw(12) << "p90" << setw(12) << "p99"
+             << setw(12) << "Max" << endl;
+        cout << string(102, '-') << "\n";
+        bool any = false;
+        cout << fixed << setprecision(1);
+        for (const MetricSummary& s : OperationMetrics::instance().summarize()) {
+            if (s.count == 0) continue;
+            any = true;
+            cout << left << setw(22) << s.name << right << setw(10) << s.count << setw(10) << s.failures
+                 << setw(12) << s.meanNs() / 1e3 << setw(12) << s.quantileNs(0.50) / 1e3
+                 << setw(12) << s.quantileNs(0.90) / 1e3 << setw(12) << s.quantileNs(0.99) / 1e3
+                 << setw(12) << s.quantileNs(1.0) / 1e3 << endl;
+        }
+        if (!any) {
+            cout << "No operations recorded yet.\n";
+        }
+    }
+
+    void closeLoyaltyDay() {
+        try {
+            DayClose result = closeLoyaltyDay(todayDayNumber());
+            cout << "Closed loyalty day " << formatDate(todayDayNumber()) << ": settled " << result.settled
+                 << " points, expired " << result.expiredPoints << " points from " << result.expiredAccounts
+                 << " inactive accounts.\n";
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    void importCustomers() {
+        string path;
+        cout << "Enter path of the customer CSV (username,name,email,phone,adhaar,password): ";
+        getline(cin, path);
+        const string rejectsPath = path + ".rejects";
+        try {
+            ImportResult result = importCustomers(path, rejectsPath);
+            cout << "Imported " << result.imported << " of " << result.rows << " customers.\n";
+            if (result.rejected > 0) {
+                cout << result.rejected << " rows were rejected; see " << rejectsPath << ".\n";
+            }
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+   // Room Management
+    void checkoutRoom() {
+        int roomNumber;
+        cout << "Enter room number to checkout (e.g., 101): ";
+        cin >> roomNumber;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+
+        try {
+            vector<WaitRequest> served;
+            Booking stay = checkoutRoom(roomNumber, &served);
+            if (stay.username.empty()) {
+                cout << "Room " << roomNumber << " was booked but no booking record found.\n";
+            }
+            else {
+                cout << "Room " << roomNumber << " has been checked out by user '" << stay.username << "'"
+                     << (isRoomBooked(roomNumber) ? " and is booked again tonight.\n" : " and is now available.\n");
+            }
+            printServed(roomNumber, served);
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    void viewAvailableRooms() const { printAvailableRooms(rooms); }
+
+    int getValidatedRoomNumber() const {
+        string input;
+        int roomNumber;
+
+        while (true) {
+            cout << "Enter room number: ";
+            getline(cin, input);
+
+            // Trim whitespace
+            input.erase(remove_if(input.begin(), input.end(), ::isspace), input.end());
+
+            try {
+                roomNumber = stoi(input);
+                if (rooms.find(roomNumber) != NO_ROOM) {
+                    return roomNumber;
+                }
+                else {
+                    cout << "Room number " << roomNumber << " does not exist. Please try again.\n";
+                }
+            }
+            catch (const invalid_argument& e) {
+                cout << "Invalid input. Please enter a valid numeric room number.\n";
+            }
+            catch (const out_of_range& e) {
+                cout << "Room number is out of range. Please enter a valid room number.\n";
+            }
+        }
+    }
+    // Prompt for a check-in date and number of nights inside the booking horizon
+    void getValidatedStay(int& checkIn, int& checkOut) const {
+        string input;
+        while (true) {
+            cout << "Enter check-in date (YYYY-MM-DD): ";
+            getline(cin, input);
+            input.erase(remove_if(input.begin(), input.end(), ::isspace), input.end());
+            if (!parseDate(input, checkIn)) {
+                cout << "Invalid date. Please use the format YYYY-MM-DD.\n";
+            }
+            else if (checkIn < calendar.getFirstNight()) {
+                cout << "Check-in date cannot be in the past.\n";
+            }
+            else {
+                break;
+            }
+        }
+        while (true) {
+            int nights = Validator::getInput<int>("Enter number of nights: ");
+            checkOut = checkIn + nights;
+            if (nights > 0 && calendar.inHorizon(checkIn, checkOut)) {
+                return;
+            }
+            cout << "Stays must be at least one night and end by "
+                 << formatDate(calendar.getLastNight() + 1) << ".\n";
+        }
+    }
+
+    // List the rooms that are free for every night of a stay, floor by floor
+    void viewRoomsFreeFor(int checkIn, int checkOut) const {
+        vector<RoomId> freeRooms;
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            calendar.forEachFreeRoom(static_cast<RoomType>(t), checkIn, checkOut,
+                                     [&freeRooms](RoomId id) { freeRooms.push_back(id); });
+        }
+        if (freeRooms.empty()) {
+            cout << "No rooms are free from " << formatDate(checkIn) << " to " << formatDate(checkOut) << ".\n";
+            return;
+        }
+        sort(freeRooms.begin(), freeRooms.end());
+        TableWriter table(cout, {10, 15});
+        int currentFloor = -1;
+        for (RoomId id : freeRooms) {
+            printRoomRow(table, rooms, id, currentFloor);
+        }
+    }
+
+    void searchRoomsByDate(const Customer& customer) const {
+        string roomType;
+        cout << "Enter room type (Standard, Deluxe, Suite): ";
+        getline(cin, roomType);
+        RoomType type;
+        if (!parseRoomType(roomType, type)) {
+            cout << "Unknown room type '" << roomType << "'.\n";
+            return;
+        }
+
+        int checkIn, checkOut;
+        getValidatedStay(checkIn, checkOut);
+
+        vector<RoomId> freeRooms = calendar.freeRoomsOfType(type, checkIn, checkOut);
+        if (freeRooms.empty()) {
+            cout << "No " << roomType << " rooms are free from " << formatDate(checkIn)
+                 << " to " << formatDate(checkOut) << ".\n";
+            return;
+        }
+        cout << freeRooms.size() << " " << roomType << " room(s) free from " << formatDate(checkIn)
+             << " to " << formatDate(checkOut) << ":\n";
+        for (RoomId id : freeRooms) {
+            cout << "  Room " << rooms.getNumber(id) << "\n";
+        }
+        cout << "Price for " << checkOut - checkIn << " night(s): INR "
+             << pricing.quote(type, customer.getTier(), checkIn, checkOut);
+        if (customer.getTier() != LoyaltyTier::REGULAR) {
+            cout << " (" << customer.getTierName() << " discount "
+                 << TIER_DISCOUNT_PERCENT[static_cast<size_t>(customer.getTier())] << "% applied)";
+        }
+        cout << "\n";
+    }
+
+    // Booking and Cancellation
+    void bookRoom(Customer customer) {
+        int checkIn, checkOut;
+        getValidatedStay(checkIn, checkOut);
+
+        // Show rooms free for those nights before booking
+        viewRoomsFreeFor(checkIn, checkOut);
+
+        int roomNumber = getValidatedRoomNumber();
+
+        try {
+            int pointsEarned = bookRoom(string(customer.getUsername()), roomNumber, checkIn, checkOut);
+            cout << "Room " << roomNumber << " booked successfully from " << formatDate(checkIn)
+                 << " to " << formatDate(checkOut) << "! You earned " << pointsEarned << " loyalty points.\n";
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    void bookRoomGroup(Customer customer) {
+        string roomType;
+        cout << "Enter room type (Standard, Deluxe, Suite): ";
+        getline(cin, roomType);
+        RoomType type;
+        if (!parseRoomType(roomType, type)) {
+            cout << "Unknown room type '" << roomType << "'.\n";
+            return;
+        }
+        int count = Validator::getInput<int>("Enter number of rooms: ");
+
+        string where;
+        cout << "Placement (any, floor, adjacent) [any]: ";
+        getline(cin, where);
+        GroupPlacement placement = GroupPlacement::ANY;
+        if (!where.empty() && !parseGroupPlacement(where, placement)) {
+            cout << "Unknown placement '" << where << "'.\n";
+            return;
+        }
+
+        int checkIn, checkOut;
+        getValidatedStay(checkIn, checkOut);
+
+        try {
+            GroupBooking group = bookRoomGroup(string(customer.getUsername()), type, count, checkIn, checkOut, placement);
+            cout << group.roomNumbers.size() << " rooms booked from " << formatDate(checkIn) << " to "
+                 << formatDate(checkOut) << ":";
+            for (int roomNumber : group.roomNumbers) {
+                cout << " " << roomNumber;
+            }
+            cout << "\nYou earned " << group.points << " loyalty points.\n";
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    void joinWaitlist(Customer customer) {
+        string roomType;
+        cout << "Enter room type (Standard, Deluxe, Suite): ";
+        getline(cin, roomType);
+        RoomType type;
+        if (!parseRoomType(roomType, type)) {
+            cout << "Unknown room type '" << roomType << "'.\n";
+            return;
+        }
+
+        string input;
+        cout << "Floor (leave empty for any floor): ";
+        getline(cin, input);
+        int floor = ANY_FLOOR;
+        if (!input.empty() && (!parseInt(input, floor) || floor < 0)) {
+            cout << "Invalid floor '" << input << "'.\n";
+            return;
+        }
+
+        int checkIn, checkOut;
+        getValidatedStay(checkIn, checkOut);
+
+        try {
+            uint64_t ticket;
+            int roomNumber = joinWaitlist(string(customer.getUsername()), type, floor, checkIn, checkOut, ticket);
+            if (roomNumber >= 0) {
+                cout << "Room " << roomNumber << " was free and has been booked from " << formatDate(checkIn)
+                     << " to " << formatDate(checkOut) << ".\n";
+            }
+            else {
+                cout << "You are on the waitlist (ticket " << ticket << "). A room will be booked for you "
+                     << "as soon as one is released.\n";
+            }
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    // Tell the desk which waiting guests a released room went to
+    static void printServed(int roomNumber, const vector<WaitRequest>& served) {
+        for (const WaitRequest& request : served) {
+            cout << "Room " << roomNumber << " has been booked for waiting user '" << request.username << "' from "
+                 << formatDate(request.checkIn) << " to " << formatDate(request.checkOut) << ".\n";
+        }
+    }
+
+    // Print a customer's stays as (room number, booking) rows
+    void printStays(const vector<pair<int, Booking>>& stays) const {
+        TableWriter table(cout, {10, 15, 14, 14});
+        table.row("Room No", "Type", "Check-in", "Check-out");
+        table.line("------------------------------------------------------");
+        for (const auto& [roomNumber, booking] : stays) {
+            table.row(roomNumber, roomTypeName(rooms.getType(rooms.find(roomNumber))),
+                      formatDate(booking.checkIn), formatDate(booking.checkOut));
+        }
+    }
+
+    void cancelBooking(Customer customer) {
+        // Display rooms booked by this customer
+        const string username(customer.getUsername());
+        vector<pair<int, Booking>> userBookings = getCustomerBookings(username);
+
+        if (userBookings.empty()) {
+            cout << "You have no bookings to cancel.\n";
+            return;
+        }
+
+        cout << "\nYour Booked Rooms:\n";
+        printStays(userBookings);
+
+        int roomNumber;
+        cout << "\nEnter room number to cancel booking: ";
+        cin >> roomNumber;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+
+        vector<int> checkIns;
+        for (const auto& [number, booking] : userBookings) {
+            if (number == roomNumber) checkIns.push_back(booking.checkIn);
+        }
+        if (checkIns.empty()) {
+            cout << "You do not have a booking for room " << roomNumber << ".\n";
+            return;
+        }
+
+        int checkIn = checkIns.front();
+        if (checkIns.size() > 1) {
+            string input;
+            cout << "You have several bookings for room " << roomNumber << ". Enter the check-in date (YYYY-MM-DD): ";
+            getline(cin, input);
+            if (!parseDate(input, checkIn) || find(checkIns.begin(), checkIns.end(), checkIn) == checkIns.end()) {
+                cout << "You do not have a booking for room " << roomNumber << " on that date.\n";
+                return;
+            }
+        }
+
+        try {
+            vector<WaitRequest> served;
+            int pointsDeducted = cancelBooking(username, roomNumber, checkIn, &served);
+            cout << "Booking for room " << roomNumber << " has been canceled. You lost " << pointsDeducted << " loyalty points.\n";
+            printServed(roomNumber, served);
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+        }
+    }
+
+    void viewMyBookings(Customer customer) const {
+        vector<pair<int, Booking>> userBookings = getCustomerBookings(string(customer.getUsername()));
+        if (userBookings.empty()) {
+            cout << "You have no bookings.\n";
+        }
+        else {
+            printStays(userBookings);
+        }
+
+        vector<WaitRequest> waiting = getWaitRequests(string(customer.getUsername()));
+        if (waiting.empty()) return;
+        cout << "\nWaiting for:\n";
+        TableWriter table(cout, {10, 15, 10, 14, 14});
+        table.row("Ticket", "Type", "Floor", "Check-in", "Check-out");
+        table.line("----------------------------------------------------------------");
+        for (const WaitRequest& request : waiting) {
+            table.row(request.ticket, roomTypeName(request.type),
+                      request.floor == ANY_FLOOR ? string("any") : to_string(request.floor),
+                      formatDate(request.checkIn), formatDate(request.checkOut));
+        }
+    }
+
+    // Ask how to order a listing; anything but a listed option keeps the first order
+    static int promptSortOrder(const string& prompt, int options) {
+        string input;
+        cout << prompt;
+        if (!getline(cin, input)) return 1;
+        int choice;
+        return parseInt(input, choice) && choice >= 1 && choice <= options ? choice : 1;
+    }
+
+    /**
+     * @brief Show a view one page at a time until the admin quits or the input ends.
+     * @param printPage Writes the rows of one page (numbered from 0) to the table.
+     */
+    template<typename Item, typename PrintPage>
+    static void browsePages(TableWriter& table, PagedView<Item>& view, PrintPage printPage) {
+        const size_t pages = view.pageCount();
+        size_t page = 0;
+        while (true) {
+            printPage(page);
+            table.flush();
+            if (pages <= 1) return;
+            cout << "Page " << page + 1 << " of " << pages << " (" << view.size() << " rows)"
+                 << " - [n]ext, [p]revious, page number or [q]uit: ";
+            string input;
+            if (!getline(cin, input) || input == "q" || input == "Q") return;
+            int target;
+            if (input.empty() || input == "n" || input == "N") {
+                if (page + 1 < pages) ++page;
+            }
+            else if (input == "p" || input == "P") {
+                if (page > 0) --page;
+            }
+            else if (parseInt(input, target) && target >= 1 && static_cast<size_t>(target) <= pages) {
+                page = static_cast<size_t>(target) - 1;
+            }
+            else {
+                cout << "Invalid choice. Please try again.\n";
+            }
+        }
+    }
+
+    // Front-desk lookup: the kind of value entered picks the index
+    void findCustomer() const {
+        string value;
+        cout << "Enter email, phone number or Adhaar number: ";
+        getline(cin, value);
+        Customer customer;
+        if (value.find('@') != string::npos) {
+            customer = findCustomerByEmail(value);
+        }
+        else if (value.size() == PHONE_DIGITS) {
+            customer = findCustomerByPhone(value);
+        }
+        else {
+            customer = findCustomerByAdhaar(value);
+        }
+        if (!customer) {
+            cout << "No customer is registered with '" << value << "'.\n";
+            return;
+        }
+        cout << "Username: " << customer.getUsername() << "\n";
+        customer.display();
+    }
+
+    // Forecast with the default demand; the batch op can set demand per room type
+    void forecastOccupancy() const {
+        ForecastConfig config = defaultForecastConfig();
+        string input;
+        int value;
+        cout << "Nights to forecast (default " << config.nights << "): ";
+        if (getline(cin, input) && parseInt(input, value)) config.nights = value;
+        cout << "Seasons to simulate (default " << config.runs << "): ";
+        if (getline(cin, input) && parseInt(input, value) && value > 0) config.runs = static_cast<size_t>(value);
+
+        OccupancyForecast forecast;
+        auto start = chrono::steady_clock::now();
+        try {
+            forecast = forecastOccupancy(config);
+        }
+        catch (const BookingException& e) {
+            cout << e.what() << "\n";
+            return;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << "\n=== Occupancy Forecast: " << formatDate(forecast.firstNight) << " to "
+             << formatDate(forecast.firstNight + forecast.nights) << ", " << forecast.runs << " seasons in "
+             << fixed << setprecision(2) << seconds << " s ===\n";
+        cout << left << setw(12) << "Type" << right << setw(16) << "Revenue p10" << setw(16) << "p50"
+             << setw(16) << "p90" << endl;
+        cout << string(60, '-') << "\n";
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            const ForecastBand& band = forecast.seasonRevenue[t];
+            cout << left << setw(12) << ROOM_TYPE_NAMES[t] << right << setw(16) << band.p10 << setw(16) << band.p50
+                 << setw(16) << band.p90 << endl;
+        }
+        cout << left << setw(12) << "All" << right << setw(16) << forecast.totalRevenue.p10 << setw(16)
+             << forecast.totalRevenue.p50 << setw(16) << forecast.totalRevenue.p90 << endl << left;
+
+        // Nights are listed in date order; the type columns are the median rooms occupied
+        vector<int> nights(static_cast<size_t>(forecast.nights));
+        for (int n = 0; n < forecast.nights; ++n) {
+            nights[static_cast<size_t>(n)] = n;
+        }
+        PagedView<int> view(move(nights), ADMIN_PAGE_SIZE);
+        const int totalRooms = getOccupancy().first;
+        TableWriter table(cout, {12, 10, 10, 10, 10, 10, 10, 10});
+        browsePages(table, view, [&](size_t page) {
+            table.row("Night", "Rooms p10", "p50", "p90", "p50 %", ROOM_TYPE_NAMES[0], ROOM_TYPE_NAMES[1], ROOM_TYPE_NAMES[2]);
+            table.line("--------------------------------------------------------------------------------");
+            view.forEachOnPage(page, [&](int n) {
+                const ForecastBand& all = forecast.allRooms[static_cast<size_t>(n)];
+                table.row(formatDate(forecast.firstNight + n), all.p10, all.p50, all.p90,
+                          totalRooms ? all.p50 * 100 / totalRooms : 0,
+                          forecast.occupancyOf(RoomType::STANDARD, n).p50, forecast.occupancyOf(RoomType::DELUXE, n).p50,
+                          forecast.occupancyOf(RoomType::SUITE, n).p50);
+            });
+        });
+    }
+
+    void stayHistoryReport() const {
+        if (getArchivedStays() == 0) {
+            cout << "No stays have ended yet.\n";
+            return;
+        }
+        constexpr size_t TOP_CUSTOMERS = 10;
+        vector<CustomerSpend> top = getTopCustomers(TOP_CUSTOMERS);
+        cout << "\n=== Top Customers by Spend (" << getArchivedStays() << " stays archived) ===\n";
+        cout << left << setw(20) << "Username" << right << setw(10) << "Stays" << setw(16) << "Spend (INR)" << endl;
+        cout << string(46, '-') << "\n";
+        for (const CustomerSpend& entry : top) {
+            cout << left << setw(20) << getCustomer(entry.customer).getUsername() << right << setw(10) << entry.stays
+                 << setw(16) << entry.spend << endl;
+        }
+        cout << left;
+
+        // Stays checked out count towards nights and revenue; cancellations only towards their own column
+        cout << "\n=== Stays by Month of Check-in ===\n";
+        PagedView<StayMonthTotals> view(getStayTotalsByMonth(), ADMIN_PAGE_SIZE);
+        TableWriter table(cout, {10, 10, 10, 11, 12, 14});
+        browsePages(table, view, [&](size_t page) {
+            table.row("Month", "Type", "Stays", "Cancelled", "Avg nights", "Revenue");
+            table.line("------------------------------------------------------------------");
+            view.forEachOnPage(page, [&](const StayMonthTotals& totals) {
+                char average[16];
+                snprintf(average, sizeof(average), "%.2f", totals.stays ? double(totals.nights) / totals.stays : 0.0);
+                table.row(formatMonth(totals.month), roomTypeName(totals.type), totals.stays, totals.cancelled,
+                          average, totals.revenue);
+            });
+        });
+    }
+
+    void viewCustomerDetails() const {
+        if (customers.empty()) {
+            cout << "No registered customers.\n";
+            return;
+        }
+        int order = promptSortOrder("Sort by 1. Username or 2. Loyalty points (default 1): ", 2);
+
+        // The view holds customer ids, which cannot change while the admin menu is open
+        vector<CustomerId> rows(customers.size());
+        for (CustomerId id = 0; id < static_cast<CustomerId>(rows.size()); ++id) {
+            rows[id] = id;
+        }
+        auto byUsername = [this](CustomerId a, CustomerId b) { return customers.getUsername(a) < customers.getUsername(b); };
+        auto byPoints = [this](CustomerId a, CustomerId b) {
+            int pointsA = loyaltyPointsOf(a), pointsB = loyaltyPointsOf(b);
+            if (pointsA != pointsB) return pointsA > pointsB;
+            return customers.getUsername(a) < customers.getUsername(b);
+        };
+        PagedView<CustomerId> view = order == 2 ? PagedView<CustomerId>(move(rows), byPoints, ADMIN_PAGE_SIZE)
+                                                : PagedView<CustomerId>(move(rows), byUsername, ADMIN_PAGE_SIZE);
+
+        TableWriter table(cout, {15, 15, 25, 15, 15, 15});
+        browsePages(table, view, [&](size_t page) {
+            table.row("Username", "Name", "Email", "Phone", "Adhaar", "Points");
+            table.line("-----------------------------------------------------------------------------------------------------------");
+            view.forEachOnPage(page, [this, &table](CustomerId id) {
+                Customer customer = customerAt(id);
+                table.row(customer.getUsername(), customer.getName(), customer.getEmail(), customer.getPhone(),
+                          customer.getAdhaar(), customer.getLoyaltyPoints());
+            });
+        });
+    }
+
+    void viewCustomerBookings() const {
+        if (getOccupancy().second == 0) {
+            cout << "No current bookings.\n";
+            return;
+        }
+        int order = promptSortOrder("Sort by 1. Room or 2. Username (default 1): ", 2);
+
+        // Bookings are stored room by room, so the room order needs no sort
+        vector<pair<RoomId, const Booking*>> rows;
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            for (const auto& booking : bookings[id]) {
+                rows.emplace_back(id, &booking);
+            }
+        }
+        using Row = pair<RoomId, const Booking*>;
+        auto byUsername = [](const Row& a, const Row& b) {
+            if (a.second->username != b.second->username) return a.second->username < b.second->username;
+            return a.second->checkIn < b.second->checkIn;
+        };
+        PagedView<Row> view = order == 2 ? PagedView<Row>(move(rows), byUsername, ADMIN_PAGE_SIZE)
+                                         : PagedView<Row>(move(rows), ADMIN_PAGE_SIZE);
+
+        TableWriter table(cout, {10, 20, 15, 14, 14});
+        browsePages(table, view, [&](size_t page) {
+            table.row("Room No", "Username", "Type", "Check-in", "Check-out");
+            table.line("---------------------------------------------------------------------------");
+            view.forEachOnPage(page, [this, &table](const Row& row) {
+                const Booking& booking = *row.second;
+                table.row(rooms.getNumber(row.first), booking.username, roomTypeName(rooms.getType(row.first)),
+                          formatDate(booking.checkIn), formatDate(booking.checkOut));
+            });
+        });
+    }
+};
+
+/**
+ * @struct ChainRoomOffer
+ * @brief A free room found by a search across a hotel chain.
+ */
+struct ChainRoomOffer {
+    size_t property;   // Index of the property in the chain
+    int roomNumber;
+    size_t freeOfType; // Rooms of the searched type free at that property for the stay
+};
+
+/**
+ * @class HotelChain
+ * @brief Several properties served by one process with one customer base.
+ *
+ * The chain's directory holds the first property, which also keeps every
+ * customer and their loyalty points. Each further property is a Hotel of its
+ * own in properties/<name>/ (rooms, bookings, journal and snapshot) that
+ * books against those customers, so a customer registers and earns points
+ * once for the whole chain. Searches fan out to all properties on a
+ * work-stealing pool and the per-property answers are merged into one
+ * ranking. Like Hotel, a chain serves one call at a time.
+ */
+class HotelChain {
+public:
+    static constexpr const char* HOME_PROPERTY = "main";
+
+private:
+    struct Property {
+        string name;
+        unique_ptr<Hotel> hotel;
+    };
+
+    const string directory; // Empty, or ending in '/'
+    vector<Property> properties; // The first one holds the customers
+    mutable WorkStealingPool pool;
+
+    static bool validPropertyName(const string& name) {
+        if (name.empty() || name == HOME_PROPERTY) return false;
+        return all_of(name.begin(), name.end(), [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_'; });
+    }
+
+    string propertiesDir() const { return directory + "properties/"; }
+
+    void openProperty(const string& name) {
+        string dataDir = propertiesDir() + name + "/";
+        properties.push_back({name, make_unique<Hotel>(dataDir, *properties.front().hotel, name)});
+    }
+
+public:
+    /**
+     * @brief Open the chain in a directory, with every property found under properties/.
+     * @param directory Empty for the working directory, otherwise ending in '/'.
+     * @param threads Workers for the search fan-out.
+     */
+    explicit HotelChain(const string& directory = "", size_t threads = max(1u, thread::hardware_concurrency()))
+        : directory(directory), pool(threads) {
+        properties.push_back({HOME_PROPERTY, make_unique<Hotel>(directory)});
+        vector<string> names;
+        if (DIR* dir = opendir(propertiesDir().c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                string name = entry->d_name;
+                struct stat info;
+                if (validPropertyName(name) && stat((propertiesDir() + name).c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+                    names.push_back(name);
+                }
+            }
+            closedir(dir);
+        }
+        sort(names.begin(), names.end());
+        for (const string& name : names) {
+            openProperty(name);
+        }
+    }
+
+    ~HotelChain() {
+        // The other properties journal point changes through the first one, so it closes last
+        while (properties.size() > 1) {
+            properties.pop_back();
+        }
+    }
+
+    /**
+     * @brief Add a property, creating its directory; an existing one is opened as it is.
+     * @return Index of the property.
+     */
+    size_t addProperty(const string& name) {
+        if (!validPropertyName(name)) {
+            throw BookingException("Invalid property name '" + name + "'. Use letters, digits, '-' and '_'.");
+        }
+        if (findProperty(name) != properties.size()) {
+            throw BookingException("Property '" + name + "' already exists.");
+        }
+        string dataDir = propertiesDir() + name;
+        if ((mkdir(propertiesDir().c_str(), 0755) != 0 && errno != EEXIST) ||
+            (mkdir(dataDir.c_str(), 0755) != 0 && errno != EEXIST)) {
+            throw BookingException("Cannot create " + dataDir + ".");
+        }
+        openProperty(name);
+        return properties.size() - 1;
+    }
+
+    size_t propertyCount() const { return properties.size(); }
+    const string& getPropertyName(size_t index) const { return properties[index].name; }
+    Hotel& getProperty(size_t index) { return *properties[index].hotel; }
+    const Hotel& getProperty(size_t index) const { return *properties[index].hotel; }
+
+    // Index of a property by name, or propertyCount() if there is none
+    size_t findProperty(const string& name) const {
+        for (size_t i = 0; i < properties.size(); ++i) {
+            if (properties[i].name == name) return i;
+        }
+        return properties.size();
+    }
+
+    // The property holding the customers: registration, login and the loyalty day go here
+    Hotel& getCustomerHome() { return *properties.front().hotel; }
+
+    // Collect the journal records of every property for one flush (see Hotel::beginBatch)
+    void beginBatch() {
+        for (Property& property : properties) {
+            property.hotel->beginBatch();
+        }
+    }
+
+    // False if any property's records could not be made durable
+    bool commitBatch() {
+        bool synced = true;
+        for (Property& property : properties) {
+            synced = property.hotel->commitBatch() && synced;
+        }
+        return synced;
+    }
+
+    /**
+     * @brief Rooms of a type free for a stay anywhere in the chain, best first.
+     *
+     * Every property is searched in parallel and keeps at most limit rooms,
+     * so the merge does not grow with property size. Properties with the
+     * most rooms of the type free rank first, which spreads demand across
+     * the chain; within a property, lower room numbers come first.
+     * @param limit Most offers to return.
+     */
+    vector<ChainRoomOffer> findFreeRooms(RoomType type, int checkIn, int checkOut, size_t limit) const {
+        const int firstNight = properties.front().hotel->getFirstBookableNight();
+        if (checkIn < firstNight || checkOut <= checkIn || checkOut > firstNight + AvailabilityCalendar::HORIZON_NIGHTS) {
+            throw BookingException("Stays must start today or later and end by " +
+                                   formatDate(firstNight + AvailabilityCalendar::HORIZON_NIGHTS) + ".");
+        }
+        vector<vector<int>> found(properties.size());
+        vector<size_t> freeCounts(properties.size());
+        pool.run(properties.size(), [&](size_t i) {
+            freeCounts[i] = properties[i].hotel->findFreeRooms(type, checkIn, checkOut, limit, found[i]);
+        });
+
+        vector<ChainRoomOffer> offers;
+        for (size_t i = 0; i < properties.size(); ++i) {
+            for (int roomNumber : found[i]) {
+                offers.push_back({i, roomNumber, freeCounts[i]});
+            }
+        }
+        auto better = [](const ChainRoomOffer& a, const ChainRoomOffer& b) {
+            if (a.freeOfType != b.freeOfType) return a.freeOfType > b.freeOfType;
+            if (a.property != b.property) return a.property < b.property;
+            return a.roomNumber < b.roomNumber;
+        };
+        if (offers.size() > limit) {
+            partial_sort(offers.begin(), offers.begin() + static_cast<ptrdiff_t>(limit), offers.end(), better);
+            offers.resize(limit);
+        }
+        else {
+            sort(offers.begin(), offers.end(), better);
+        }
+        return offers;
+    }
+};
+
+// Batch and Server Mode
+const string ADMIN_USERNAME = "admin";
+const string ADMIN_PASSWORD = "adminpass";
+
+// Prometheus text file with the operation metrics, rewritten every METRICS_INTERVAL
+const string METRICS_FILE = "metrics.prom";
+constexpr chrono::seconds METRICS_INTERVAL(10);
+
+// Append a JSON array of integers
+void appendJsonIntArray(string& out, string_view key, const vector<int>& values) {
+    string array = "[";
+    for (int value : values) {
+        if (array.size() > 1) array += ',';
+        array += to_string(value);
+    }
+    array += ']';
+    appendJsonRaw(out, key, array);
+}
+
+/**
+ * @class CommandProcessor
+ * @brief Applies JSON-lines commands to a Hotel without any prompts.
+ *
+ * User ops: register, login, logout, rooms, search, quote, book, bookgroup,
+ * cancel, bookings, loyalty and the waitlist ops. They act for the user of the most recent successful
+ * "login" (a quote without one is at the regular rate); a "book" with a
+ * "type" instead of a "room" takes any free room of that type, and
+ * "bookgroup" takes "count" rooms of a "type" at once, optionally
+ * with a "placement" of "floor" or "adjacent". "joinwaitlist" books a
+ * room of a "type" (on "floor", if given) or, if none is free, returns a
+ * "ticket" for the waitlist; "waitlist" lists the user's waiting requests
+ * and "leavewaitlist" withdraws one by "ticket". A cancel or checkout that
+ * gives the room to waiting requests lists them as "waitlistServed".
+ * Admin ops: admin (log in), customers, findcustomer (by "email", "phone"
+ * or "adhaar"), allbookings, report, checkout and closeday (the end-of-day
+ * loyalty job, for "date" or today). A trusted
+ * processor (batch mode) may run admin ops without the admin login. Every
+ * command produces one JSON result line with "ok" and either the
+ * operation's details or an "error" message.
+ * Over a HotelChain, any command may name the "property" it acts on (the
+ * first one, "main", holds the customers and is the default); "properties"
+ * lists them, "addproperty" (admin) adds one by "name", and "chainsearch"
+ * finds free rooms of a "type" across the chain, up to "limit" of them.
+ */
+class CommandProcessor {
+    HotelChain* chain; // Null when serving a single hotel
+    Hotel& home;       // The hotel holding the customers
+    Hotel* hotel;      // The hotel the current command acts on
+    bool trusted;
+    mutex* hotelLock; // Held around every command when the hotel is shared
+    string sessionUser;
+    bool sessionAdmin = false;
+    JsonLine request;
+
+    string requireString(string_view key) const {
+        string_view value = request.get(key);
+        if (value.empty()) {
+            throw BookingException("Missing field '" + string(key) + "'.");
+        }
+        return string(value);
+    }
+
+    int requireInt(string_view key) const {
+        int value;
+        if (!request.getInt(key, value)) {
+            throw BookingException("Missing or invalid field '" + string(key) + "'.");
+        }
+        return value;
+    }
+
+    int dateField(string_view key, int fallback) const {
+        string_view text = request.get(key);
+        if (text.empty()) return fallback;
+        int day;
+        if (!parseDate(string(text), day)) {
+            throw BookingException("Invalid date in field '" + string(key) + "'. Use YYYY-MM-DD.");
+        }
+        return day;
+    }
+
+    const string& requireLogin() const {
+        if (sessionUser.empty()) {
+            throw BookingException("Not logged in.");
+        }
+        return sessionUser;
+    }
+
+    void requireAdmin() const {
+        if (!trusted && !sessionAdmin) {
+            throw BookingException("Admin login required.");
+        }
+    }
+
+    RoomType requireRoomType() const {
+        RoomType type;
+        if (!parseRoomType(request.get("type"), type)) {
+            throw BookingException("Missing or invalid field 'type'. Use Standard, Deluxe or Suite.");
+        }
+        return type;
+    }
+
+    void appendBooking(string& out, int roomNumber, const Booking& booking) const {
+        out += out.size() > 1 ? ",{" : "{";
+        appendJsonRaw(out, "room", to_string(roomNumber));
+        appendJsonField(out, "type", hotel->getRoomTypeName(roomNumber));
+        appendJsonField(out, "username", booking.username);
+        appendJsonField(out, "checkIn", formatDate(booking.checkIn));
+        appendJsonField(out, "checkOut", formatDate(booking.checkOut));
+        out += '}';
+    }
+
+    void appendWaitRequest(string& out, const WaitRequest& request) const {
+        out += out.size() > 1 ? ",{" : "{";
+        appendJsonRaw(out, "ticket", to_string(request.ticket));
+        appendJsonField(out, "username", request.username);
+        appendJsonField(out, "type", roomTypeName(request.type));
+        if (request.floor != ANY_FLOOR) appendJsonRaw(out, "floor", to_string(request.floor));
+        appendJsonField(out, "checkIn", formatDate(request.checkIn));
+        appendJsonField(out, "checkOut", formatDate(request.checkOut));
+        out += '}';
+    }
+
+    // Demand overrides per room type: arrivals.<Type>, cancelRate.<Type> and stayWeights.<Type> ("30,25,18")
+    void readDemand(ForecastConfig& config) const {
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            DemandModel& demand = config.demand[t];
+            const string suffix = string(".") + ROOM_TYPE_NAMES[t];
+            if (request.has("arrivals" + suffix) && !request.getDouble("arrivals" + suffix, demand.arrivalsPerNight)) {
+                throw BookingException("Invalid field 'arrivals" + suffix + "'.");
+            }
+            if (request.has("cancelRate" + suffix) && !request.getDouble("cancelRate" + suffix, demand.cancelRate)) {
+                throw BookingException("Invalid field 'cancelRate" + suffix + "'.");
+            }
+            if (!request.has("stayWeights" + suffix)) continue;
+            string_view weights = request.get("stayWeights" + suffix);
+            demand.stayWeights.clear();
+            string_view fields[MAX_STAY_NIGHTS + 1];
+            size_t count = min(splitFields(weights, fields, MAX_STAY_NIGHTS + 1), MAX_STAY_NIGHTS + 1);
+            for (size_t i = 0; i < count; ++i) {
+                int weight;
+                if (!parseInt(fields[i], weight)) {
+                    throw BookingException("Invalid field 'stayWeights" + suffix + "'.");
+                }
+                demand.stayWeights.push_back(weight);
+            }
+        }
+    }
+
+    // [[p10,p50,p90],...] for each band
+    static void appendBands(string& out, string_view key, const ForecastBand* bands, size_t count) {
+        string list = "[";
+        for (size_t i = 0; i < count; ++i) {
+            if (i) list += ',';
+            list += '[' + to_string(bands[i].p10) + ',' + to_string(bands[i].p50) + ',' + to_string(bands[i].p90) + ']';
+        }
+        list += ']';
+        appendJsonRaw(out, key, list);
+    }
+
+    static void appendBand(string& out, string_view key, const ForecastBand& band) {
+        string object = "{";
+        appendJsonRaw(object, "p10", to_string(band.p10));
+        appendJsonRaw(object, "p50", to_string(band.p50));
+        appendJsonRaw(object, "p90", to_string(band.p90));
+        object += '}';
+        appendJsonRaw(out, key, object);
+    }
+
+    // The waiting requests a cancellation or checkout gave the room to, if any
+    void appendServed(string& out, const vector<WaitRequest>& served) const {
+        if (served.empty()) return;
+        string list = "[";
+        for (const WaitRequest& request : served) {
+            appendWaitRequest(list, request);
+        }
+        list += ']';
+        appendJsonRaw(out, "waitlistServed", list);
+    }
+
+    HotelChain& requireChain() const {
+        if (!chain) {
+            throw BookingException("Not serving a hotel chain.");
+        }
+        return *chain;
+    }
+
+    // Run the command in request and append its details to result
+    void dispatch(string_view op, string& result) {
+        hotel = &home;
+        if (request.has("property")) {
+            const string name(request.get("property"));
+            size_t index = requireChain().findProperty(name);
+            if (index == chain->propertyCount()) {
+                throw BookingException("Unknown property '" + name + "'.");
+            }
+            hotel = &chain->getProperty(index);
+        }
+
+        if (op == "register") {
+            hotel->registerCustomer(requireString("username"), requireString("password"), requireString("name"),
+                                   requireString("email"), requireString("phone"), requireString("adhaar"));
+        }
+        else if (op == "login") {
+            string username = requireString("username");
+            auto customer = hotel->authenticate(username, requireString("password"));
+            sessionUser = username;
+            appendJsonField(result, "name", customer.getName());
+        }
+        else if (op == "logout") {
+            sessionUser.clear();
+            sessionAdmin = false;
+        }
+        else if (op == "admin") {
+            if (requireString("username") != ADMIN_USERNAME || requireString("password") != ADMIN_PASSWORD) {
+                throw BookingException("Incorrect admin credentials. Access denied.");
+            }
+            sessionAdmin = true;
+        }
+        else if (op == "rooms") {
+            RoomType type;
+            bool byType = request.has("type");
+            if (byType) type = requireRoomType();
+            appendJsonIntArray(result, "rooms", hotel->getAvailableRooms(byType ? &type : nullptr));
+        }
+        else if (op == "search") {
+            RoomType type = requireRoomType();
+            int checkIn = dateField("checkIn", hotel->getFirstBookableNight());
+            int nights = 1;
+            request.getInt("nights", nights);
+            int checkOut = dateField("checkOut", checkIn + nights);
+            appendJsonIntArray(result, "rooms", hotel->getRoomsFreeFor(type, checkIn, checkOut));
+        }
+        else if (op == "quote") {
+            RoomType type = requireRoomType();
+            int checkIn = dateField("checkIn", hotel->getFirstBookableNight());
+            int nights = 1;
+            request.getInt("nights", nights);
+            int checkOut = dateField("checkOut", checkIn + nights);
+            appendJsonRaw(result, "price", to_string(hotel->quoteStay(sessionUser, type, checkIn, checkOut)));
+            appendJsonField(result, "checkIn", formatDate(checkIn));
+            appendJsonField(result, "checkOut", formatDate(checkOut));
+        }
+        else if (op == "bookings") {
+            string list = "[";
+            for (const auto& [roomNumber, booking] : hotel->getCustomerBookings(requireLogin())) {
+                appendBooking(list, roomNumber, booking);
+            }
+            list += ']';
+            appendJsonRaw(result, "bookings", list);
+        }
+        else if (op == "loyalty") {
+            auto customer = hotel->findCustomer(requireLogin());
+            if (!customer) {
+                throw BookingException("Username not found. Please register first.");
+            }
+            appendJsonRaw(result, "points", to_string(customer.getLoyaltyPoints()));
+            appendJsonField(result, "tier", customer.getTierName());
+        }
+        else if (op == "customers") {
+            requireAdmin();
+            string list = "[";
+            hotel->forEachCustomer([&list](const Customer& customer) {
+                list += list.size() > 1 ? ",{" : "{";
+                appendJsonField(list, "username", customer.getUsername());
+                appendJsonField(list, "name", customer.getName());
+                appendJsonField(list, "email", customer.getEmail());
+                appendJsonField(list, "phone", customer.getPhone());
+                appendJsonRaw(list, "points", to_string(customer.getLoyaltyPoints()));
+                list += '}';
+            });
+            list += ']';
+            appendJsonRaw(result, "customers", list);
+        }
+        else if (op == "findcustomer") {
+            requireAdmin();
+            Customer customer;
+            if (request.has("email")) customer = hotel->findCustomerByEmail(request.get("email"));
+            else if (request.has("phone")) customer = hotel->findCustomerByPhone(request.get("phone"));
+            else if (request.has("adhaar")) customer = hotel->findCustomerByAdhaar(request.get("adhaar"));
+            else throw BookingException("Missing field 'email', 'phone' or 'adhaar'.");
+            if (!customer) {
+                throw BookingException("No customer is registered with that value.");
+            }
+            appendJsonField(result, "username", customer.getUsername());
+            appendJsonField(result, "name", customer.getName());
+            appendJsonField(result, "email", customer.getEmail());
+            appendJsonField(result, "phone", customer.getPhone());
+            appendJsonRaw(result, "points", to_string(customer.getLoyaltyPoints()));
+        }
+        else if (op == "allbookings") {
+            requireAdmin();
+            string list = "[";
+            hotel->forEachBooking([this, &list](int roomNumber, const Booking& booking) {
+                appendBooking(list, roomNumber, booking);
+            });
+            list += ']';
+            appendJsonRaw(result, "bookings", list);
+        }
+        else if (op == "book") {
+            const string& username = requireLogin();
+            int checkIn = dateField("checkIn", hotel->getFirstBookableNight());
+            int nights = 1;
+            request.getInt("nights", nights);
+            int checkOut = dateField("checkOut", checkIn + nights);
+            int roomNumber;
+            RoomType type;
+            if (request.has("room")) {
+                roomNumber = requireInt("room");
+            }
+            else if (parseRoomType(request.get("type"), type)) {
+                // No room given: take any free room of the requested type
+                roomNumber = hotel->findFreeRoom(type, checkIn, checkOut);
+                if (roomNumber < 0) {
+                    throw BookingException("No " + string(roomTypeName(type)) + " room is free for those dates.");
+                }
+            }
+            else {
+                throw BookingException("Missing field 'room' or valid 'type'.");
+            }
+            int points = hotel->bookRoom(username, roomNumber, checkIn, checkOut);
+            appendJsonRaw(result, "room", to_string(roomNumber));
+            appendJsonField(result, "checkIn", formatDate(checkIn));
+            appendJsonField(result, "checkOut", formatDate(checkOut));
+            appendJsonRaw(result, "points", to_string(points));
+        }
+        else if (op == "bookgroup") {
+            const string& username = requireLogin();
+            RoomType type = requireRoomType();
+            int count = requireInt("count");
+            GroupPlacement placement = GroupPlacement::ANY;
+            if (request.has("placement") && !parseGroupPlacement(request.get("placement"), placement)) {
+                throw BookingException("Invalid field 'placement'. Use any, floor or adjacent.");
+            }
+            int checkIn = dateField("checkIn", hotel->getFirstBookableNight());
+            int nights = 1;
+            request.getInt("nights", nights);
+            int checkOut = dateField("checkOut", checkIn + nights);
+            GroupBooking group = hotel->bookRoomGroup(username, type, count, checkIn, checkOut, placement);
+            appendJsonIntArray(result, "rooms", group.roomNumbers);
+            appendJsonField(result, "checkIn", formatDate(checkIn));
+            appendJsonField(result, "checkOut", formatDate(checkOut));
+            appendJsonRaw(result, "points", to_string(group.points));
+        }
+        else if (op == "cancel") {
+            const string& username = requireLogin();
+            int roomNumber = requireInt("room");
+            int checkIn = dateField("checkIn", -1);
+            if (checkIn < 0) {
+                // Without a date, cancel the customer's earliest stay in that room
+                for (const auto& [number, booking] : hotel->getCustomerBookings(username)) {
+                    if (number == roomNumber && (checkIn < 0 || booking.checkIn < checkIn)) {
+                        checkIn = booking.checkIn;
+                    }
+                }
+                if (checkIn < 0) {
+                    throw BookingException("You do not have a booking for room " + to_string(roomNumber) + ".");
+                }
+            }
+            vector<WaitRequest> served;
+            int points = hotel->cancelBooking(username, roomNumber, checkIn, &served);
+            appendJsonRaw(result, "room", to_string(roomNumber));
+            appendJsonField(result, "checkIn", formatDate(checkIn));
+            appendJsonRaw(result, "points", to_string(points));
+            appendServed(result, served);
+        }
+        else if (op == "joinwaitlist") {
+            const string& username = requireLogin();
+            RoomType type = requireRoomType();
+            int floor = ANY_FLOOR;
+            if (request.has("floor")) floor = requireInt("floor");
+            int checkIn = dateField("checkIn", hotel->getFirstBookableNight());
+            int nights = 1;
+            request.getInt("nights", nights);
+            int checkOut = dateField("checkOut", checkIn + nights);
+            uint64_t ticket;
+            int roomNumber = hotel->joinWaitlist(username, type, floor, checkIn, checkOut, ticket);
+            if (roomNumber >= 0) {
+                appendJsonRaw(result, "room", to_string(roomNumber));
+            }
+            else {
+                appendJsonRaw(result, "ticket", to_string(ticket));
+            }
+            appendJsonField(result, "checkIn", formatDate(checkIn));
+            appendJsonField(result, "checkOut", formatDate(checkOut));
+        }
+        else if (op == "waitlist") {
+            string list = "[";
+            for (const WaitRequest& waiting : hotel->getWaitRequests(requireLogin())) {
+                appendWaitRequest(list, waiting);
+            }
+            list += ']';
+            appendJsonRaw(result, "requests", list);
+        }
+        else if (op == "leavewaitlist") {
+            const string& username = requireLogin();
+            int ticket = requireInt("ticket");
+            hotel->leaveWaitlist(username, static_cast<uint64_t>(ticket));
+            appendJsonRaw(result, "ticket", to_string(ticket));
+        }
+        else if (op == "checkout") {
+            requireAdmin();
+            int roomNumber = requireInt("room");
+            vector<WaitRequest> served;
+            Booking stay = hotel->checkoutRoom(roomNumber, &served);
+            appendJsonRaw(result, "room", to_string(roomNumber));
+            appendJsonField(result, "username", stay.username);
+            appendServed(result, served);
+        }
+        else if (op == "closeday") {
+            requireAdmin();
+            int day = dateField("date", todayDayNumber());
+            DayClose closed = hotel->closeLoyaltyDay(day);
+            appendJsonField(result, "date", formatDate(day));
+            appendJsonRaw(result, "settledPoints", to_string(closed.settled));
+            appendJsonRaw(result, "expiredPoints", to_string(closed.expiredPoints));
+            appendJsonRaw(result, "expiredAccounts", to_string(closed.expiredAccounts));
+        }
+        else if (op == "forecast") {
+            requireAdmin();
+            ForecastConfig config = hotel->defaultForecastConfig();
+            request.getInt("nights", config.nights);
+            int runs, seed;
+            if (request.getInt("runs", runs)) config.runs = static_cast<size_t>(max(0, runs));
+            if (request.getInt("seed", seed)) config.seed = static_cast<uint64_t>(seed);
+            readDemand(config);
+            OccupancyForecast forecast = hotel->forecastOccupancy(config);
+            const size_t nights = static_cast<size_t>(forecast.nights);
+            appendJsonField(result, "firstNight", formatDate(forecast.firstNight));
+            appendJsonRaw(result, "nights", to_string(forecast.nights));
+            appendJsonRaw(result, "runs", to_string(forecast.runs));
+            appendBand(result, "revenue", forecast.totalRevenue);
+            appendBands(result, "allRooms", forecast.allRooms.data(), nights);
+            string byType = "[";
+            for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+                byType += byType.size() > 1 ? ",{" : "{";
+                appendJsonField(byType, "type", ROOM_TYPE_NAMES[t]);
+                appendJsonRaw(byType, "rooms", to_string(forecast.roomsOfType[t]));
+                appendBand(byType, "revenue", forecast.seasonRevenue[t]);
+                appendBands(byType, "occupancy", &forecast.occupancy[t * nights], nights);
+                appendBands(byType, "nightlyRevenue", &forecast.revenue[t * nights], nights);
+                byType += '}';
+            }
+            byType += ']';
+            appendJsonRaw(result, "byType", byType);
+        }
+        else if (op == "history") {
+            requireAdmin();
+            int top = 10;
+            request.getInt("top", top);
+            appendJsonRaw(result, "archivedStays", to_string(hotel->getArchivedStays()));
+            string months = "[";
+            for (const StayMonthTotals& totals : hotel->getStayTotalsByMonth()) {
+                months += months.size() > 1 ? ",{" : "{";
+                appendJsonField(months, "month", formatMonth(totals.month));
+                appendJsonField(months, "type", roomTypeName(totals.type));
+                appendJsonRaw(months, "stays", to_string(totals.stays));
+                appendJsonRaw(months, "cancelled", to_string(totals.cancelled));
+                appendJsonRaw(months, "nights", to_string(totals.nights));
+                appendJsonRaw(months, "revenue", to_string(totals.revenue));
+                months += '}';
+            }
+            months += ']';
+            appendJsonRaw(result, "byMonth", months);
+            string customers = "[";
+            for (const CustomerSpend& entry : hotel->getTopCustomers(static_cast<size_t>(max(0, top)))) {
+                customers += customers.size() > 1 ? ",{" : "{";
+                appendJsonField(customers, "username", hotel->getCustomer(entry.customer).getUsername());
+                appendJsonRaw(customers, "stays", to_string(entry.stays));
+                appendJsonRaw(customers, "spend", to_string(entry.spend));
+                customers += '}';
+            }
+            customers += ']';
+            appendJsonRaw(result, "topCustomers", customers);
+        }
+        else if (op == "report") {
+            requireAdmin();
+            TIME_OPERATION(Metric::OCCUPANCY_REPORT);
+            auto [totalRooms, bookedRooms] = hotel->getOccupancy();
+            char rate[32];
+            snprintf(rate, sizeof(rate), "%.2f", totalRooms ? 100.0 * bookedRooms / totalRooms : 0.0);
+            appendJsonRaw(result, "totalRooms", to_string(totalRooms));
+            appendJsonRaw(result, "bookedRooms", to_string(bookedRooms));
+            appendJsonRaw(result, "occupancyRate", rate);
+            const ReportCounters& counters = hotel->getReportCounters();
+            appendJsonRaw(result, "activeBookings", to_string(counters.getReservations()));
+            snprintf(rate, sizeof(rate), "%.2f", counters.getRevenue());
+            appendJsonRaw(result, "revenue", rate);
+            appendJsonRaw(result, "pointsIssued", to_string(counters.getPointsIssued()));
+            appendJsonRaw(result, "loyaltyBalance", to_string(counters.getLoyaltyBalance()));
+            string byType = "[";
+            for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+                RoomType type = static_cast<RoomType>(t);
+                byType += byType.size() > 1 ? ",{" : "{";
+                appendJsonField(byType, "type", roomTypeName(type));
+                appendJsonRaw(byType, "booked", to_string(counters.getBookedRooms(type)));
+                appendJsonRaw(byType, "free", to_string(counters.getFreeRooms(type)));
+                byType += '}';
+            }
+            byType += ']';
+            appendJsonRaw(result, "byType", byType);
+            string popular = "[";
+            for (const auto& [type, count] : hotel->getPopularRoomTypes()) {
+                popular += popular.size() > 1 ? ",{" : "{";
+                appendJsonField(popular, "type", type);
+                appendJsonRaw(popular, "bookings", to_string(count));
+                popular += '}';
+            }
+            popular += ']';
+            appendJsonRaw(result, "popularRoomTypes", popular);
+        }
+        else if (op == "properties") {
+            string list = "[";
+            for (size_t i = 0; i < requireChain().propertyCount(); ++i) {
+                if (i) list += ',';
+                appendJsonString(list, chain->getPropertyName(i));
+            }
+            list += ']';
+            appendJsonRaw(result, "properties", list);
+        }
+        else if (op == "addproperty") {
+            requireAdmin();
+            size_t index = requireChain().addProperty(requireString("name"));
+            appendJsonField(result, "name", chain->getPropertyName(index));
+        }
+        else if (op == "chainsearch") {
+            RoomType type = requireRoomType();
+            int checkIn = dateField("checkIn", home.getFirstBookableNight());
+            int nights = 1;
+            request.getInt("nights", nights);
+            int checkOut = dateField("checkOut", checkIn + nights);
+            int limit = 10;
+            request.getInt("limit", limit);
+            string list = "[";
+            for (const ChainRoomOffer& offer : requireChain().findFreeRooms(type, checkIn, checkOut, max(1, limit))) {
+                list += list.size() > 1 ? ",{" : "{";
+                appendJsonField(list, "property", chain->getPropertyName(offer.property));
+                appendJsonRaw(list, "room", to_string(offer.roomNumber));
+                appendJsonRaw(list, "freeOfType", to_string(offer.freeOfType));
+                list += '}';
+            }
+            list += ']';
+            appendJsonRaw(result, "offers", list);
+        }
+        else {
+            throw BookingException("Unknown op '" + string(op) + "'.");
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor for CommandProcessor.
+     * @param h Hotel the commands apply to.
+     * @param trustedCaller True to allow admin ops without the admin login.
+     * @param lock Mutex to hold around each command if other threads use the hotel->
+     */
+    explicit CommandProcessor(Hotel& h, bool trustedCaller = true, mutex* lock = nullptr)
+        : chain(nullptr), home(h), hotel(&h), trusted(trustedCaller), hotelLock(lock) {}
+
+    /**
+     * @brief Constructor for a CommandProcessor serving every property of a chain.
+     */
+    explicit CommandProcessor(HotelChain& c, bool trustedCaller = true, mutex* lock = nullptr)
+        : chain(&c), home(c.getCustomerHome()), hotel(&home), trusted(trustedCaller), hotelLock(lock) {}
+
+    /**
+     * @brief Execute one command line and append its result line to out.
+     * @return True if the command succeeded.
+     */
+    bool execute(string_view line, string& out) {
+        string details;
+        string result = "{";
+        bool ok = true;
+        try {
+            if (!request.parse(line)) {
+                throw BookingException("Malformed JSON line.");
+            }
+            if (request.has("id")) {
+                appendJsonField(result, "id", request.get("id"));
+            }
+            string_view op = request.get("op");
+            appendJsonField(result, "op", op);
+            if (hotelLock) {
+                lock_guard<mutex> guard(*hotelLock);
+                dispatch(op, details);
+            }
+            else {
+                dispatch(op, details);
+            }
+        }
+        catch (const BookingException& e) {
+            ok = false;
+            details.clear();
+            appendJsonField(details, "error", e.what());
+        }
+        appendJsonRaw(result, "ok", ok ? "true" : "false");
+        out += result;
+        if (!details.empty()) {
+            out += ',';
+            out += details;
+        }
+        out += "}\n";
+        return ok;
+    }
+
+    /**
+     * @brief Append an error result line for a command line that already ran,
+     * in the form execute() uses for a failed command.
+     */
+    void fail(string_view line, string_view message, string& out) {
+        string result = "{";
+        if (request.parse(line)) {
+            if (request.has("id")) {
+                appendJsonField(result, "id", request.get("id"));
+            }
+            appendJsonField(result, "op", request.get("op"));
+        }
+        appendJsonRaw(result, "ok", "false");
+        appendJsonField(result, "error", message);
+        out += result;
+        out += "}\n";
+    }
+};
+
+/**
+ * @brief Drain a JSON-lines command file through the prompt-free API.
+ *
+ * Results are written as JSON lines; throughput and latency percentiles go to
+ * stderr at the end. The journal is flushed once per batchSize commands, and
+ * the results of those commands are written only after the flush succeeds.
+ * @param hotel A Hotel, or a HotelChain whose commands may name a property.
+ * @return Process exit code.
+ */
+template <typename Target>
+int runBatch(Target& hotel, const string& inputPath, const string& outputPath, size_t batchSize) {
+    ifstream input(inputPath);
+    if (!input) {
+        cerr << "Error opening " << inputPath << " for reading.\n";
+        return 1;
+    }
+    FILE* output = outputPath.empty() ? stdout : fopen(outputPath.c_str(), "w");
+    if (!output) {
+        cerr << "Error opening " << outputPath << " for writing.\n";
+        return 1;
+    }
+
+    CommandProcessor processor(hotel);
+    vector<uint64_t> latencies;
+    string line, results;
+    size_t failed = 0, inBatch = 0;
+
+    auto start = chrono::steady_clock::now();
+    hotel.beginBatch();
+    while (getline(input, line)) {
+        if (line.empty()) continue;
+        auto opStart = chrono::steady_clock::now();
+        if (!processor.execute(line, results)) ++failed;
+        latencies.push_back(static_cast<uint64_t>(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - opStart).count()));
+
+        // A result is only written once the change it reports is durable
+        if (++inBatch == batchSize || results.size() > (1 << 20)) {
+            if (!hotel.commitBatch()) break;
+            fwrite(results.data(), 1, results.size(), output);
+            results.clear();
+            hotel.beginBatch();
+            inBatch = 0;
+        }
+    }
+    bool committed = hotel.commitBatch(); // Retries a failed flush once before giving up
+    if (committed) {
+        fwrite(results.data(), 1, results.size(), output);
+    }
+    fflush(output);
+    if (output != stdout) fclose(output);
+    if (!committed) {
+        cerr << "Error: the last " << inBatch << " operations could not be saved to the journal; "
+             << "their results were not written.\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    auto percentile = [&latencies](double p) -> double {
+        if (latencies.empty()) return 0.0;
+        size_t k = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1));
+        nth_element(latencies.begin(), latencies.begin() + static_cast<long>(k), latencies.end());
+        return static_cast<double>(latencies[k]) / 1000.0;
+    };
+    cerr << fixed << setprecision(2)
+         << "Processed " << latencies.size() << " operations (" << failed << " failed) in "
+         << seconds << " s: " << (seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0.0) << " ops/s, "
+         << "p50 " << percentile(0.50) << " us, p99 " << percentile(0.99) << " us\n";
+    return 0;
+}
+
+/**
+ * @class ClientSession
+ * @brief One server connection: its own login state over the shared hotel.
+ *
+ * A whole batch of pipelined commands runs and journals its records under the
+ * hotel lock. The lock is released before the session waits for those records
+ * to be synced, so the syncs of concurrent sessions are merged by the journal's
+ * group commit. No reply is sent for a change that is not durable: if the sync
+ * fails, every reply of the batch becomes an error.
+ */
+class ClientSession : public LineSession {
+    Hotel& hotel;
+    mutex& hotelLock;
+    CommandProcessor processor;
+
+public:
+    ClientSession(Hotel& h, mutex& lock) : hotel(h), hotelLock(lock), processor(h, false) {}
+
+    void process(const string& lines, string& out) override {
+        const size_t firstReply = out.size();
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(hotelLock);
+            forEachLine(lines, [this, &out](string_view line) { processor.execute(line, out); });
+            lsn = hotel.journalLsn();
+            hotel.checkpointIfDue();
+        }
+        if (!hotel.syncJournal(lsn)) {
+            out.resize(firstReply);
+            forEachLine(lines, [this, &out](string_view line) {
+                processor.fail(line, "The batch could not be saved to the journal; its changes "
+                               "may be lost if the system stops before the next checkpoint.", out);
+            });
+        }
+    }
+
+private:
+    // Call fn with each non-empty line, without its line ending
+    template <typename Fn>
+    static void forEachLine(const string& lines, Fn fn) {
+        size_t pos = 0;
+        while (pos < lines.size()) {
+            size_t end = lines.find('\n', pos);
+            string_view line(lines.data() + pos, end - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty()) fn(line);
+            pos = end + 1;
         }
     }
 };
 
-// Main function
-int main() {
+/**
+ * @brief Serve JSON-lines commands to network clients until SIGINT or SIGTERM.
+ * @param address "host:port", ":port" or "unix:/path/to/socket".
+ * @param workers Number of worker threads.
+ */
+int runServer(Hotel& hotel, const string& address, size_t workers) {
+    mutex hotelLock;
+    hotel.beginBatch(); // Sessions sync the journal themselves
+    int status;
+    {
+        LineServer server(address, [&hotel, &hotelLock] {
+            return make_unique<ClientSession>(hotel, hotelLock);
+        }, workers);
+        status = server.run() ? 0 : 1;
+    }
+    hotel.commitBatch();
+    return status;
+}
+
+/**
+ * @brief Read-only terminal for the hotel running in the current directory.
+ *
+ * Shows the rooms and reports from the view the hotel publishes in shared
+ * memory; it opens no data file and takes no lock, so any number of
+ * terminals can run beside the hotel.
+ * @return Process exit code.
+ */
+int runFrontDesk() {
+    const string name = availabilityViewName("");
+    AvailabilityView view;
+    if (!view.attach(name)) {
+        cerr << "No hotel is running in this directory.\n";
+        return 1;
+    }
+    AvailabilitySnapshot snapshot;
+    int choice;
+    do {
+        cout << "\n===== Front Desk (read-only) =====\n";
+        cout << "1. View Available Rooms\n";
+        cout << "2. Occupancy Report\n";
+        cout << "3. Popular Room Types Report\n";
+        cout << "4. Exit\n";
+        cout << "Enter your choice: ";
+        if (!(cin >> choice)) break;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear input buffer
+        if (choice < 1 || choice > 3) {
+            if (choice != 4) cout << "Invalid choice. Please try again.\n";
+            continue;
+        }
+        // A hotel restarted since the last read publishes a new view
+        if (!view.ownerRunning()) {
+            AvailabilityView restarted;
+            if (restarted.attach(name) && restarted.ownerRunning()) view.attach(name);
+        }
+        if (!view.read(snapshot)) {
+            cout << "The hotel stopped in the middle of an update; no rooms can be shown until it is restarted.\n";
+            continue;
+        }
+        if (!view.ownerRunning()) {
+            cout << "The hotel is not running; showing the rooms as it left them.\n";
+        }
+        switch (choice) {
+            case 1:
+                printAvailableRooms(snapshot);
+                break;
+            case 2:
+                printOccupancyReport(snapshot);
+                break;
+            case 3:
+                printPopularRoomTypes(popularRoomTypes(snapshot));
+                break;
+        }
+    } while (choice != 4);
+    return 0;
+}
+
+// Main function (left out when another program, such as the benchmark, includes this file)
+#ifndef HOTEL_NO_MAIN
+int main(int argc, char* argv[]) {
+    // A front-desk terminal only reads the hotel's shared view: no data files, and no metrics of its own
+    if (argc == 2 && string(argv[1]) == "--front-desk") {
+        return runFrontDesk();
+    }
+
+    // Declared before any Hotel so the final write includes its shutdown checkpoint
+    unique_ptr<MetricsExporter> metricsExporter;
+    if (METRICS_ENABLED) {
+        metricsExporter = make_unique<MetricsExporter>(METRICS_FILE, METRICS_INTERVAL);
+    }
+
+    if (argc > 1) {
+        // Non-interactive modes:
+        //   hotel_booking_system --batch <requests.jsonl> [--out <results.jsonl>] [--batch-size N] [--chain]
+        //   hotel_booking_system --serve <host:port | unix:path> [--workers N]
+        //   hotel_booking_system --import <customers.csv> [--rejects <rejects.csv>]
+        //   hotel_booking_system --close-day          (end-of-day loyalty job, e.g. from cron)
+        //   hotel_booking_system --front-desk         (read-only terminal beside a running hotel)
+        string inputPath, outputPath, serveAddress, importPath, rejectsPath;
+        bool closeDay = false, chain = false;
+        size_t batchSize = 4096;
+        size_t workers = max(1u, thread::hardware_concurrency());
+        bool usageError = false;
+        for (int i = 1; i < argc && !usageError; ++i) {
+            string arg = argv[i];
+            if (arg == "--batch" && i + 1 < argc) {
+                inputPath = argv[++i];
+            }
+            else if (arg == "--serve" && i + 1 < argc) {
+                serveAddress = argv[++i];
+            }
+            else if (arg == "--import" && i + 1 < argc) {
+                importPath = argv[++i];
+            }
+            else if (arg == "--close-day") {
+                closeDay = true;
+            }
+            else if (arg == "--rejects" && i + 1 < argc) {
+                rejectsPath = argv[++i];
+            }
+            else if (arg == "--workers" && i + 1 < argc) {
+                workers = static_cast<size_t>(max(1, atoi(argv[++i])));
+            }
+            else if (arg == "--out" && i + 1 < argc) {
+                outputPath = argv[++i];
+            }
+            else if (arg == "--batch-size" && i + 1 < argc) {
+                batchSize = static_cast<size_t>(max(1, atoi(argv[++i])));
+            }
+            else if (arg == "--chain") {
+                chain = true;
+            }
+            else {
+                usageError = true;
+            }
+        }
+        int modes = !inputPath.empty() + !serveAddress.empty() + !importPath.empty() + closeDay;
+        if (usageError || modes != 1 || (chain && inputPath.empty())) {
+            cerr << "Usage: " << argv[0] << " [--batch <requests.jsonl> [--out <results.jsonl>] [--batch-size N] [--chain]]\n"
+                 << "       " << argv[0] << " [--serve <host:port | unix:path> [--workers N]]\n"
+                 << "       " << argv[0] << " [--import <customers.csv> [--rejects <rejects.csv>]]\n"
+                 << "       " << argv[0] << " [--close-day]\n"
+                 << "       " << argv[0] << " [--front-desk]\n";
+            return 1;
+        }
+        if (chain) {
+            // Every property under properties/, with the hotel in this directory holding the customers
+            HotelChain hotelChain;
+            return runBatch(hotelChain, inputPath, outputPath, batchSize);
+        }
+        Hotel hotel;
+        if (!importPath.empty()) {
+            if (rejectsPath.empty()) rejectsPath = importPath + ".rejects";
+            auto start = chrono::steady_clock::now();
+            try {
+                ImportResult result = hotel.importCustomers(importPath, rejectsPath);
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                cerr << "Imported " << result.imported << " of " << result.rows << " customers in "
+                     << fixed << setprecision(2) << seconds << " s";
+                if (result.rejected > 0) cerr << "; " << result.rejected << " rejected rows in " << rejectsPath;
+                cerr << "\n";
+            }
+            catch (const BookingException& e) {
+                cerr << e.what() << "\n";
+                return 1;
+            }
+            return 0;
+        }
+        if (closeDay) {
+            try {
+                DayClose result = hotel.closeLoyaltyDay(todayDayNumber());
+                cerr << "Closed loyalty day " << formatDate(todayDayNumber()) << ": settled " << result.settled
+                     << " points, expired " << result.expiredPoints << " points from " << result.expiredAccounts
+                     << " inactive accounts\n";
+            }
+            catch (const BookingException& e) {
+                cerr << e.what() << "\n";
+                return 1;
+            }
+            return 0;
+        }
+        if (!serveAddress.empty()) {
+            return runServer(hotel, serveAddress, workers);
+        }
+        return runBatch(hotel, inputPath, outputPath, batchSize);
+    }
+
     Hotel hotel;
 
     int initialChoice;
@@ -910,7 +3992,7 @@ int main() {
                 getline(cin, adminPassword);
 
                 // Simple admin authentication (can be enhanced)
-                if (adminUsername == "admin" && adminPassword == "adminpass") {
+                if (adminUsername == ADMIN_USERNAME && adminPassword == ADMIN_PASSWORD) {
                     cout << "Admin login successful!\n";
                     hotel.adminMenu();
                 }
@@ -939,3 +4021,4 @@ int main() {
 
     return 0;
 }
+#endif // HOTEL_NO_MAIN
@@ -0,0 +1,76 @@
+/* ======================================
+   Mapped File
+   Read-only memory mapping of a whole file, shared by the snapshot reader
+   and the text loaders.
+   ====================================== */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>      // For using string class
+#include <string_view> // For the mapped contents
+#include <fcntl.h>     // For open
+#include <sys/mman.h>  // For mmap
+#include <sys/stat.h>  // For fstat
+#include <unistd.h>    // For close
+
+/**
+ * @class MappedFile
+ * @brief A file mapped into memory for reading; unmapped on destruction.
+ */
+class MappedFile {
+    const char* base = nullptr;
+    size_t length = 0;
+    bool isOpen = false;
+
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file.
+     * @param path File name.
+     * @param populate Fault in every page up front (for files that are read in full).
+     * @return False if the file does not exist or cannot be mapped.
+     */
+    bool open(const std::string& path, bool populate = true) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE | (populate ? MAP_POPULATE : 0), fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            base = static_cast<const char*>(mapped);
+            ::madvise(mapped, length, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+        isOpen = true;
+        return true;
+    }
+
+    void close() {
+        if (base) ::munmap(const_cast<char*>(base), length);
+        base = nullptr;
+        length = 0;
+        isOpen = false;
+    }
+
+    bool is_open() const { return isOpen; }
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(base, length); }
+};
+
+#endif // MAPPED_FILE_H
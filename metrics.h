@@ -0,0 +1,329 @@
+/* ======================================
+   Operation Metrics
+   Latency histograms and failure counters for every hotel operation.
+   Each thread records into its own block of log-linear (HDR-style)
+   histograms, so recording is a pair of timestamp reads and a few
+   uncontended stores. Blocks are merged only when metrics are read: for
+   the admin menu or for the Prometheus text file written in the
+   background. Building with -DHOTEL_NO_METRICS compiles every
+   TIME_OPERATION away.
+   ====================================== */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>             // For counters read by other threads
+#include <chrono>             // For timestamps
+#include <condition_variable> // For stopping the exporter promptly
+#include <cstdint>            // For fixed width integers
+#include <cstdio>             // For rename
+#include <exception>          // For uncaught_exceptions
+#include <fstream>            // For the Prometheus file
+#include <memory>             // For unique_ptr
+#include <mutex>              // For the thread registry
+#include <string>             // For using string class
+#include <thread>             // For the exporter thread
+#include <vector>             // For using vector container
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>        // For __rdtsc
+#endif
+
+/**
+ * @brief Timed operations. Names in METRIC_NAMES follow the same order.
+ */
+enum class Metric : uint8_t {
+    LOGIN, REGISTER, BOOK, BOOK_GROUP, CANCEL, CHECKOUT, SEARCH, QUOTE,
+    IMPORT_CUSTOMERS, JOURNAL_SYNC, CHECKPOINT,
+    SAVE_CUSTOMERS, SAVE_ROOMS, SAVE_BOOKINGS, SAVE_SNAPSHOT,
+    LOAD_CUSTOMERS, LOAD_ROOMS, LOAD_BOOKINGS, LOAD_SNAPSHOT,
+    OCCUPANCY_REPORT, POPULAR_TYPES_REPORT, CLOSE_LOYALTY_DAY, FORECAST,
+    STAYS_BY_MONTH, TOP_CUSTOMERS,
+    COUNT
+};
+constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+
+constexpr const char* METRIC_NAMES[METRIC_COUNT] = {
+    "login", "register", "book", "book_group", "cancel", "checkout", "search", "quote",
+    "import_customers", "journal_sync", "checkpoint",
+    "save_customers", "save_rooms", "save_bookings", "save_snapshot",
+    "load_customers", "load_rooms", "load_bookings", "load_snapshot",
+    "occupancy_report", "popular_types_report", "close_loyalty_day", "forecast",
+    "stays_by_month", "top_customers",
+};
+
+/**
+ * @brief Cheapest monotonic tick counter available (the TSC on x86).
+ */
+inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of tick counts: 8 sub-buckets per power of two (about 12% resolution).
+ *
+ * Written by one thread, read by any: relaxed loads and stores keep the
+ * reads race-free without a locked increment on the hot path.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    static size_t bucketOf(uint64_t ticks) {
+        if (ticks < SUB_BUCKETS) return static_cast<size_t>(ticks);
+        int exponent = 63 - __builtin_clzll(ticks);
+        size_t sub = static_cast<size_t>(ticks >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1);
+        return static_cast<size_t>(exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    // Largest tick count that falls into a bucket
+    static uint64_t bucketUpperBound(size_t bucket) {
+        if (bucket < SUB_BUCKETS) return bucket;
+        int exponent = static_cast<int>(bucket / SUB_BUCKETS) + SUB_BITS - 1;
+        uint64_t sub = bucket % SUB_BUCKETS;
+        uint64_t lower = (uint64_t(SUB_BUCKETS) + sub) << (exponent - SUB_BITS);
+        return lower + (uint64_t(1) << (exponent - SUB_BITS)) - 1;
+    }
+
+    void record(uint64_t ticks, bool failed) {
+        bump(counts[bucketOf(ticks)], 1);
+        bump(totalTicks, ticks);
+        if (failed) bump(failures, 1);
+    }
+
+    std::atomic<uint64_t> counts[BUCKETS] = {};
+    std::atomic<uint64_t> totalTicks{0};
+    std::atomic<uint64_t> failures{0};
+
+private:
+    static void bump(std::atomic<uint64_t>& cell, uint64_t by) {
+        cell.store(cell.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @struct MetricSummary
+ * @brief Merged view of one operation across all threads, in nanoseconds.
+ */
+struct MetricSummary {
+    const char* name = "";
+    uint64_t count = 0;
+    uint64_t failures = 0;
+    double totalNs = 0;
+    std::vector<uint64_t> buckets; // Merged histogram (tick buckets)
+    double nsPerTick = 1;
+
+    double meanNs() const { return count ? totalNs / count : 0; }
+
+    // Upper bound of the bucket holding the q-th quantile
+    double quantileNs(double q) const {
+        if (count == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(q * (count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < buckets.size(); ++b) {
+            seen += buckets[b];
+            if (seen >= rank) return LatencyHistogram::bucketUpperBound(b) * nsPerTick;
+        }
+        return 0;
+    }
+
+    // Number of samples of at most limitNs
+    uint64_t countAtMost(double limitNs) const {
+        uint64_t total = 0;
+        for (size_t b = 0; b < buckets.size(); ++b) {
+            if (LatencyHistogram::bucketUpperBound(b) * nsPerTick > limitNs) break;
+            total += buckets[b];
+        }
+        return total;
+    }
+};
+
+/**
+ * @class OperationMetrics
+ * @brief Process-wide registry of the per-thread histogram blocks.
+ */
+class OperationMetrics {
+    struct ThreadBlock {
+        LatencyHistogram histograms[METRIC_COUNT];
+    };
+
+    std::mutex mtx;
+    std::vector<std::unique_ptr<ThreadBlock>> blocks; // Kept after their thread exits, so totals never drop
+    const uint64_t startTicks = readTicks();
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    ThreadBlock& threadBlock() {
+        thread_local ThreadBlock* block = nullptr;
+        if (!block) {
+            std::lock_guard<std::mutex> lock(mtx);
+            blocks.push_back(std::make_unique<ThreadBlock>());
+            block = blocks.back().get();
+        }
+        return *block;
+    }
+
+public:
+    static OperationMetrics& instance() {
+        static OperationMetrics metrics;
+        return metrics;
+    }
+
+    void record(Metric metric, uint64_t ticks, bool failed) {
+        threadBlock().histograms[static_cast<size_t>(metric)].record(ticks, failed);
+    }
+
+    // Tick length, measured against the steady clock since start-up
+    double nsPerTick() const {
+#if defined(__x86_64__) || defined(__i386__)
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        uint64_t ticks = readTicks() - startTicks;
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return ticks > 0 && ns > 0 ? ns / ticks : 1;
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * @brief Merge every thread's histograms.
+     */
+    std::vector<MetricSummary> summarize() {
+        std::vector<MetricSummary> result(METRIC_COUNT);
+        const double tickNs = nsPerTick();
+        std::lock_guard<std::mutex> lock(mtx);
+        for (size_t m = 0; m < METRIC_COUNT; ++m) {
+            MetricSummary& summary = result[m];
+            summary.name = METRIC_NAMES[m];
+            summary.nsPerTick = tickNs;
+            summary.buckets.assign(LatencyHistogram::BUCKETS, 0);
+            uint64_t ticks = 0;
+            for (const auto& block : blocks) {
+                const LatencyHistogram& h = block->histograms[m];
+                for (size_t b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+                    uint64_t n = h.counts[b].load(std::memory_order_relaxed);
+                    summary.buckets[b] += n;
+                    summary.count += n;
+                }
+                ticks += h.totalTicks.load(std::memory_order_relaxed);
+                summary.failures += h.failures.load(std::memory_order_relaxed);
+            }
+            summary.totalNs = ticks * tickNs;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Write all operations in the Prometheus text exposition format.
+     */
+    void writePrometheus(std::ostream& out) {
+        static const double BOUNDS_SECONDS[] = {1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+                                                1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+        std::vector<MetricSummary> summaries = summarize();
+        out << "# HELP hotel_operation_duration_seconds Latency of hotel operations.\n"
+            << "# TYPE hotel_operation_duration_seconds histogram\n";
+        for (const MetricSummary& s : summaries) {
+            for (double bound : BOUNDS_SECONDS) {
+                out << "hotel_operation_duration_seconds_bucket{op=\"" << s.name << "\",le=\"" << bound << "\"} "
+                    << s.countAtMost(bound * 1e9) << "\n";
+            }
+            out << "hotel_operation_duration_seconds_bucket{op=\"" << s.name << "\",le=\"+Inf\"} " << s.count << "\n"
+                << "hotel_operation_duration_seconds_sum{op=\"" << s.name << "\"} " << s.totalNs / 1e9 << "\n"
+                << "hotel_operation_duration_seconds_count{op=\"" << s.name << "\"} " << s.count << "\n";
+        }
+        out << "# HELP hotel_operation_failures_total Operations that ended with an error.\n"
+            << "# TYPE hotel_operation_failures_total counter\n";
+        for (const MetricSummary& s : summaries) {
+            out << "hotel_operation_failures_total{op=\"" << s.name << "\"} " << s.failures << "\n";
+        }
+    }
+
+    /**
+     * @brief Replace path with the current metrics (written to a temporary file first).
+     */
+    bool writePrometheusFile(const std::string& path) {
+        const std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream file(tmpPath);
+            if (!file) return false;
+            writePrometheus(file);
+            if (!file) return false;
+        }
+        return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+    }
+};
+
+/**
+ * @class ScopedOperationTimer
+ * @brief Times the enclosing scope; an exception leaving the scope counts as a failure.
+ */
+class ScopedOperationTimer {
+    Metric metric;
+    int exceptionsAtStart;
+    uint64_t start;
+
+public:
+    explicit ScopedOperationTimer(Metric m)
+        : metric(m), exceptionsAtStart(std::uncaught_exceptions()), start(readTicks()) {}
+    ~ScopedOperationTimer() {
+        uint64_t ticks = readTicks() - start;
+        OperationMetrics::instance().record(metric, ticks, std::uncaught_exceptions() > exceptionsAtStart);
+    }
+    ScopedOperationTimer(const ScopedOperationTimer&) = delete;
+    ScopedOperationTimer& operator=(const ScopedOperationTimer&) = delete;
+};
+
+/**
+ * @class MetricsExporter
+ * @brief Background thread that rewrites a Prometheus text file at a fixed interval.
+ */
+class MetricsExporter {
+    std::string path;
+    std::chrono::seconds interval;
+    std::mutex mtx;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread worker;
+
+public:
+    MetricsExporter(std::string file, std::chrono::seconds every) : path(std::move(file)), interval(every) {
+        worker = std::thread([this] {
+            std::unique_lock<std::mutex> lock(mtx);
+            while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+                OperationMetrics::instance().writePrometheusFile(path);
+            }
+        });
+    }
+
+    // Stops the thread and writes the final values
+    ~MetricsExporter() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+        OperationMetrics::instance().writePrometheusFile(path);
+    }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+#ifndef HOTEL_NO_METRICS
+constexpr bool METRICS_ENABLED = true;
+#define METRICS_CONCAT_INNER(a, b) a##b
+#define METRICS_CONCAT(a, b) METRICS_CONCAT_INNER(a, b)
+// Time the rest of the enclosing scope as one operation
+#define TIME_OPERATION(metric) ScopedOperationTimer METRICS_CONCAT(operationTimer, __LINE__)(metric)
+#else
+constexpr bool METRICS_ENABLED = false;
+#define TIME_OPERATION(metric) ((void)0)
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,154 @@
+/* ======================================
+   Pricing Engine
+   Nightly rates per room type over the booking horizon, kept in one dense
+   (type x night) table. A rate is the type's base price scaled by how full
+   that type is on that night and by the day of the week. Bookings update
+   the occupancy of the nights they cover and re-rate only those nights, so
+   quoting a stay is a sum over a slice of the table plus the guest's
+   loyalty tier discount.
+   ====================================== */
+
+#ifndef PRICING_H
+#define PRICING_H
+
+#include <algorithm>        // For std::min and std::max
+#include <cstdint>          // For fixed width integers
+#include <vector>           // For using vector container
+#include "calendar.h"       // For the booking horizon and day numbers
+#include "loyalty_ledger.h" // For LoyaltyTier
+#include "room_inventory.h" // For RoomType and the base prices
+
+// Occupancy bands: a night at or above OCCUPANCY_BAND_FLOOR[b] percent full costs OCCUPANCY_BAND_PERCENT[b] percent
+constexpr size_t OCCUPANCY_BANDS = 4;
+constexpr int OCCUPANCY_BAND_FLOOR[OCCUPANCY_BANDS] = {0, 50, 80, 95};
+constexpr int OCCUPANCY_BAND_PERCENT[OCCUPANCY_BANDS] = {100, 110, 125, 150};
+
+// Day-of-week surcharge in percent, Sunday first (Friday and Saturday nights cost more)
+constexpr int WEEKDAY_PERCENT[7] = {100, 100, 100, 100, 100, 120, 120};
+
+// Discount in percent per loyalty tier, REGULAR first
+constexpr int TIER_DISCOUNT_PERCENT[] = {0, 5, 10, 15};
+
+/**
+ * @brief Day of the week of a day number, 0 for Sunday.
+ */
+constexpr int weekdayOf(int day) {
+    return ((day % 7) + 7 + 4) % 7; // 1970-01-01 was a Thursday
+}
+
+/**
+ * @brief Rate of one night of a type in whole rupees, given how many of its rooms are booked.
+ */
+inline int32_t nightlyRateFor(RoomType type, int32_t bookedRooms, int32_t totalRooms, int day) {
+    const int percentFull = totalRooms > 0 ? static_cast<int>(int64_t(bookedRooms) * 100 / totalRooms) : 0;
+    size_t band = 0;
+    while (band + 1 < OCCUPANCY_BANDS && percentFull >= OCCUPANCY_BAND_FLOOR[band + 1]) ++band;
+    const int64_t base = static_cast<int64_t>(roomPrice(type));
+    return static_cast<int32_t>(base * OCCUPANCY_BAND_PERCENT[band] / 100 * WEEKDAY_PERCENT[weekdayOf(day)] / 100);
+}
+
+/**
+ * @struct StayQuery
+ * @brief One stay to price with PricingEngine::quoteAll.
+ */
+struct StayQuery {
+    RoomType type;
+    LoyaltyTier tier;
+    int checkIn;
+    int checkOut;
+};
+
+/**
+ * @class PricingEngine
+ * @brief Precomputed nightly rates in whole rupees.
+ *
+ * Stays are priced for nights inside the horizon only, like the
+ * availability calendar; a quote outside it is 0.
+ */
+class PricingEngine {
+public:
+    static constexpr int HORIZON_NIGHTS = AvailabilityCalendar::HORIZON_NIGHTS;
+
+private:
+    int firstNight = 0;
+    int32_t roomsOfType[ROOM_TYPE_COUNT] = {};
+    std::vector<int32_t> booked; // type * HORIZON_NIGHTS + night -> rooms of the type booked that night
+    std::vector<int32_t> rates;  // type * HORIZON_NIGHTS + night -> rate in INR
+
+    size_t cell(RoomType type, int night) const {
+        return static_cast<size_t>(type) * HORIZON_NIGHTS + static_cast<size_t>(night);
+    }
+
+    void rate(RoomType type, int night) {
+        const size_t c = cell(type, night);
+        rates[c] = nightlyRateFor(type, booked[c], roomsOfType[static_cast<size_t>(type)], firstNight + night);
+    }
+
+    // Add delta to the occupancy of the horizon nights of a stay and re-rate them
+    void changeStay(RoomType type, int checkIn, int checkOut, int delta) {
+        int from = std::max(checkIn - firstNight, 0);
+        int to = std::min(checkOut - firstNight, HORIZON_NIGHTS);
+        for (int n = from; n < to; ++n) {
+            booked[cell(type, n)] += delta;
+            rate(type, n);
+        }
+    }
+
+public:
+    /**
+     * @brief Rate every night of the horizon for an inventory with nothing booked.
+     * @param first Day number of the first night in the horizon.
+     */
+    void reset(int first, const RoomInventory& inventory) {
+        firstNight = first;
+        for (auto& count : roomsOfType) count = 0;
+        for (RoomId id = 0; id < static_cast<RoomId>(inventory.size()); ++id) {
+            ++roomsOfType[static_cast<size_t>(inventory.getType(id))];
+        }
+        booked.assign(ROOM_TYPE_COUNT * HORIZON_NIGHTS, 0);
+        rates.assign(ROOM_TYPE_COUNT * HORIZON_NIGHTS, 0);
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            for (int n = 0; n < HORIZON_NIGHTS; ++n) {
+                rate(static_cast<RoomType>(t), n);
+            }
+        }
+    }
+
+    void addStay(RoomType type, int checkIn, int checkOut) { changeStay(type, checkIn, checkOut, 1); }
+    void removeStay(RoomType type, int checkIn, int checkOut) { changeStay(type, checkIn, checkOut, -1); }
+
+    /**
+     * @brief Current rate of one night, or 0 outside the horizon.
+     */
+    int32_t nightlyRate(RoomType type, int night) const {
+        int n = night - firstNight;
+        return n >= 0 && n < HORIZON_NIGHTS ? rates[cell(type, n)] : 0;
+    }
+
+    /**
+     * @brief Price of a stay after the tier discount.
+     */
+    int64_t quote(RoomType type, LoyaltyTier tier, int checkIn, int checkOut) const {
+        int from = std::max(checkIn - firstNight, 0);
+        int to = std::min(checkOut - firstNight, HORIZON_NIGHTS);
+        if (from >= to) return 0;
+        const int32_t* nights = &rates[cell(type, 0)];
+        int64_t total = 0;
+        for (int n = from; n < to; ++n) { // Contiguous slice: the compiler vectorizes the sum
+            total += nights[n];
+        }
+        return total * (100 - TIER_DISCOUNT_PERCENT[static_cast<size_t>(tier)]) / 100;
+    }
+
+    /**
+     * @brief Price many stays at once.
+     * @param totals Receives count prices, in the order of the stays.
+     */
+    void quoteAll(const StayQuery* stays, size_t count, int64_t* totals) const {
+        for (size_t i = 0; i < count; ++i) {
+            totals[i] = quote(stays[i].type, stays[i].tier, stays[i].checkIn, stays[i].checkOut);
+        }
+    }
+};
+
+#endif // PRICING_H
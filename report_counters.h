@@ -0,0 +1,127 @@
+/* ======================================
+   Report Counters
+   Running totals behind the occupancy and popularity reports. Hotel feeds
+   every reservation added or removed into them, so a report is a read of a
+   few counters instead of a scan of the booking tables.
+   ====================================== */
+
+#ifndef REPORT_COUNTERS_H
+#define REPORT_COUNTERS_H
+
+#include <cstdint>          // For fixed width integers
+#include <vector>           // For using vector container
+#include "room_inventory.h" // For RoomType and the room layout
+
+/**
+ * @class ReportCounters
+ * @brief Live booking statistics per room type and per floor.
+ *
+ * A room counts as booked while the inventory flags it booked: while a
+ * reservation covers tonight, or if rooms.txt or the snapshot flagged it
+ * booked without one, until it is checked out. Revenue
+ * is what every active reservation was charged when it was booked, and
+ * points issued are the loyalty points those reservations earned.
+ */
+class ReportCounters {
+    size_t totalRooms = 0;
+    size_t bookedRooms = 0;
+    size_t roomsOfType[ROOM_TYPE_COUNT] = {};
+    size_t bookedOfType[ROOM_TYPE_COUNT] = {};
+    size_t reservationsOfType[ROOM_TYPE_COUNT] = {};
+    std::vector<int> roomsOnFloor;  // floor -> rooms
+    std::vector<int> bookedOnFloor; // floor -> booked rooms
+    size_t reservations = 0;
+    double revenue = 0.0;
+    int64_t pointsIssued = 0;
+    int64_t loyaltyBalance = 0; // Points currently held by all customers
+
+public:
+    /**
+     * @brief Start over for an inventory with no reservations; rooms already flagged booked count as booked.
+     */
+    void reset(const RoomInventory& rooms) {
+        totalRooms = rooms.size();
+        bookedRooms = 0;
+        reservations = 0;
+        revenue = 0.0;
+        pointsIssued = 0;
+        for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+            roomsOfType[t] = bookedOfType[t] = reservationsOfType[t] = 0;
+        }
+        roomsOnFloor.assign(static_cast<size_t>(rooms.getTopFloor()) + 1, 0);
+        bookedOnFloor.assign(roomsOnFloor.size(), 0);
+        for (RoomId id = 0; id < static_cast<RoomId>(rooms.size()); ++id) {
+            ++roomsOfType[static_cast<size_t>(rooms.getType(id))];
+            ++roomsOnFloor[static_cast<size_t>(rooms.getFloor(id))];
+            if (rooms.isBooked(id)) {
+                ++bookedRooms;
+                ++bookedOfType[static_cast<size_t>(rooms.getType(id))];
+                ++bookedOnFloor[static_cast<size_t>(rooms.getFloor(id))];
+            }
+        }
+    }
+
+    /**
+     * @brief Record a new reservation.
+     * @param price INR the stay was charged.
+     */
+    void addReservation(RoomType type, int64_t price, int points) {
+        ++reservations;
+        ++reservationsOfType[static_cast<size_t>(type)];
+        revenue += price;
+        pointsIssued += points;
+    }
+
+    /**
+     * @brief Record a reservation that was canceled or checked out.
+     */
+    void removeReservation(RoomType type, int64_t price, int points) {
+        --reservations;
+        --reservationsOfType[static_cast<size_t>(type)];
+        revenue -= price;
+        pointsIssued -= points;
+    }
+
+    /**
+     * @brief Record that a room became occupied tonight.
+     */
+    void occupyRoom(RoomType type, int floor) {
+        ++bookedRooms;
+        ++bookedOfType[static_cast<size_t>(type)];
+        ++bookedOnFloor[static_cast<size_t>(floor)];
+    }
+
+    /**
+     * @brief Record that a room is no longer occupied tonight.
+     */
+    void releaseRoom(RoomType type, int floor) {
+        --bookedRooms;
+        --bookedOfType[static_cast<size_t>(type)];
+        --bookedOnFloor[static_cast<size_t>(floor)];
+    }
+
+    void setLoyaltyBalance(int64_t points) { loyaltyBalance = points; }
+    void changeLoyaltyBalance(int64_t delta) { loyaltyBalance += delta; }
+
+    size_t getTotalRooms() const { return totalRooms; }
+    size_t getBookedRooms() const { return bookedRooms; }
+    size_t getFreeRooms() const { return totalRooms - bookedRooms; }
+    size_t getReservations() const { return reservations; }
+    double getRevenue() const { return revenue; }
+    int64_t getPointsIssued() const { return pointsIssued; }
+    int64_t getLoyaltyBalance() const { return loyaltyBalance; }
+
+    size_t getRooms(RoomType type) const { return roomsOfType[static_cast<size_t>(type)]; }
+    size_t getBookedRooms(RoomType type) const { return bookedOfType[static_cast<size_t>(type)]; }
+    size_t getFreeRooms(RoomType type) const { return getRooms(type) - getBookedRooms(type); }
+    size_t getReservations(RoomType type) const { return reservationsOfType[static_cast<size_t>(type)]; }
+
+    /**
+     * @brief Highest floor the counters cover.
+     */
+    int getTopFloor() const { return static_cast<int>(roomsOnFloor.size()) - 1; }
+    int getRoomsOnFloor(int floor) const { return roomsOnFloor[static_cast<size_t>(floor)]; }
+    int getBookedOnFloor(int floor) const { return bookedOnFloor[static_cast<size_t>(floor)]; }
+};
+
+#endif // REPORT_COUNTERS_H
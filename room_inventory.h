@@ -0,0 +1,328 @@
+/* ======================================
+   Room Inventory
+   Dense, struct-of-arrays room table. Rooms are addressed by a RoomId that
+   indexes every column directly; room types are a small enum whose price
+   and display name come from compile-time tables. Free rooms are tracked
+   in bitsets that are updated whenever a room's booked state changes.
+   ====================================== */
+
+#ifndef ROOM_INVENTORY_H
+#define ROOM_INVENTORY_H
+
+#include <algorithm>   // For sort
+#include <cstdint>     // For fixed width integers
+#include <string_view> // For type name lookups
+#include <utility>     // For std::pair
+#include <vector>      // For using vector container
+
+/**
+ * @brief Room categories offered by the hotel.
+ */
+enum class RoomType : uint8_t { STANDARD, DELUXE, SUITE };
+
+constexpr size_t ROOM_TYPE_COUNT = 3;
+constexpr double ROOM_PRICES[ROOM_TYPE_COUNT] = {3000.0, 5000.0, 8000.0}; // Price in INR
+constexpr const char* ROOM_TYPE_NAMES[ROOM_TYPE_COUNT] = {"Standard", "Deluxe", "Suite"};
+
+constexpr double roomPrice(RoomType type) { return ROOM_PRICES[static_cast<size_t>(type)]; }
+constexpr const char* roomTypeName(RoomType type) { return ROOM_TYPE_NAMES[static_cast<size_t>(type)]; }
+
+/**
+ * @brief Look up a room type by its display name.
+ * @return False if the name is not a known type.
+ */
+inline bool parseRoomType(std::string_view name, RoomType& type) {
+    for (size_t t = 0; t < ROOM_TYPE_COUNT; ++t) {
+        if (name == ROOM_TYPE_NAMES[t]) {
+            type = static_cast<RoomType>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+using RoomId = int32_t;
+constexpr RoomId NO_ROOM = -1;
+
+/**
+ * @class RoomIdSet
+ * @brief Two-level bitset of room ids.
+ *
+ * A summary word marks which of 64 leaf words are non-empty, so insert and
+ * erase are O(1) and iteration skips empty stretches 4096 ids at a time.
+ */
+class RoomIdSet {
+    std::vector<uint64_t> words;   // id / 64 -> member bits
+    std::vector<uint64_t> summary; // word / 64 -> bit set if the word is non-empty
+    size_t count = 0;
+
+    // Bits [from, to] of a word, with 0 <= from <= to < 64
+    static uint64_t bitRange(size_t from, size_t to) {
+        uint64_t upper = to == 63 ? ~0ULL : ((1ULL << (to + 1)) - 1);
+        return upper & (~0ULL << from);
+    }
+
+public:
+    /**
+     * @brief Size the set for ids [0, capacity) and empty it.
+     */
+    void reset(size_t capacity) {
+        words.assign((capacity + 63) / 64, 0);
+        summary.assign((words.size() + 63) / 64, 0);
+        count = 0;
+    }
+
+    void insert(RoomId id) {
+        size_t w = static_cast<size_t>(id) / 64;
+        uint64_t bit = 1ULL << (id % 64);
+        if (words[w] & bit) return;
+        words[w] |= bit;
+        summary[w / 64] |= 1ULL << (w % 64);
+        ++count;
+    }
+
+    void erase(RoomId id) {
+        size_t w = static_cast<size_t>(id) / 64;
+        uint64_t bit = 1ULL << (id % 64);
+        if (!(words[w] & bit)) return;
+        words[w] &= ~bit;
+        if (!words[w]) summary[w / 64] &= ~(1ULL << (w % 64));
+        --count;
+    }
+
+    bool contains(RoomId id) const {
+        return (words[static_cast<size_t>(id) / 64] >> (id % 64)) & 1;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Smallest id in the set, or NO_ROOM if it is empty.
+     */
+    RoomId first() const {
+        for (size_t s = 0; s < summary.size(); ++s) {
+            if (summary[s]) {
+                size_t w = s * 64 + static_cast<size_t>(__builtin_ctzll(summary[s]));
+                return static_cast<RoomId>(w * 64 + static_cast<size_t>(__builtin_ctzll(words[w])));
+            }
+        }
+        return NO_ROOM;
+    }
+
+    /**
+     * @brief Visit the ids in [lo, hi) that are in the set, in ascending order.
+     */
+    template<typename Visit>
+    void forEachInRange(RoomId lo, RoomId hi, Visit visit) const {
+        if (lo >= hi) return;
+        const size_t first = static_cast<size_t>(lo), last = static_cast<size_t>(hi) - 1;
+        const size_t wLo = first / 64, wHi = last / 64;
+        for (size_t s = wLo / 64; s <= wHi / 64; ++s) {
+            uint64_t nonEmpty = summary[s] & bitRange(s == wLo / 64 ? wLo % 64 : 0,
+                                                      s == wHi / 64 ? wHi % 64 : 63);
+            while (nonEmpty) {
+                size_t w = s * 64 + static_cast<size_t>(__builtin_ctzll(nonEmpty));
+                nonEmpty &= nonEmpty - 1;
+                uint64_t bits = words[w] & bitRange(w == wLo ? first % 64 : 0, w == wHi ? last % 64 : 63);
+                while (bits) {
+                    visit(static_cast<RoomId>(w * 64 + static_cast<size_t>(__builtin_ctzll(bits))));
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every id in the set, in ascending order.
+     */
+    template<typename Visit>
+    void forEach(Visit visit) const {
+        forEachInRange(0, static_cast<RoomId>(words.size() * 64), visit);
+    }
+};
+
+/**
+ * @class RoomInventory
+ * @brief All rooms of the hotel stored column by column.
+ *
+ * Ids are assigned in room-number order, so the rooms of a floor occupy a
+ * contiguous id range and a full scan walks memory front to back. Room
+ * numbers follow the floor * 100 + slot convention; (floor, slot) -> id is a
+ * flat table indexed by the room number itself.
+ *
+ * Unbooked rooms are kept in one RoomIdSet overall and one per type, plus a
+ * free count per floor. setBooked() updates them in O(1), so listing or
+ * counting free rooms never scans the whole inventory.
+ */
+class RoomInventory {
+public:
+    static constexpr int FLOOR_STRIDE = 100; // Room number = floor * FLOOR_STRIDE + slot
+    static constexpr int MAX_FLOOR = 99999;
+    // The lookup table is sized by the largest number, so numbers are capped (at about 40 MB of table)
+    static constexpr int MAX_ROOM_NUMBER = (MAX_FLOOR + 1) * FLOOR_STRIDE - 1;
+
+    /**
+     * @brief True if a room number is positive and within MAX_ROOM_NUMBER.
+     */
+    static constexpr bool isValidNumber(int number) { return number > 0 && number <= MAX_ROOM_NUMBER; }
+
+private:
+    std::vector<int> numbers;          // id -> room number
+    std::vector<RoomType> types;       // id -> room type
+    std::vector<uint8_t> bookedFlags;  // id -> 1 if the room is occupied tonight
+    std::vector<RoomId> idByFloorSlot; // floor * FLOOR_STRIDE + slot -> id
+    std::vector<RoomId> floorFirst;    // floor -> first id on that floor (floor + 1 marks the end)
+    RoomIdSet freeRooms;                   // ids of unbooked rooms
+    RoomIdSet freeOfType[ROOM_TYPE_COUNT]; // type -> ids of unbooked rooms of that type
+    std::vector<int> freeOnFloor;          // floor -> number of unbooked rooms
+
+public:
+    /**
+     * @brief Replace the inventory with a new set of rooms, all unbooked.
+     * @param rooms (room number, type) pairs; numbers must be unique and pass isValidNumber().
+     */
+    void assign(std::vector<std::pair<int, RoomType>> rooms) {
+        std::sort(rooms.begin(), rooms.end(),
+                  [](const std::pair<int, RoomType>& a, const std::pair<int, RoomType>& b) { return a.first < b.first; });
+        numbers.clear();
+        types.clear();
+        for (const auto& [number, type] : rooms) {
+            numbers.push_back(number);
+            types.push_back(type);
+        }
+        bookedFlags.assign(numbers.size(), 0);
+
+        int maxNumber = numbers.empty() ? 0 : numbers.back();
+        idByFloorSlot.assign(static_cast<size_t>(maxNumber) + 1, NO_ROOM);
+        int floors = maxNumber / FLOOR_STRIDE + 1;
+        floorFirst.assign(static_cast<size_t>(floors) + 1, static_cast<RoomId>(numbers.size()));
+        for (size_t id = numbers.size(); id-- > 0;) {
+            idByFloorSlot[static_cast<size_t>(numbers[id])] = static_cast<RoomId>(id);
+            floorFirst[static_cast<size_t>(numbers[id] / FLOOR_STRIDE)] = static_cast<RoomId>(id);
+        }
+        // Floors without rooms start where the next floor starts
+        for (size_t f = floorFirst.size() - 1; f-- > 0;) {
+            floorFirst[f] = std::min(floorFirst[f], floorFirst[f + 1]);
+        }
+
+        // Every room starts out free
+        freeRooms.reset(numbers.size());
+        for (auto& set : freeOfType) {
+            set.reset(numbers.size());
+        }
+        freeOnFloor.assign(static_cast<size_t>(floors), 0);
+        for (size_t id = 0; id < numbers.size(); ++id) {
+            freeRooms.insert(static_cast<RoomId>(id));
+            freeOfType[static_cast<size_t>(types[id])].insert(static_cast<RoomId>(id));
+            ++freeOnFloor[static_cast<size_t>(numbers[id] / FLOOR_STRIDE)];
+        }
+    }
+
+    /**
+     * @brief Id of a room number, or NO_ROOM if there is no such room.
+     */
+    RoomId find(int roomNumber) const {
+        if (roomNumber < 0 || static_cast<size_t>(roomNumber) >= idByFloorSlot.size()) return NO_ROOM;
+        return idByFloorSlot[static_cast<size_t>(roomNumber)];
+    }
+
+    /**
+     * @brief Id of the room in a given slot of a floor, or NO_ROOM.
+     */
+    RoomId find(int floor, int slot) const {
+        if (slot < 0 || slot >= FLOOR_STRIDE) return NO_ROOM;
+        return find(floor * FLOOR_STRIDE + slot);
+    }
+
+    size_t size() const { return numbers.size(); }
+    bool empty() const { return numbers.empty(); }
+    size_t getBookedCount() const { return numbers.size() - freeRooms.size(); }
+
+    int getNumber(RoomId id) const { return numbers[static_cast<size_t>(id)]; }
+    RoomType getType(RoomId id) const { return types[static_cast<size_t>(id)]; }
+    int getFloor(RoomId id) const { return numbers[static_cast<size_t>(id)] / FLOOR_STRIDE; }
+    double getPrice(RoomId id) const { return roomPrice(types[static_cast<size_t>(id)]); }
+    bool isBooked(RoomId id) const { return bookedFlags[static_cast<size_t>(id)] != 0; }
+
+    void setBooked(RoomId id, bool status) {
+        uint8_t& flag = bookedFlags[static_cast<size_t>(id)];
+        if (flag == (status ? 1 : 0)) return;
+        flag = status ? 1 : 0;
+        RoomIdSet& ofType = freeOfType[static_cast<size_t>(getType(id))];
+        int& onFloor = freeOnFloor[static_cast<size_t>(getFloor(id))];
+        if (status) {
+            freeRooms.erase(id);
+            ofType.erase(id);
+            --onFloor;
+        }
+        else {
+            freeRooms.insert(id);
+            ofType.insert(id);
+            ++onFloor;
+        }
+    }
+
+    size_t getFreeCount() const { return freeRooms.size(); }
+    size_t getFreeCount(RoomType type) const { return freeOfType[static_cast<size_t>(type)].size(); }
+
+    /**
+     * @brief Number of unbooked rooms on a floor.
+     */
+    int getFreeCountOnFloor(int floor) const {
+        if (floor < 0 || static_cast<size_t>(floor) >= freeOnFloor.size()) return 0;
+        return freeOnFloor[static_cast<size_t>(floor)];
+    }
+
+    /**
+     * @brief Lowest-numbered unbooked room of a type, or NO_ROOM if all are booked.
+     */
+    RoomId firstFree(RoomType type) const { return freeOfType[static_cast<size_t>(type)].first(); }
+
+    /**
+     * @brief Visit every unbooked room in room-number order.
+     */
+    template<typename Visit>
+    void forEachFree(Visit visit) const { freeRooms.forEach(visit); }
+
+    /**
+     * @brief Visit every unbooked room of a type in room-number order.
+     */
+    template<typename Visit>
+    void forEachFree(RoomType type, Visit visit) const { freeOfType[static_cast<size_t>(type)].forEach(visit); }
+
+    /**
+     * @brief Visit every unbooked room on a floor in room-number order.
+     */
+    template<typename Visit>
+    void forEachFreeOnFloor(int floor, Visit visit) const {
+        auto [first, last] = floorRange(floor);
+        freeRooms.forEachInRange(first, last, visit);
+    }
+
+    /**
+     * @brief Visit every unbooked room of a type on a floor in room-number order.
+     */
+    template<typename Visit>
+    void forEachFreeOnFloor(int floor, RoomType type, Visit visit) const {
+        auto [first, last] = floorRange(floor);
+        freeOfType[static_cast<size_t>(type)].forEachInRange(first, last, visit);
+    }
+
+    /**
+     * @brief Highest floor number that has rooms (0 if the inventory is empty).
+     */
+    int getTopFloor() const { return numbers.empty() ? 0 : numbers.back() / FLOOR_STRIDE; }
+
+    /**
+     * @brief Ids [first, last) of the rooms on a floor.
+     */
+    std::pair<RoomId, RoomId> floorRange(int floor) const {
+        if (floor < 0 || static_cast<size_t>(floor) + 1 >= floorFirst.size()) {
+            return {static_cast<RoomId>(numbers.size()), static_cast<RoomId>(numbers.size())};
+        }
+        return {floorFirst[static_cast<size_t>(floor)], floorFirst[static_cast<size_t>(floor) + 1]};
+    }
+};
+
+#endif // ROOM_INVENTORY_H
@@ -0,0 +1,282 @@
+/* ======================================
+   Binary Snapshot
+   Versioned, checksummed image of the hotel state written at every
+   checkpoint. Records are fixed width and every string lives in one shared
+   heap, so loading is a single mmap plus a checksum pass with no parsing.
+   ====================================== */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>       // For fixed width integers
+#include <cstdio>        // For FILE output
+#include <cstring>       // For memcpy, memcmp
+#include <iostream>      // For error messages
+#include <string>        // For using string class
+#include <string_view>   // For views into the string heap
+#include <unordered_map> // For de-duplicating heap strings
+#include <vector>        // For using vector container
+#include "journal.h"     // For crc32 and durableReplace
+#include "mapped_file.h" // For mapping the snapshot
+
+// File layout (native byte order, every section 8-byte aligned):
+//   SnapshotHeader | SnapshotCustomer[customerCount] | SnapshotRoom[roomCount]
+//   | SnapshotBooking[bookingCount] | string heap (heapSize bytes)
+// The checksum covers everything after the header.
+
+constexpr char SNAPSHOT_MAGIC[8] = {'H', 'B', 'S', 'N', 'A', 'P', '\r', '\n'};
+constexpr uint32_t SNAPSHOT_VERSION = 3; // 2: loyalty day fields, 3: booking prices; older files read them as 0
+constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304; // Reads back differently on a foreign-endian machine
+
+/**
+ * @brief Location of a string in the snapshot heap.
+ */
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t customerCount;
+    uint64_t roomCount;
+    uint64_t bookingCount;
+    uint64_t heapSize;
+    uint32_t checksum;
+    int32_t lastClosedDay; // Last loyalty day closed, 0 if none
+};
+
+struct SnapshotCustomer {
+    SnapshotString username, name, email, phone, adhaar, password;
+    int32_t loyaltyPoints;
+    int32_t lastEarnDay; // Day points were last earned, 0 if unknown
+};
+
+struct SnapshotRoom {
+    int32_t number;
+    uint8_t type;   // RoomType
+    uint8_t booked;
+    uint16_t reserved;
+};
+
+struct SnapshotBooking {
+    int32_t roomNumber;
+    int32_t checkIn;
+    int32_t checkOut;
+    uint32_t price; // INR charged for the stay
+    SnapshotString username;
+};
+
+static_assert(sizeof(SnapshotHeader) == 56 && sizeof(SnapshotCustomer) == 56 &&
+              sizeof(SnapshotRoom) == 8 && sizeof(SnapshotBooking) == 24,
+              "snapshot records must keep their on-disk size");
+
+/**
+ * @class SnapshotWriter
+ * @brief Collects records and writes them as one snapshot file.
+ *
+ * Booking usernames are interned, so a guest with many bookings has their
+ * name stored once for all of them.
+ */
+class SnapshotWriter {
+    std::vector<SnapshotCustomer> customers;
+    std::vector<SnapshotRoom> rooms;
+    std::vector<SnapshotBooking> bookings;
+    std::string heap;
+    std::unordered_map<std::string, SnapshotString> interned;
+    int32_t lastClosedDay = 0;
+
+    static bool writeBlock(FILE* file, const void* data, size_t size, uint32_t& crc) {
+        crc = crc32(static_cast<const char*>(data), size, crc);
+        return std::fwrite(data, 1, size, file) == size;
+    }
+
+public:
+    /**
+     * @brief Append a string to the heap and return its location.
+     */
+    SnapshotString addString(std::string_view text) {
+        SnapshotString ref{static_cast<uint32_t>(heap.size()), static_cast<uint32_t>(text.size())};
+        heap += text;
+        return ref;
+    }
+
+    /**
+     * @brief Store a string in the heap only once and return its location.
+     */
+    SnapshotString internString(const std::string& text) {
+        auto it = interned.find(text);
+        if (it != interned.end()) return it->second;
+        SnapshotString ref = addString(text);
+        interned.emplace(text, ref);
+        return ref;
+    }
+
+    void reserve(size_t customerCount, size_t roomCount, size_t bookingCount) {
+        customers.reserve(customerCount);
+        rooms.reserve(roomCount);
+        bookings.reserve(bookingCount);
+    }
+
+    void addCustomer(std::string_view username, std::string_view name, std::string_view email,
+                     std::string_view phone, std::string_view adhaar, std::string_view password, int points,
+                     int lastEarnDay) {
+        customers.push_back({addString(username), addString(name), addString(email), addString(phone),
+                             addString(adhaar), addString(password), points, lastEarnDay});
+    }
+
+    void setLastClosedDay(int day) { lastClosedDay = day; }
+
+    void addRoom(int number, uint8_t type, bool booked) {
+        rooms.push_back({number, type, static_cast<uint8_t>(booked ? 1 : 0), 0});
+    }
+
+    void addBooking(int roomNumber, const std::string& username, int checkIn, int checkOut, uint32_t price) {
+        bookings.push_back({roomNumber, checkIn, checkOut, price, internString(username)});
+    }
+
+    /**
+     * @brief Write the snapshot to a temporary file and durably move it into place.
+     * @return True if path now holds the new snapshot.
+     */
+    bool write(const std::string& path) {
+        if (heap.size() > UINT32_MAX) {
+            std::cout << "Error: snapshot string heap exceeds 4 GiB.\n";
+            return false;
+        }
+        const std::string tmpPath = path + ".tmp";
+        FILE* file = std::fopen(tmpPath.c_str(), "wb");
+        if (!file) {
+            std::cout << "Error opening " << tmpPath << " for writing.\n";
+            return false;
+        }
+        std::vector<char> buffer(1 << 20);
+        std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+        SnapshotHeader header{};
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.byteOrder = SNAPSHOT_BYTE_ORDER;
+        header.customerCount = customers.size();
+        header.roomCount = rooms.size();
+        header.bookingCount = bookings.size();
+        header.heapSize = heap.size();
+        header.lastClosedDay = lastClosedDay;
+
+        uint32_t crc = 0, ignored = 0;
+        bool ok = writeBlock(file, &header, sizeof(header), ignored) &&
+                  writeBlock(file, customers.data(), customers.size() * sizeof(SnapshotCustomer), crc) &&
+                  writeBlock(file, rooms.data(), rooms.size() * sizeof(SnapshotRoom), crc) &&
+                  writeBlock(file, bookings.data(), bookings.size() * sizeof(SnapshotBooking), crc) &&
+                  writeBlock(file, heap.data(), heap.size(), crc);
+        // Now that the body is known, fill in its checksum
+        header.checksum = crc;
+        ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && writeBlock(file, &header, sizeof(header), ignored);
+        ok = std::fclose(file) == 0 && ok;
+        if (!ok) {
+            std::cout << "Error writing to " << tmpPath << ".\n";
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+        return durableReplace(tmpPath, path);
+    }
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Read-only mapping of a snapshot file, validated on open.
+ *
+ * Records and strings are used in place from the mapping; nothing is
+ * copied until the caller builds its own structures from them.
+ */
+class SnapshotReader {
+    MappedFile file;
+    const char* base = nullptr;
+    size_t size = 0;
+    const SnapshotHeader* header = nullptr;
+
+    template<typename Record>
+    const Record* section(size_t offset) const { return reinterpret_cast<const Record*>(base + offset); }
+
+    size_t customersOffset() const { return sizeof(SnapshotHeader); }
+    size_t roomsOffset() const { return customersOffset() + header->customerCount * sizeof(SnapshotCustomer); }
+    size_t bookingsOffset() const { return roomsOffset() + header->roomCount * sizeof(SnapshotRoom); }
+    size_t heapOffset() const { return bookingsOffset() + header->bookingCount * sizeof(SnapshotBooking); }
+
+    bool reject(const std::string& path, const char* why) {
+        std::cout << "Warning: ignoring snapshot " << path << ": " << why << ".\n";
+        close();
+        return false;
+    }
+
+public:
+    SnapshotReader() = default;
+    ~SnapshotReader() { close(); }
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /**
+     * @brief Map a snapshot and check its header, bounds and checksum.
+     * @return False (after printing why, unless the file is missing) if it cannot be used.
+     */
+    bool open(const std::string& path) {
+        close();
+        if (!file.open(path)) return false;
+        if (file.size() < sizeof(SnapshotHeader)) return reject(path, "file too short");
+        base = file.data();
+        size = file.size();
+        header = section<SnapshotHeader>(0);
+
+        if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return reject(path, "not a snapshot");
+        if (header->byteOrder != SNAPSHOT_BYTE_ORDER) return reject(path, "written on a machine with another byte order");
+        if (header->version < 1 || header->version > SNAPSHOT_VERSION) return reject(path, "unsupported version");
+        // Counts come from disk: bound them before multiplying
+        if (header->customerCount > size / sizeof(SnapshotCustomer) || header->roomCount > size / sizeof(SnapshotRoom) ||
+            header->bookingCount > size / sizeof(SnapshotBooking) || header->heapSize > size ||
+            heapOffset() + header->heapSize != size) {
+            return reject(path, "size does not match header");
+        }
+        if (crc32(base + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader)) != header->checksum) {
+            return reject(path, "checksum mismatch");
+        }
+        // Every string must lie inside the heap
+        auto inHeap = [this](const SnapshotString& s) {
+            return static_cast<uint64_t>(s.offset) + s.length <= header->heapSize;
+        };
+        for (size_t i = 0; i < header->customerCount; ++i) {
+            const SnapshotCustomer& c = getCustomers()[i];
+            if (!inHeap(c.username) || !inHeap(c.name) || !inHeap(c.email) || !inHeap(c.phone) ||
+                !inHeap(c.adhaar) || !inHeap(c.password)) {
+                return reject(path, "string out of bounds");
+            }
+        }
+        for (size_t i = 0; i < header->bookingCount; ++i) {
+            if (!inHeap(getBookings()[i].username)) return reject(path, "string out of bounds");
+        }
+        return true;
+    }
+
+    void close() {
+        file.close();
+        base = nullptr;
+        header = nullptr;
+        size = 0;
+    }
+
+    size_t customerCount() const { return header->customerCount; }
+    size_t roomCount() const { return header->roomCount; }
+    size_t bookingCount() const { return header->bookingCount; }
+    int lastClosedDay() const { return header->version >= 2 ? header->lastClosedDay : 0; }
+
+    const SnapshotCustomer* getCustomers() const { return section<SnapshotCustomer>(customersOffset()); }
+    const SnapshotRoom* getRooms() const { return section<SnapshotRoom>(roomsOffset()); }
+    const SnapshotBooking* getBookings() const { return section<SnapshotBooking>(bookingsOffset()); }
+
+    std::string_view str(const SnapshotString& s) const {
+        return std::string_view(base + heapOffset() + s.offset, s.length);
+    }
+};
+
+#endif // SNAPSHOT_H
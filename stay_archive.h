@@ -0,0 +1,427 @@
+/* ======================================
+   Stay Archive
+   Every stay that ended, by checkout or by cancellation, kept as rows of
+   a column store under history/: one file per field, each a plain array
+   of fixed-width values in row order. Rows are appended at checkpoints,
+   and queries map the files and make one pass over only the columns they
+   read, so years of history are aggregated without parsing a line.
+   ====================================== */
+
+#ifndef STAY_ARCHIVE_H
+#define STAY_ARCHIVE_H
+
+#include <algorithm>        // For std::min, std::max and std::partial_sort
+#include <cerrno>           // For EEXIST
+#include <cstdint>          // For fixed width integers
+#include <iostream>         // For error messages
+#include <string>           // For using string class
+#include <utility>          // For std::pair
+#include <vector>           // For the pending rows and query results
+#include <fcntl.h>          // For open
+#include <sys/stat.h>       // For stat and mkdir
+#include <unistd.h>         // For write, ftruncate and close
+#include "calendar.h"       // For day numbers
+#include "journal.h"        // For syncFileData
+#include "mapped_file.h"    // For mapping the columns
+#include "room_inventory.h" // For RoomType
+#include "thread_pool.h"    // For WorkStealingPool
+
+// File layout: history/<column>.col holds the column's values for rows 0, 1, 2, ...
+// in native byte order with no header. A crash while appending can leave some
+// columns longer than others; the archive is cut back to the shortest on open.
+
+/**
+ * @brief How an archived stay ended.
+ */
+enum class StayOutcome : uint8_t { CHECKED_OUT, CANCELLED };
+
+/**
+ * @struct ArchivedStay
+ * @brief One row of the archive.
+ */
+struct ArchivedStay {
+    int32_t roomNumber;
+    RoomType type;
+    uint32_t customer; // CustomerId, or UINT32_MAX if the guest is not a registered customer
+    int32_t checkIn;   // Day number of the first night booked
+    int32_t checkOut;  // Day number of the booked departure
+    int32_t price;     // Amount the stay was charged, in whole rupees
+    int32_t points;    // Loyalty points the booking earned (and lost again if cancelled)
+    StayOutcome outcome;
+};
+
+/**
+ * @brief Months since January 1970 of a day number.
+ */
+inline int monthOfDay(int day) {
+    int y;
+    unsigned m, d;
+    civilFromDays(day, y, m, d);
+    return (y - 1970) * 12 + static_cast<int>(m) - 1;
+}
+
+/**
+ * @brief Day number of the first day of a month from monthOfDay().
+ */
+inline int firstDayOfMonth(int month) {
+    const int year = (month >= 0 ? month : month - 11) / 12;
+    return daysFromCivil(1970 + year, static_cast<unsigned>(month - year * 12 + 1), 1);
+}
+
+/**
+ * @brief Format a month from monthOfDay() as YYYY-MM.
+ */
+inline std::string formatMonth(int month) {
+    return formatDate(firstDayOfMonth(month)).substr(0, 7);
+}
+
+/**
+ * @struct StayMonthTotals
+ * @brief Archived stays of one room type that started in one month.
+ */
+struct StayMonthTotals {
+    int month;          // From monthOfDay()
+    RoomType type;
+    uint64_t stays;     // Stays checked out
+    uint64_t cancelled; // Stays cancelled
+    uint64_t nights;    // Nights booked by the stays checked out
+    int64_t revenue;    // Amount charged for the stays checked out
+};
+
+/**
+ * @struct CustomerSpend
+ * @brief What one customer spent on the stays they checked out of.
+ */
+struct CustomerSpend {
+    uint32_t customer;
+    uint64_t stays;
+    int64_t spend;
+};
+
+/**
+ * @class StayArchive
+ * @brief Append-only column store of ended stays.
+ *
+ * Rows are added in memory and appended to the column files by flush();
+ * queries cover the rows on file and those still pending. The files are
+ * mapped on the first query after a flush and stay mapped until the next.
+ */
+class StayArchive {
+public:
+    enum Column : size_t { ROOM, TYPE, CUSTOMER, CHECK_IN, CHECK_OUT, PRICE, POINTS, OUTCOME, COLUMN_COUNT };
+    static constexpr const char* COLUMN_FILES[COLUMN_COUNT] = {
+        "room.col", "type.col", "customer.col", "checkin.col", "checkout.col", "price.col", "points.col", "outcome.col",
+    };
+
+private:
+    static constexpr size_t COLUMN_WIDTH[COLUMN_COUNT] = {4, 1, 4, 4, 4, 4, 4, 1};
+
+    // One set of columns: the mapped files, or the rows not yet flushed
+    struct Columns {
+        const int32_t* room;
+        const uint8_t* type;
+        const uint32_t* customer;
+        const int32_t* checkIn;
+        const int32_t* checkOut;
+        const int32_t* price;
+        const int32_t* points;
+        const uint8_t* outcome;
+        size_t rows;
+    };
+
+    std::string directory; // Ends in '/'
+    size_t storedRows = 0; // Rows in every column file
+    mutable MappedFile files[COLUMN_COUNT];
+    mutable bool mapped = false;
+
+    std::vector<int32_t> room, checkIn, checkOut, price, points;
+    std::vector<uint8_t> type, outcome;
+    std::vector<uint32_t> customer;
+
+    std::string pathOf(size_t column) const { return directory + COLUMN_FILES[column]; }
+
+    const void* pendingData(size_t column) const {
+        const void* data[COLUMN_COUNT] = {room.data(), type.data(), customer.data(), checkIn.data(),
+                                          checkOut.data(), price.data(), points.data(), outcome.data()};
+        return data[column];
+    }
+
+    Columns pendingColumns() const {
+        return {room.data(), type.data(), customer.data(), checkIn.data(), checkOut.data(),
+                price.data(), points.data(), outcome.data(), room.size()};
+    }
+
+    Columns storedColumns() const {
+        if (!mapped) {
+            for (size_t c = 0; c < COLUMN_COUNT && storedRows > 0; ++c) {
+                // Only the columns a query reads are faulted in, as it reads them
+                if (!files[c].open(pathOf(c), false) || files[c].size() < storedRows * COLUMN_WIDTH[c]) {
+                    std::cout << "Error mapping " << pathOf(c) << ".\n";
+                    return {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0};
+                }
+            }
+            mapped = true;
+        }
+        auto at = [this](size_t c) { return files[c].data(); };
+        return {reinterpret_cast<const int32_t*>(at(ROOM)), reinterpret_cast<const uint8_t*>(at(TYPE)),
+                reinterpret_cast<const uint32_t*>(at(CUSTOMER)), reinterpret_cast<const int32_t*>(at(CHECK_IN)),
+                reinterpret_cast<const int32_t*>(at(CHECK_OUT)), reinterpret_cast<const int32_t*>(at(PRICE)),
+                reinterpret_cast<const int32_t*>(at(POINTS)), reinterpret_cast<const uint8_t*>(at(OUTCOME)),
+                storedRows};
+    }
+
+    void unmap() {
+        for (MappedFile& file : files) file.close();
+        mapped = false;
+    }
+
+    // Cut every column file back to rows rows
+    bool truncateTo(size_t rows) {
+        bool ok = true;
+        for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+            struct stat st;
+            if (stat(pathOf(c).c_str(), &st) != 0 || static_cast<size_t>(st.st_size) == rows * COLUMN_WIDTH[c]) continue;
+            if (::truncate(pathOf(c).c_str(), static_cast<off_t>(rows * COLUMN_WIDTH[c])) != 0) {
+                std::cout << "Error truncating " << pathOf(c) << ".\n";
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    bool appendColumn(size_t column) {
+        int fd = ::open(pathOf(column).c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) return false;
+        const char* p = static_cast<const char*>(pendingData(column));
+        size_t left = room.size() * COLUMN_WIDTH[column];
+        while (left > 0) {
+            ssize_t n = ::write(fd, p, left);
+            if (n < 0) {
+                ::close(fd);
+                return false;
+            }
+            p += n;
+            left -= static_cast<size_t>(n);
+        }
+        syncFileData(fd);
+        return ::close(fd) == 0;
+    }
+
+    // Most rows one query task sums; its row counts must fit in 32 bits (see Cell)
+    static constexpr size_t MAX_TASK_ROWS = size_t(1) << 31;
+
+    static Columns rowsOf(const Columns& c, size_t from, size_t to) {
+        return {c.room + from, c.type + from, c.customer + from, c.checkIn + from, c.checkOut + from,
+                c.price + from, c.points + from, c.outcome + from, to - from};
+    }
+
+    // The stored rows in about tasks equal slices, then the pending rows as one more
+    std::vector<Columns> split(size_t tasks) const {
+        std::vector<Columns> pieces;
+        const Columns stored = storedColumns();
+        const size_t slices = std::max(std::min(tasks, stored.rows), stored.rows / MAX_TASK_ROWS + 1);
+        for (size_t s = 0; s < slices && stored.rows > 0; ++s) {
+            pieces.push_back(rowsOf(stored, s * stored.rows / slices, (s + 1) * stored.rows / slices));
+        }
+        if (!room.empty()) pieces.push_back(pendingColumns());
+        return pieces;
+    }
+
+    // Sums of one (month, type) group: rows counts every row in the low half and the stays
+    // checked out in the high half, so each row updates three sums instead of four
+    struct Cell {
+        uint64_t rows;
+        int64_t nights, revenue;
+    };
+
+    static void sumByMonth(const Columns& c, const uint16_t* monthIndex, int firstDay, Cell* cells) {
+        const size_t lastType = ROOM_TYPE_COUNT - 1;
+        for (size_t i = 0; i < c.rows; ++i) {
+            const int64_t done = c.outcome[i] == static_cast<uint8_t>(StayOutcome::CHECKED_OUT);
+            const size_t t = std::min(static_cast<size_t>(c.type[i]), lastType);
+            Cell& cell = cells[monthIndex[c.checkIn[i] - firstDay] * ROOM_TYPE_COUNT + t];
+            cell.rows += 1 + (static_cast<uint64_t>(done) << 32);
+            cell.nights += done * (c.checkOut[i] - c.checkIn[i]);
+            cell.revenue += done * c.price[i];
+        }
+    }
+
+    struct Spend {
+        int64_t stays, spend;
+    };
+
+    // Add the rows of customers [first, first + count) to sums[0, count); the rows of
+    // other customers go to sums[count] without a branch that would mispredict
+    static void sumByCustomer(const Columns& c, uint32_t first, uint32_t count, Spend* sums) {
+        constexpr size_t PREFETCH_ROWS = 16; // Far enough ahead to hide a cache miss
+        for (size_t i = 0; i < c.rows; ++i) {
+            if (i + PREFETCH_ROWS < c.rows) {
+                __builtin_prefetch(sums + std::min(c.customer[i + PREFETCH_ROWS] - first, count), 1);
+            }
+            Spend& sum = sums[std::min(c.customer[i] - first, count)]; // Ids below first wrap around
+            const int64_t done = c.outcome[i] == static_cast<uint8_t>(StayOutcome::CHECKED_OUT);
+            sum.stays += done;
+            sum.spend += done * c.price[i];
+        }
+    }
+
+public:
+    /**
+     * @param dir Directory of the column files, ending in '/'; created on the first flush.
+     */
+    explicit StayArchive(const std::string& dir) : directory(dir) {
+        size_t rows = SIZE_MAX;
+        bool any = false;
+        for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+            struct stat st;
+            size_t columnRows = 0;
+            if (stat(pathOf(c).c_str(), &st) == 0) {
+                columnRows = static_cast<size_t>(st.st_size) / COLUMN_WIDTH[c];
+                any = true;
+            }
+            rows = std::min(rows, columnRows);
+        }
+        storedRows = any ? rows : 0;
+        if (any) truncateTo(storedRows);
+    }
+
+    StayArchive(const StayArchive&) = delete;
+    StayArchive& operator=(const StayArchive&) = delete;
+
+    size_t size() const { return storedRows + room.size(); }
+    size_t pendingRows() const { return room.size(); }
+
+    void add(const ArchivedStay& stay) {
+        room.push_back(stay.roomNumber);
+        type.push_back(static_cast<uint8_t>(stay.type));
+        customer.push_back(stay.customer);
+        checkIn.push_back(stay.checkIn);
+        checkOut.push_back(stay.checkOut);
+        price.push_back(stay.price);
+        points.push_back(stay.points);
+        outcome.push_back(static_cast<uint8_t>(stay.outcome));
+    }
+
+    /**
+     * @brief Append the pending rows to the column files and sync them.
+     * @return False if a file could not be written; the files are cut back and the rows stay pending.
+     */
+    bool flush() {
+        if (room.empty()) return true;
+        const std::string dir = directory.substr(0, directory.size() - 1);
+        if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+            std::cout << "Error creating " << dir << ".\n";
+            return false;
+        }
+        unmap();
+        for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+            if (!appendColumn(c)) {
+                std::cout << "Error writing to " << pathOf(c) << ".\n";
+                truncateTo(storedRows);
+                return false;
+            }
+        }
+        storedRows += room.size();
+        room.clear();
+        type.clear();
+        customer.clear();
+        checkIn.clear();
+        checkOut.clear();
+        price.clear();
+        points.clear();
+        outcome.clear();
+        return true;
+    }
+
+    /**
+     * @brief Totals per start month and room type, oldest month first; empty groups are left out.
+     *
+     * The rows are split into one slice per worker and the calling thread;
+     * each slice sums into its own groups, which are added up at the end.
+     */
+    std::vector<StayMonthTotals> totalsByMonth(WorkStealingPool& pool) const {
+        const std::vector<Columns> pieces = split(pool.size() + 1);
+        std::vector<std::pair<int, int>> ranges(pieces.size(), {INT32_MAX, INT32_MIN});
+        pool.run(pieces.size(), [&](size_t p) {
+            auto range = std::minmax_element(pieces[p].checkIn, pieces[p].checkIn + pieces[p].rows);
+            ranges[p] = {*range.first, *range.second};
+        });
+        int firstDay = INT32_MAX, lastDay = INT32_MIN;
+        for (const auto& range : ranges) {
+            firstDay = std::min(firstDay, range.first);
+            lastDay = std::max(lastDay, range.second);
+        }
+        std::vector<StayMonthTotals> result;
+        if (firstDay > lastDay) return result;
+
+        // Day -> month index from the first month, filled a month at a time
+        const int firstMonth = monthOfDay(firstDay);
+        std::vector<uint16_t> monthIndex(static_cast<size_t>(lastDay - firstDay) + 1);
+        int months = 0;
+        for (int day = firstDay; day <= lastDay; ++months) {
+            const int end = std::min(firstDayOfMonth(firstMonth + months + 1), lastDay + 1);
+            std::fill(monthIndex.begin() + (day - firstDay), monthIndex.begin() + (end - firstDay),
+                      static_cast<uint16_t>(months));
+            day = end;
+        }
+
+        const size_t groups = static_cast<size_t>(months) * ROOM_TYPE_COUNT;
+        std::vector<Cell> cells(pieces.size() * groups, Cell{0, 0, 0});
+        pool.run(pieces.size(), [&](size_t p) {
+            sumByMonth(pieces[p], monthIndex.data(), firstDay, &cells[p * groups]);
+        });
+        for (size_t g = 0; g < groups; ++g) {
+            uint64_t rows = 0, stays = 0;
+            int64_t nights = 0, revenue = 0;
+            for (size_t p = 0; p < pieces.size(); ++p) {
+                const Cell& cell = cells[p * groups + g];
+                rows += cell.rows & UINT32_MAX;
+                stays += cell.rows >> 32;
+                nights += cell.nights;
+                revenue += cell.revenue;
+            }
+            if (rows == 0) continue;
+            result.push_back({firstMonth + static_cast<int>(g / ROOM_TYPE_COUNT), static_cast<RoomType>(g % ROOM_TYPE_COUNT),
+                              stays, rows - stays, static_cast<uint64_t>(nights), revenue});
+        }
+        return result;
+    }
+
+    /**
+     * @brief The customers who spent most on stays they checked out of, biggest spender first.
+     *
+     * Every worker and the calling thread sum the rows of one range of
+     * customer ids, so each keeps a smaller share of the sums in cache.
+     * @param customers Number of customer ids; rows for other ids are left out.
+     */
+    std::vector<CustomerSpend> topCustomers(size_t count, uint32_t customers, WorkStealingPool& pool) const {
+        if (customers == 0) return {};
+        const std::vector<Columns> pieces = split(1);
+        std::vector<Spend> sums(customers);
+        const size_t ranges = std::min<size_t>(pool.size() + 1, customers);
+        pool.run(ranges, [&](size_t r) {
+            const uint32_t first = static_cast<uint32_t>(r * customers / ranges);
+            const uint32_t count = static_cast<uint32_t>((r + 1) * customers / ranges) - first;
+            std::vector<Spend> own(count + 1, Spend{0, 0});
+            for (const Columns& piece : pieces) {
+                sumByCustomer(piece, first, count, own.data());
+            }
+            std::copy(own.begin(), own.end() - 1, sums.begin() + first);
+        });
+        std::vector<CustomerSpend> result;
+        for (uint32_t id = 0; id < customers; ++id) {
+            if (sums[id].stays > 0) {
+                result.push_back({id, static_cast<uint64_t>(sums[id].stays), sums[id].spend});
+            }
+        }
+        auto bigger = [](const CustomerSpend& a, const CustomerSpend& b) {
+            return a.spend != b.spend ? a.spend > b.spend : a.customer < b.customer;
+        };
+        count = std::min(count, result.size());
+        std::partial_sort(result.begin(), result.begin() + static_cast<ptrdiff_t>(count), result.end(), bigger);
+        result.resize(count);
+        return result;
+    }
+};
+
+#endif // STAY_ARCHIVE_H
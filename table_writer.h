@@ -0,0 +1,153 @@
+/* ======================================
+   Table Writer
+   Fixed-width console tables for the listings. Rows are formatted into one
+   reusable buffer that is written out in large chunks, instead of going
+   through setw and endl per field, which flushes the console on every
+   line. Long listings are browsed through a PagedView, a snapshot of the
+   rows that is sorted only as far as the pages that are read.
+   ====================================== */
+
+#ifndef TABLE_WRITER_H
+#define TABLE_WRITER_H
+
+#include <algorithm>        // For sort
+#include <charconv>         // For to_chars
+#include <functional>       // For the sort order
+#include <initializer_list> // For column lists
+#include <ostream>          // For the output stream
+#include <string>           // For the row buffer
+#include <string_view>      // For cells
+#include <vector>           // For using vector container
+
+/**
+ * @class TableWriter
+ * @brief Left-aligned fixed-width columns, buffered and written in chunks.
+ *
+ * Cells are padded to their column width like setw(width) with left
+ * alignment; longer cells are not cut. Nothing reaches the stream until
+ * the buffer is full, flush() is called or the writer is destroyed, so
+ * call flush() before prompting for input.
+ */
+class TableWriter {
+    static constexpr size_t FLUSH_BYTES = 64 << 10;
+
+    std::ostream& out;
+    std::vector<size_t> widths;
+    std::string buffer;
+    size_t column = 0;
+
+public:
+    TableWriter(std::ostream& stream, std::initializer_list<size_t> columnWidths)
+        : out(stream), widths(columnWidths) {
+        buffer.reserve(FLUSH_BYTES + 1024);
+    }
+
+    ~TableWriter() { flush(); }
+
+    TableWriter(const TableWriter&) = delete;
+    TableWriter& operator=(const TableWriter&) = delete;
+
+    TableWriter& cell(std::string_view text) {
+        buffer.append(text);
+        size_t width = column < widths.size() ? widths[column] : 0;
+        if (text.size() < width) buffer.append(width - text.size(), ' ');
+        ++column;
+        return *this;
+    }
+
+    TableWriter& cell(long long value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return cell(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+    }
+
+    // End the current row
+    void endRow() {
+        buffer += '\n';
+        column = 0;
+        if (buffer.size() >= FLUSH_BYTES) flush();
+    }
+
+    template<typename... Cells>
+    void row(const Cells&... cells) {
+        (cell(cells), ...);
+        endRow();
+    }
+
+    // Write a line as it is, outside the columns
+    void line(std::string_view text) {
+        buffer.append(text);
+        buffer += '\n';
+        if (buffer.size() >= FLUSH_BYTES) flush();
+    }
+
+    void flush() {
+        if (buffer.empty()) return;
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+        buffer.clear();
+    }
+};
+
+/**
+ * @class PagedView
+ * @brief Snapshot of listing rows that is read one page at a time in a sort order.
+ *
+ * Rows are only put in order as far as the pages asked for so far: the
+ * first request places the rows of its page with a linear selection, and
+ * later requests grow the sorted prefix geometrically. Opening a listing
+ * of millions of rows therefore costs a single pass, and paging on from
+ * there costs about the page size. The items are typically pointers into
+ * the hotel, so a view must not outlive a change to the data it lists.
+ */
+template<typename Item>
+class PagedView {
+    std::vector<Item> items;
+    std::function<bool(const Item&, const Item&)> less; // Empty if the rows came in order
+    size_t pageSize;
+    size_t sortedEnd = 0; // items[0, sortedEnd) are final
+
+    // Put items[0, end) in their final order
+    void sortUpTo(size_t end) {
+        if (!less || end <= sortedEnd) return;
+        end = std::min(items.size(), std::max(end, 2 * sortedEnd));
+        auto first = items.begin() + static_cast<std::ptrdiff_t>(sortedEnd);
+        auto last = items.begin() + static_cast<std::ptrdiff_t>(end);
+        if (last != items.end()) std::nth_element(first, last - 1, items.end(), less);
+        std::sort(first, last, less);
+        sortedEnd = end;
+    }
+
+public:
+    /**
+     * @param rows Items in any order.
+     * @param order Sort order of the listing.
+     * @param rowsPerPage Items per page (at least 1).
+     */
+    template<typename Less>
+    PagedView(std::vector<Item> rows, Less order, size_t rowsPerPage)
+        : items(std::move(rows)), less(order), pageSize(std::max<size_t>(1, rowsPerPage)) {}
+
+    // Rows already in listing order
+    PagedView(std::vector<Item> rows, size_t rowsPerPage)
+        : items(std::move(rows)), pageSize(std::max<size_t>(1, rowsPerPage)) {}
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    size_t pageCount() const { return (items.size() + pageSize - 1) / pageSize; }
+
+    /**
+     * @brief Visit the items of a page (numbered from 0); pages past the end are empty.
+     */
+    template<typename Visit>
+    void forEachOnPage(size_t page, Visit visit) {
+        if (page >= pageCount()) return;
+        size_t end = std::min(items.size(), (page + 1) * pageSize);
+        sortUpTo(end);
+        for (size_t i = page * pageSize; i < end; ++i) {
+            visit(items[i]);
+        }
+    }
+};
+
+#endif // TABLE_WRITER_H
@@ -0,0 +1,214 @@
+/* ======================================
+   Thread Pool
+   Fixed set of worker threads draining a shared FIFO of tasks, and a
+   work-stealing pool for fanning one batch of tasks out and waiting on it.
+   ====================================== */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>             // For the count of queued tasks
+#include <condition_variable> // For waking idle workers
+#include <deque>              // For the task queue
+#include <functional>         // For std::function
+#include <memory>             // For std::unique_ptr
+#include <mutex>              // For guarding the queue
+#include <thread>             // For worker threads
+#include <vector>             // For using vector container
+
+/**
+ * @class ThreadPool
+ * @brief Runs submitted tasks on a fixed number of threads.
+ *
+ * Tasks run in submission order on whichever worker is free. The destructor
+ * finishes every queued task before joining the workers.
+ */
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mtx;
+    std::condition_variable ready;
+    bool stopping = false;
+
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    /**
+     * @brief Start the workers.
+     * @param threads Number of worker threads (at least one is started).
+     */
+    explicit ThreadPool(size_t threads) {
+        if (threads == 0) threads = 1;
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { run(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task for the next free worker.
+     */
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            tasks.push_back(std::move(task));
+        }
+        ready.notify_one();
+    }
+
+    size_t size() const { return workers.size(); }
+};
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs batches of independent tasks on per-worker queues.
+ *
+ * run() deals a batch round-robin onto the workers' queues. A worker takes
+ * tasks from the back of its own queue and, once that is empty, steals from
+ * the front of the others', so a slow task does not hold up the rest of its
+ * queue. The calling thread steals too until the queues are empty, then
+ * waits for the tasks still running.
+ */
+class WorkStealingPool {
+    struct Queue {
+        std::mutex mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues; // worker -> its queue
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0}; // Tasks in all queues
+    std::mutex sleepMtx;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // Take a task: from the back of queue self, else from the front of another queue
+    bool take(size_t self, std::function<void()>& task) {
+        const size_t n = queues.size();
+        for (size_t k = 0; k < n; ++k) {
+            Queue& queue = *queues[(self + k) % n];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            if (queue.tasks.empty()) continue;
+            if (k == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void work(size_t self) {
+        std::function<void()> task;
+        while (true) {
+            if (take(self, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping && queued.load(std::memory_order_relaxed) == 0) return;
+        }
+    }
+
+public:
+    /**
+     * @brief Start the workers.
+     * @param threads Number of worker threads (at least one is started).
+     */
+    explicit WorkStealingPool(size_t threads) {
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Run body(i) for every i in [0, count) and wait until all have finished.
+     *
+     * body must not throw. Several threads may run batches at once.
+     */
+    template<typename Body>
+    void run(size_t count, Body body) {
+        if (count == 0) return;
+        size_t remaining = count; // Guarded by doneMtx
+        std::mutex doneMtx;
+        std::condition_variable done;
+        const size_t n = queues.size();
+        for (size_t i = 0; i < count; ++i) {
+            queued.fetch_add(1, std::memory_order_relaxed); // Before the push, so take() never underflows it
+            Queue& queue = *queues[i % n];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            queue.tasks.push_back([&, i] {
+                body(i);
+                std::lock_guard<std::mutex> doneLock(doneMtx);
+                if (--remaining == 0) done.notify_all();
+            });
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMtx);
+        }
+        wake.notify_all();
+
+        std::function<void()> task;
+        while (take(0, task)) {
+            task();
+        }
+        // Tasks touch doneMtx until their last line, so always wait on it before returning
+        std::unique_lock<std::mutex> lock(doneMtx);
+        done.wait(lock, [&remaining] { return remaining == 0; });
+    }
+
+    size_t size() const { return workers.size(); }
+};
+
+#endif // THREAD_POOL_H
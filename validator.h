@@ -0,0 +1,186 @@
+/* ======================================
+   Validator
+   Input prompts and field validation for customer details. The checks are
+   built once at compile time: email addresses run through a small state
+   machine over a character-class table, and the fixed-width digit fields
+   are tested eight bytes at a time. Column variants validate a whole list
+   of inputs and return one bit per row.
+   ====================================== */
+
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+#include <array>       // For the lookup tables
+#include <cstdint>     // For fixed width integers
+#include <cstring>     // For memcpy
+#include <iostream>    // For prompts
+#include <limits>      // For numeric limits
+#include <string>      // For using string class
+#include <string_view> // For validating without copies
+#include <vector>      // For result bitmaps
+
+/**
+ * @brief One bit per validated row; bit i of word i / 64 is set if row i is valid.
+ */
+using ValidationBitmap = std::vector<uint64_t>;
+
+inline bool isValidRow(const ValidationBitmap& bitmap, size_t row) {
+    return (bitmap[row / 64] >> (row % 64)) & 1;
+}
+
+namespace validator_detail {
+
+// Character classes seen by the email state machine
+enum EmailClass : uint8_t { LETTER, DIGIT, DOT, HYPHEN, LOCAL_SYMBOL, AT, OTHER, CLASS_COUNT };
+
+// States. The address must match [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+// in full; since the top-level domain has no dots it always follows the last dot.
+enum EmailState : uint8_t {
+    START,       // Nothing read yet
+    LOCAL,       // Inside the part before '@'
+    DOMAIN_START, // Just read '@'
+    DOMAIN,      // Inside the domain, not in a possible top-level domain
+    TLD_0,       // Just read a dot that has domain characters before it
+    TLD_1,       // One letter after that dot
+    TLD_2,       // Two or more letters after that dot (accepting)
+    REJECT,
+    STATE_COUNT
+};
+
+constexpr std::array<uint8_t, 256> makeEmailClasses() {
+    std::array<uint8_t, 256> classes{};
+    for (int c = 0; c < 256; ++c) {
+        classes[c] = OTHER;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) classes[c] = LETTER;
+        else if (c >= '0' && c <= '9') classes[c] = DIGIT;
+        else if (c == '.') classes[c] = DOT;
+        else if (c == '-') classes[c] = HYPHEN;
+        else if (c == '_' || c == '%' || c == '+') classes[c] = LOCAL_SYMBOL;
+        else if (c == '@') classes[c] = AT;
+    }
+    return classes;
+}
+
+constexpr uint8_t EMAIL_TRANSITIONS[STATE_COUNT][CLASS_COUNT] = {
+    //             LETTER  DIGIT   DOT     HYPHEN  SYMBOL  AT            OTHER
+    /* START */  { LOCAL,  LOCAL,  LOCAL,  LOCAL,  LOCAL,  REJECT,       REJECT },
+    /* LOCAL */  { LOCAL,  LOCAL,  LOCAL,  LOCAL,  LOCAL,  DOMAIN_START, REJECT },
+    /* D_START */{ DOMAIN, DOMAIN, DOMAIN, DOMAIN, REJECT, REJECT,       REJECT },
+    /* DOMAIN */ { DOMAIN, DOMAIN, TLD_0,  DOMAIN, REJECT, REJECT,       REJECT },
+    /* TLD_0 */  { TLD_1,  DOMAIN, TLD_0,  DOMAIN, REJECT, REJECT,       REJECT },
+    /* TLD_1 */  { TLD_2,  DOMAIN, TLD_0,  DOMAIN, REJECT, REJECT,       REJECT },
+    /* TLD_2 */  { TLD_2,  DOMAIN, TLD_0,  DOMAIN, REJECT, REJECT,       REJECT },
+    /* REJECT */ { REJECT, REJECT, REJECT, REJECT, REJECT, REJECT,       REJECT },
+};
+
+constexpr std::array<uint8_t, 256> EMAIL_CLASSES = makeEmailClasses();
+
+constexpr uint64_t BYTES_0x30 = 0x3030303030303030ULL;
+constexpr uint64_t BYTES_0x06 = 0x0606060606060606ULL;
+constexpr uint64_t HIGH_NIBBLES = 0xF0F0F0F0F0F0F0F0ULL;
+
+// True if all eight bytes are ASCII digits: each must be 0x30-0x3F, and stay
+// there after adding 6 (which pushes 0x3A-0x3F into 0x4_). No byte can carry.
+inline bool eightDigits(const char* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return (word & HIGH_NIBBLES) == BYTES_0x30 && ((word + BYTES_0x06) & HIGH_NIBBLES) == BYTES_0x30;
+}
+
+} // namespace validator_detail
+
+/**
+ * @brief True if every character is an ASCII digit.
+ *
+ * Fields of eight or more characters are checked one 8-byte word at a
+ * time, the last word overlapping the one before it.
+ */
+inline bool allDigits(std::string_view text) {
+    const char* p = text.data();
+    size_t n = text.size();
+    if (n < 8) {
+        for (size_t i = 0; i < n; ++i) {
+            if (p[i] < '0' || p[i] > '9') return false;
+        }
+        return true;
+    }
+    for (size_t i = 0; i + 8 < n; i += 8) {
+        if (!validator_detail::eightDigits(p + i)) return false;
+    }
+    return validator_detail::eightDigits(p + n - 8);
+}
+
+// Validator Class
+class Validator {
+    template<typename Column, typename Check>
+    static ValidationBitmap validateColumn(const Column& column, Check check) {
+        ValidationBitmap bitmap((column.size() + 63) / 64, 0);
+        size_t row = 0;
+        for (const auto& value : column) {
+            bitmap[row / 64] |= static_cast<uint64_t>(check(std::string_view(value))) << (row % 64);
+            ++row;
+        }
+        return bitmap;
+    }
+
+public:
+    template<typename T>
+    static T getInput(const std::string& prompt) {
+        T input;
+        while (true) {
+            std::cout << prompt;
+            std::cin >> input;
+            if (std::cin.fail()) {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Invalid input. Please try again.\n";
+            }
+            else {
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                return input;
+            }
+        }
+    }
+
+    /**
+     * @brief Accepts the same addresses as [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+     */
+    static bool isValidEmail(std::string_view email) {
+        using namespace validator_detail;
+        uint8_t state = START;
+        for (unsigned char c : email) {
+            state = EMAIL_TRANSITIONS[state][EMAIL_CLASSES[c]];
+            if (state == REJECT) return false;
+        }
+        return state == TLD_2;
+    }
+
+    static bool isValidPhone(std::string_view phone) {
+        return phone.length() == 10 && allDigits(phone);
+    }
+
+    static bool isValidAdhaar(std::string_view adhaar) {
+        return adhaar.length() == 12 && allDigits(adhaar);
+    }
+
+    /**
+     * @brief Validate a column of inputs (any container of strings or string_views).
+     * @return Bitmap with the bit of every valid row set.
+     */
+    template<typename Column>
+    static ValidationBitmap validateEmails(const Column& column) {
+        return validateColumn(column, [](std::string_view v) { return isValidEmail(v); });
+    }
+
+    template<typename Column>
+    static ValidationBitmap validatePhones(const Column& column) {
+        return validateColumn(column, [](std::string_view v) { return isValidPhone(v); });
+    }
+
+    template<typename Column>
+    static ValidationBitmap validateAdhaars(const Column& column) {
+        return validateColumn(column, [](std::string_view v) { return isValidAdhaar(v); });
+    }
+};
+
+#endif // VALIDATOR_H
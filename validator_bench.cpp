@@ -0,0 +1,117 @@
+/* ======================================
+   Validator Benchmark
+   Times the compiled email, phone and Aadhaar validators against the
+   original per-call std::regex and ::isdigit versions on a generated mix
+   of valid and invalid inputs. Both paths must agree on every input;
+   any disagreement is reported and fails the run.
+   ====================================== */
+
+#include <iostream>      // For standard input and output
+#include <string>        // For using string class
+#include <vector>        // For using vector container
+#include <algorithm>     // For all_of
+#include <chrono>        // For timing
+#include <cctype>        // For isdigit
+#include <cstdio>        // For printf
+#include <cstdlib>       // For atoi
+#include <random>        // For generating inputs
+#include <regex>         // For the reference email check
+#include "validator.h"   // For the validators under test
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// The validators as they were before they were compiled
+namespace reference {
+
+bool isValidEmail(const string& email) {
+    const regex pattern("[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}");
+    return regex_match(email, pattern);
+}
+
+bool isValidPhone(const string& phone) {
+    return phone.length() == 10 && all_of(phone.begin(), phone.end(), ::isdigit);
+}
+
+bool isValidAdhaar(const string& adhaar) {
+    return adhaar.length() == 12 && all_of(adhaar.begin(), adhaar.end(), ::isdigit);
+}
+
+} // namespace reference
+
+// Random strings drawn mostly from characters that matter to the email grammar
+string randomEmail(mt19937& rng) {
+    static const string alphabet = "abcXYZ019._%+-@@..-";
+    static const char* const tlds[] = {"com", "in", "c", "co.uk", "x1", "org"};
+    uniform_int_distribution<int> coin(0, 3);
+    auto piece = [&](int maxLength) {
+        string s;
+        int length = uniform_int_distribution<int>(0, maxLength)(rng);
+        for (int i = 0; i < length; ++i) s += alphabet[rng() % alphabet.size()];
+        return s;
+    };
+    if (coin(rng) == 0) return piece(24); // Mostly garbage
+    string local = coin(rng) ? "user" + to_string(rng() % 100000) : piece(8);
+    string domain = coin(rng) ? "example" : piece(6);
+    return local + "@" + domain + "." + tlds[rng() % 6];
+}
+
+string randomDigits(mt19937& rng, size_t length) {
+    string s;
+    uniform_int_distribution<int> corrupt(0, 9);
+    size_t actual = corrupt(rng) == 0 ? length + (rng() % 3) - 1 : length;
+    for (size_t i = 0; i < actual; ++i) s += static_cast<char>('0' + rng() % 10);
+    if (!s.empty() && corrupt(rng) == 0) s[rng() % s.size()] = "a /:\x7f"[rng() % 5];
+    return s;
+}
+
+template<typename Check>
+double nanosPerCall(const vector<string>& inputs, Check check, size_t& accepted) {
+    auto start = Clock::now();
+    accepted = 0;
+    for (const auto& input : inputs) accepted += check(input) ? 1 : 0;
+    return chrono::duration<double, nano>(Clock::now() - start).count() / inputs.size();
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(max(1, atoi(argv[1]))) : 200000;
+    mt19937 rng(42);
+    vector<string> emails, phones, adhaars;
+    for (size_t i = 0; i < count; ++i) {
+        emails.push_back(randomEmail(rng));
+        phones.push_back(randomDigits(rng, 10));
+        adhaars.push_back(randomDigits(rng, 12));
+    }
+
+    int mismatches = 0;
+    auto compare = [&](const char* field, const vector<string>& inputs, auto slow, auto fast, auto column) {
+        size_t slowAccepted, fastAccepted;
+        double slowNs = nanosPerCall(inputs, slow, slowAccepted);
+        double fastNs = nanosPerCall(inputs, fast, fastAccepted);
+        auto start = Clock::now();
+        ValidationBitmap bitmap = column(inputs);
+        double columnNs = chrono::duration<double, nano>(Clock::now() - start).count() / inputs.size();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            bool expected = slow(inputs[i]);
+            if (expected != fast(inputs[i]) || expected != isValidRow(bitmap, i)) {
+                if (++mismatches <= 10) cerr << "Mismatch on " << field << " '" << inputs[i] << "'\n";
+            }
+        }
+        printf("{\"field\":\"%s\",\"inputs\":%zu,\"valid\":%zu,\"reference_ns\":%.1f,\"compiled_ns\":%.1f,"
+               "\"column_ns\":%.1f,\"speedup\":%.1f}\n",
+               field, inputs.size(), fastAccepted, slowNs, fastNs, columnNs, slowNs / fastNs);
+    };
+
+    compare("email", emails, reference::isValidEmail, [](const string& s) { return Validator::isValidEmail(s); },
+            [](const vector<string>& c) { return Validator::validateEmails(c); });
+    compare("phone", phones, reference::isValidPhone, [](const string& s) { return Validator::isValidPhone(s); },
+            [](const vector<string>& c) { return Validator::validatePhones(c); });
+    compare("adhaar", adhaars, reference::isValidAdhaar, [](const string& s) { return Validator::isValidAdhaar(s); },
+            [](const vector<string>& c) { return Validator::validateAdhaars(c); });
+
+    if (mismatches) {
+        cerr << mismatches << " inputs were judged differently by the two validators.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/* ======================================
+   Waitlist
+   Requests for a room type (optionally on one floor) and a stay that could
+   not be booked because everything was taken. Each (type, floor) has its
+   own ordered set, best loyalty tier first and then oldest request first,
+   so when a room is released the request to serve is found without
+   scanning the whole list.
+   ====================================== */
+
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <algorithm>        // For std::max
+#include <cstdint>          // For fixed width integers
+#include <set>              // For the ordered queues
+#include <string>           // For using string class
+#include <unordered_map>    // For the lookups by ticket and queue
+#include <utility>          // For std::pair
+#include "loyalty_ledger.h" // For LoyaltyTier
+#include "room_inventory.h" // For RoomType
+
+constexpr int ANY_FLOOR = -1;
+
+/**
+ * @struct WaitRequest
+ * @brief One guest waiting for a room of a type for the nights [checkIn, checkOut).
+ */
+struct WaitRequest {
+    uint64_t ticket;  // Increases with request time
+    std::string username;
+    RoomType type;
+    int floor;        // ANY_FLOOR if any floor will do
+    int checkIn;
+    int checkOut;
+    LoyaltyTier tier; // Tier when the request was made; it fixes the request's place in line
+};
+
+/**
+ * @class Waitlist
+ * @brief Waiting requests queued by (type, floor) in priority order.
+ *
+ * Adding and removing a request is O(log n). best() walks a queue in
+ * priority order and stops at the first request the released room can
+ * serve, which is normally the first one.
+ */
+class Waitlist {
+    using Key = std::pair<uint8_t, uint64_t>; // (tiers below PLATINUM, ticket): smallest is served first
+
+    std::unordered_map<uint64_t, WaitRequest> requests;    // ticket -> request
+    std::unordered_map<uint32_t, std::set<Key>> queues;    // queueId(type, floor) -> waiting tickets
+    uint64_t nextTicket = 1;
+
+    static uint32_t queueId(RoomType type, int floor) {
+        return (static_cast<uint32_t>(type) << 24) | static_cast<uint32_t>(floor + 1);
+    }
+
+    static Key keyOf(const WaitRequest& request) {
+        return {static_cast<uint8_t>(static_cast<int>(LoyaltyTier::PLATINUM) - static_cast<int>(request.tier)),
+                request.ticket};
+    }
+
+    // Better of two candidates (either may be null)
+    static const WaitRequest* better(const WaitRequest* a, const WaitRequest* b) {
+        if (!a) return b;
+        if (!b) return a;
+        return keyOf(*a) < keyOf(*b) ? a : b;
+    }
+
+    template<typename Fits>
+    const WaitRequest* bestIn(uint32_t queue, Fits& fits) const {
+        auto it = queues.find(queue);
+        if (it == queues.end()) return nullptr;
+        for (const Key& key : it->second) {
+            const WaitRequest& request = requests.at(key.second);
+            if (fits(request)) return &request;
+        }
+        return nullptr;
+    }
+
+public:
+    void clear() {
+        requests.clear();
+        queues.clear();
+        nextTicket = 1;
+    }
+
+    /**
+     * @brief Queue a request.
+     *
+     * A request with ticket 0 is given the next ticket; a request that
+     * already has one (reloaded or replayed) keeps it, and is ignored if
+     * that ticket is already waiting.
+     * @return The request's ticket.
+     */
+    uint64_t add(WaitRequest request) {
+        if (request.ticket == 0) {
+            request.ticket = nextTicket;
+        }
+        else if (requests.count(request.ticket)) {
+            return request.ticket;
+        }
+        nextTicket = std::max(nextTicket, request.ticket + 1);
+        queues[queueId(request.type, request.floor)].insert(keyOf(request));
+        uint64_t ticket = request.ticket;
+        requests.emplace(ticket, std::move(request));
+        return ticket;
+    }
+
+    /**
+     * @brief Drop a request.
+     * @return False if the ticket is not waiting.
+     */
+    bool remove(uint64_t ticket) {
+        auto it = requests.find(ticket);
+        if (it == requests.end()) return false;
+        auto queue = queues.find(queueId(it->second.type, it->second.floor));
+        queue->second.erase(keyOf(it->second));
+        if (queue->second.empty()) queues.erase(queue);
+        requests.erase(it);
+        return true;
+    }
+
+    const WaitRequest* find(uint64_t ticket) const {
+        auto it = requests.find(ticket);
+        return it == requests.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * @brief Highest-priority request for a released room that the room can serve.
+     *
+     * Looks at the requests for the room's floor and those for any floor.
+     * @param fits Called with candidates in priority order; true if the room is free for that stay.
+     * @return The request, or nullptr if none fits.
+     */
+    template<typename Fits>
+    const WaitRequest* best(RoomType type, int floor, Fits fits) const {
+        return better(bestIn(queueId(type, floor), fits), bestIn(queueId(type, ANY_FLOOR), fits));
+    }
+
+    size_t size() const { return requests.size(); }
+
+    /**
+     * @brief Visit every waiting request, in no particular order.
+     */
+    template<typename Visit>
+    void forEach(Visit visit) const {
+        for (const auto& entry : requests) {
+            visit(entry.second);
+        }
+    }
+};
+
+#endif // WAITLIST_H